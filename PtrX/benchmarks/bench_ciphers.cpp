@@ -0,0 +1,53 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <cstdio>
+#include <vector>
+
+static double megabytesPerSecond(std::size_t bytes, double milliseconds) {
+    return bytes / 1e3 / milliseconds;
+}
+
+// Cipher throughput from a single 4 KiB page to a 64 MiB buffer; each row repeats its message size until
+// 64 MiB have been processed.
+int main() {
+    const std::size_t total = 64u << 20;
+    const std::size_t sizes[] = { 4096, 1u << 20, total };
+    std::vector<unsigned char> data(total, 1);
+    unsigned char key[32] = { 1, 2, 3 };
+    unsigned char nonce[12] = { 4 };
+    unsigned char counterBlock[16] = { 5 };
+    unsigned char tag[16];
+    AesKey aes128(key, 16);
+    AesKey aes256(key, 32);
+
+    for (int s = 0; s < 3; ++s) {
+        std::size_t size = sizes[s];
+        double chacha = bestOf(3, noSetup, [&]() {
+            for (std::size_t offset = 0; offset < total; offset += size) {
+                ChaCha20::xorKeystream(key, nonce, 0, data.data() + offset, size);
+            }
+        });
+        double ctr128 = bestOf(3, noSetup, [&]() {
+            for (std::size_t offset = 0; offset < total; offset += size) {
+                aes128.ctrXor(counterBlock, 0, data.data() + offset, size);
+            }
+        });
+        double ctr256 = bestOf(3, noSetup, [&]() {
+            for (std::size_t offset = 0; offset < total; offset += size) {
+                aes256.ctrXor(counterBlock, 0, data.data() + offset, size);
+            }
+        });
+        double gcm256 = bestOf(3, noSetup, [&]() {
+            for (std::size_t offset = 0; offset < total; offset += size) {
+                aes256.gcmEncrypt(nonce, nullptr, 0, data.data() + offset, size, tag);
+            }
+        });
+        std::printf("message %8zu bytes: ChaCha20 %6.0f  AES-128-CTR %6.0f  AES-256-CTR %6.0f  AES-256-GCM %6.0f MB/s\n", size,
+            megabytesPerSecond(total, chacha), megabytesPerSecond(total, ctr128), megabytesPerSecond(total, ctr256),
+            megabytesPerSecond(total, gcm256));
+    }
+    std::printf("avx2 %d, avx512 %d, aes-ni %d, pclmul %d\n", CpuFeatures::hasAvx2() ? 1 : 0, CpuFeatures::hasAvx512() ? 1 : 0,
+        CpuFeatures::hasAesNi() ? 1 : 0, CpuFeatures::hasPclmul() ? 1 : 0);
+    return 0;
+}
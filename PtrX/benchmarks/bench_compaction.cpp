@@ -0,0 +1,46 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+static bool isSeven(int value) {
+    return value == 7;
+}
+
+// Stream compaction against std::remove, std::remove_if and std::unique at several match ratios. The SIMD
+// kernels are branch-free, so their times should stay flat while the standard versions peak near 50%.
+int main() {
+    const int size = 4000000;
+    MemoryManager<int> manager(false);
+    std::mt19937 random(1);
+    const int percents[] = { 0, 10, 50, 90, 100 };
+
+    for (int p = 0; p < 5; ++p) {
+        std::vector<int> source(size), sorted(size);
+        int run = 0;
+        for (int i = 0; i < size; ++i) {
+            source[i] = static_cast<int>(random() % 100) < percents[p] ? 7 : 8 + static_cast<int>(random() % 1000);
+            run += static_cast<int>(random() % 100) >= percents[p];
+            sorted[i] = run;
+        }
+        std::vector<int> data;
+        std::function<void()> resetSource = [&]() { data = source; };
+        std::function<void()> resetSorted = [&]() { data = sorted; };
+        int newSize = 0;
+
+        double remove = bestOf(10, resetSource, [&]() { std::remove(data.begin(), data.end(), 7); });
+        double removeValue = bestOf(10, resetSource, [&]() { newSize = size; manager.removeValue(data.data(), newSize, 7); });
+        double removeIf = bestOf(10, resetSource, [&]() { std::remove_if(data.begin(), data.end(), isSeven); });
+        double removeIfMemory = bestOf(10, resetSource, [&]() { newSize = size; manager.removeIf(data.data(), newSize, isSeven); });
+        double unique = bestOf(10, resetSorted, [&]() { std::unique(data.begin(), data.end()); });
+        double uniqueMemory = bestOf(10, resetSorted, [&]() { newSize = size; manager.uniqueMemory(data.data(), newSize); });
+        std::printf("match %3d%%: std::remove %5.2f -> removeValue %5.2f  std::remove_if %5.2f -> removeIf %5.2f  "
+            "std::unique %5.2f -> uniqueMemory %5.2f ms\n",
+            percents[p], remove, removeValue, removeIf, removeIfMemory, unique, uniqueMemory);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+// Builds a sorted, duplicate-free set of about count values spread over span, so count / span sets the density.
+static std::vector<int> makeSet(std::mt19937& random, int count, int span) {
+    std::vector<int> values(count);
+    for (int i = 0; i < count; ++i) {
+        values[i] = static_cast<int>(random() % static_cast<unsigned int>(span));
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+// Builds one sparse run-free set, then one set of long consecutive runs.
+static std::vector<int> makeRuns(std::mt19937& random, int runs, int runLength) {
+    std::set<int> values;
+    for (int run = 0; run < runs; ++run) {
+        int start = static_cast<int>(random() % 100000000);
+        for (int i = 0; i < runLength; ++i) {
+            values.insert(start + i);
+        }
+    }
+    return std::vector<int>(values.begin(), values.end());
+}
+
+// CompressedBitmap against the sorted-array functions on the same sets: memory footprint and the time of a
+// union and an intersection of two sets of the same shape.
+static void benchShape(const char* name, const std::vector<int>& first, const std::vector<int>& second) {
+    MemoryManager<int> manager(false);
+    CompressedBitmap bitmap1 = CompressedBitmap::fromSortedMemory(first.data(), static_cast<int>(first.size()));
+    CompressedBitmap bitmap2 = CompressedBitmap::fromSortedMemory(second.data(), static_cast<int>(second.size()));
+    std::vector<int> destination(first.size() + second.size());
+    int size1 = static_cast<int>(first.size());
+    int size2 = static_cast<int>(second.size());
+
+    double sortedUnion = bestOf(5, noSetup, [&]() {
+        manager.unionSortedMemory(first.data(), size1, second.data(), size2, destination.data(), ExecutionPolicy::sequential());
+    });
+    double sortedIntersection = bestOf(5, noSetup, [&]() {
+        manager.intersectSortedMemory(first.data(), size1, second.data(), size2, destination.data());
+    });
+    std::size_t cardinality = 0;
+    double bitmapUnion = bestOf(5, noSetup, [&]() { cardinality += bitmap1.unionWith(bitmap2).cardinality(); });
+    double bitmapIntersection = bestOf(5, noSetup, [&]() { cardinality += bitmap1.intersectWith(bitmap2).cardinality(); });
+
+    std::printf("%-8s n=%-8d sorted array %9zu bytes, bitmap %9zu bytes (x%.2f)  union %7.3f -> %7.3f ms  intersect %7.3f -> %7.3f ms\n",
+        name, size1, first.size() * sizeof(int), bitmap1.sizeInBytes(), static_cast<double>(first.size() * sizeof(int)) / bitmap1.sizeInBytes(),
+        sortedUnion, bitmapUnion, sortedIntersection, bitmapIntersection);
+}
+
+int main() {
+    std::mt19937 random(1);
+    std::vector<int> sparse1 = makeSet(random, 1000000, 2000000000);
+    std::vector<int> sparse2 = makeSet(random, 1000000, 2000000000);
+    benchShape("sparse", sparse1, sparse2);
+
+    std::vector<int> medium1 = makeSet(random, 1000000, 100000000);
+    std::vector<int> medium2 = makeSet(random, 1000000, 100000000);
+    benchShape("medium", medium1, medium2);
+
+    std::vector<int> dense1 = makeSet(random, 1000000, 2000000);
+    std::vector<int> dense2 = makeSet(random, 1000000, 2000000);
+    benchShape("dense", dense1, dense2);
+
+    std::vector<int> runs1 = makeRuns(random, 100, 10000);
+    std::vector<int> runs2 = makeRuns(random, 100, 10000);
+    benchShape("runs", runs1, runs2);
+    return 0;
+}
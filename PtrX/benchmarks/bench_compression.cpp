@@ -0,0 +1,133 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static double megabytesPerSecond(std::size_t bytes, double milliseconds) {
+    return bytes / 1e3 / milliseconds;
+}
+
+// Low entropy is long runs, medium is short runs over a few values, high is uniformly random.
+static std::vector<int> makeInput(std::mt19937& random, int size, int entropy) {
+    std::vector<int> values(size);
+    int value = 0;
+    int remaining = 0;
+    for (int i = 0; i < size; ++i) {
+        if (entropy == 0) {
+            values[i] = i / 1000;
+            continue;
+        }
+        if (entropy == 2) {
+            values[i] = static_cast<int>(random());
+            continue;
+        }
+        if (remaining == 0) {
+            value = static_cast<int>(random() % 16);
+            remaining = 1 + static_cast<int>(random() % 8);
+        }
+        values[i] = value;
+        --remaining;
+    }
+    return values;
+}
+
+static void release(MemoryManager<int>& manager, int*& block) {
+    if (block != nullptr) {
+        manager.deallocateMemory(block);
+        block = nullptr;
+    }
+}
+
+// Ratio and throughput of one compressMemory format, measured on the decoded size.
+static void benchFormat(const char* name, const char* input, const std::vector<int>& values, CompressionFormat format) {
+    MemoryManager<int> manager(false);
+    int size = static_cast<int>(values.size());
+    std::size_t bytes = values.size() * sizeof(int);
+    int compressedSize = 0;
+    int* compressed = nullptr;
+    double encode = bestOf(3, [&]() { release(manager, compressed); },
+        [&]() { compressed = manager.compressMemory(values.data(), size, compressedSize, format); });
+    int* decompressed = nullptr;
+    double decode = bestOf(5, [&]() { release(manager, decompressed); },
+        [&]() { decompressed = manager.decompressMemory(compressed, compressedSize, size); });
+    std::printf("%-14s %-7s ratio %8.2f  encode %7.0f MB/s  decode %7.0f MB/s\n", name, input,
+        static_cast<double>(bytes) / (compressedSize * sizeof(int)), megabytesPerSecond(bytes, encode), megabytesPerSecond(bytes, decode));
+    release(manager, compressed);
+    release(manager, decompressed);
+}
+
+// The raw DeltaCodec on a sorted column with small gaps, its target workload.
+static void benchDeltaCodec(std::mt19937& random) {
+    const int count = 1 << 24;
+    std::vector<int> values(count);
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        value += static_cast<int>(random() % 64);
+        values[i] = value;
+    }
+    std::vector<unsigned char> encoded(DeltaCodec::maxEncodedSize(count, 4));
+    std::vector<int> decoded(count);
+    int length = 0;
+    double encode = bestOf(5, noSetup, [&]() { length = DeltaCodec::encode(values.data(), count, encoded.data()); });
+    double decode = bestOf(5, noSetup, [&]() { DeltaCodec::decode(encoded.data(), length, decoded.data()); });
+    std::printf("%-14s %-7s ratio %8.2f  encode %7.0f MB/s  decode %7.0f MB/s\n", "DeltaCodec", "sorted", count * 4.0 / length,
+        megabytesPerSecond(count * sizeof(int), encode), megabytesPerSecond(count * sizeof(int), decode));
+}
+
+// The raw LzCodec on 8 MiB corpora generated in place: English-like text, fixed-layout records with a
+// counter and a few varying fields, and random bytes.
+static void benchLzCorpora(std::mt19937& random) {
+    const std::size_t corpusSize = 8u << 20;
+    const char* words[] = { "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog ", "memory ", "manager ",
+        "pointer ", "block " };
+    std::vector<unsigned char> text;
+    while (text.size() < corpusSize) {
+        const char* word = words[random() % 12];
+        text.insert(text.end(), word, word + std::strlen(word));
+    }
+    text.resize(corpusSize);
+
+    std::vector<unsigned char> records(corpusSize);
+    for (std::size_t offset = 0; offset + 32 <= corpusSize; offset += 32) {
+        std::uint32_t fields[8] = { static_cast<std::uint32_t>(offset / 32), 0x11223344u, static_cast<std::uint32_t>(random() % 100),
+            7u, 0u, static_cast<std::uint32_t>(random() % 4), 0xffffffffu, 42u };
+        std::memcpy(records.data() + offset, fields, 32);
+    }
+
+    std::vector<unsigned char> noise(corpusSize);
+    for (std::size_t i = 0; i < corpusSize; ++i) {
+        noise[i] = static_cast<unsigned char>(random());
+    }
+
+    const char* names[] = { "text", "records", "random" };
+    const std::vector<unsigned char>* corpora[] = { &text, &records, &noise };
+    for (int c = 0; c < 3; ++c) {
+        const std::vector<unsigned char>& corpus = *corpora[c];
+        int length = static_cast<int>(corpus.size());
+        std::vector<unsigned char> encoded(LzCodec::maxEncodedSize(length));
+        std::vector<unsigned char> decoded(length);
+        int encodedLength = 0;
+        double encode = bestOf(3, noSetup, [&]() { encodedLength = LzCodec::encode(corpus.data(), length, encoded.data()); });
+        double decode = bestOf(5, noSetup, [&]() { LzCodec::decode(encoded.data(), encodedLength, decoded.data(), length); });
+        std::printf("%-14s %-7s ratio %8.2f  encode %7.0f MB/s  decode %7.0f MB/s\n", "LzCodec", names[c],
+            static_cast<double>(length) / encodedLength, megabytesPerSecond(corpus.size(), encode), megabytesPerSecond(corpus.size(), decode));
+    }
+}
+
+int main() {
+    std::mt19937 random(1);
+    const char* inputs[] = { "low", "medium", "high" };
+    for (int entropy = 0; entropy < 3; ++entropy) {
+        std::vector<int> values = makeInput(random, 1 << 24, entropy);
+        benchFormat("RunLength", inputs[entropy], values, CompressionFormat::RunLength);
+        benchFormat("DeltaBitPacked", inputs[entropy], values, CompressionFormat::DeltaBitPacked);
+        benchFormat("Lz", inputs[entropy], values, CompressionFormat::Lz);
+    }
+    benchDeltaCodec(random);
+    benchLzCorpora(random);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+static void printRow(const char* name, const std::vector<unsigned int>& threads, const std::vector<double>& times) {
+    std::printf("%-22s", name);
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        std::printf("  %2u: %7.2f ms x%.2f", threads[i], times[i], times[0] / times[i]);
+    }
+    std::printf("\n");
+}
+
+// Thread-count scaling of the ExecutionPolicy overloads. Each row runs one operation on the same buffer with
+// parallel(1), parallel(2), ... up to the hardware concurrency, and prints the time and the speed-up over one thread.
+int main(int argc, char** argv) {
+    int size = static_cast<int>(largestSize(argc, argv, 1 << 24));
+    MemoryManager<int> manager(false);
+    std::vector<unsigned int> threads;
+    unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 1; t < hardware; t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(hardware);
+
+    std::mt19937 random(1);
+    std::vector<int> source(size), data(size), other(size);
+    for (int i = 0; i < size; ++i) {
+        source[i] = static_cast<int>(random());
+    }
+    std::printf("n=%d, threads 1..%u\n", size, hardware);
+
+    std::vector<double> times;
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(5, noSetup, [&]() { manager.copyMemory(source.data(), data.data(), size, policy); }));
+    }
+    printRow("copyMemory", threads, times);
+
+    times.clear();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(5, noSetup, [&]() { manager.fillMemory(data.data(), 7, size, policy); }));
+    }
+    printRow("fillMemory", threads, times);
+
+    times.clear();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(5, noSetup, [&]() { manager.calculateChecksum(source.data(), size, policy); }));
+    }
+    printRow("calculateChecksum", threads, times);
+
+    times.clear();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(5, noSetup, [&]() { manager.xorMemory(source.data(), data.data(), other.data(), size, policy); }));
+    }
+    printRow("xorMemory", threads, times);
+
+    times.clear();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(3, [&]() { data = source; }, [&]() { manager.sortMemory(data.data(), size, policy); }));
+    }
+    printRow("sortMemory", threads, times);
+
+    times.clear();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        ExecutionPolicy policy = ExecutionPolicy::parallel(threads[i]);
+        times.push_back(bestOf(3, noSetup, [&]() { manager.initializeMemoryWithRandomValues(data.data(), size, 1, policy); }));
+    }
+    printRow("random fill", threads, times);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+static double gigabytesPerSecond(std::size_t bytes, double milliseconds) {
+    return bytes / 1e6 / milliseconds;
+}
+
+// Fill rates of the random initializers in GB/s, with std::mt19937 as the baseline.
+static void benchFill(int size) {
+    MemoryManager<int> manager(false);
+    std::vector<int> data(size);
+    std::size_t bytes = data.size() * sizeof(int);
+
+    std::mt19937 twister(1);
+    double baseline = bestOf(3, noSetup, [&]() {
+        for (int i = 0; i < size; ++i) {
+            data[i] = static_cast<int>(twister() >> 1);
+        }
+    });
+    RandomEngine engine(1);
+    double xoshiro = bestOf(3, noSetup, [&]() { manager.initializeMemoryWithRandomValues(data.data(), size, engine); });
+    double bounded = bestOf(3, noSetup, [&]() { manager.initializeMemoryWithRandomValues(data.data(), size, 0, 999, engine); });
+    double philox = bestOf(3, noSetup, [&]() { manager.initializeMemoryWithRandomValues(data.data(), size, 1, ExecutionPolicy::sequential()); });
+    double parallel = bestOf(3, noSetup, [&]() { manager.initializeMemoryWithRandomValues(data.data(), size, 1, ExecutionPolicy::parallel()); });
+    std::printf("fill n=%d: std::mt19937 %.2f  RandomEngine %.2f  bounded %.2f  Philox %.2f  Philox parallel %.2f GB/s\n", size,
+        gigabytesPerSecond(bytes, baseline), gigabytesPerSecond(bytes, xoshiro), gigabytesPerSecond(bytes, bounded),
+        gigabytesPerSecond(bytes, philox), gigabytesPerSecond(bytes, parallel));
+}
+
+// The bucket shuffle against Fisher-Yates, both through std::shuffle and through shuffleMemory with a
+// RandomEngine, from 1M elements up to 100M or the size given on the command line (for example 1000000000).
+static void benchShuffle(long long largest) {
+    MemoryManager<int> manager(false);
+    for (long long size = 1000000; size <= largest; size *= 10) {
+        int count = static_cast<int>(size);
+        std::vector<int> data(count);
+        std::iota(data.begin(), data.end(), 0);
+        std::mt19937_64 twister(1);
+        RandomEngine engine(1);
+
+        double standard = bestOf(3, noSetup, [&]() { std::shuffle(data.begin(), data.end(), twister); });
+        double fisherYates = bestOf(3, noSetup, [&]() { manager.shuffleMemory(data.data(), count, engine); });
+        double bucket = bestOf(3, noSetup, [&]() { manager.shuffleMemory(data.data(), count, 1, ExecutionPolicy::sequential()); });
+        double parallel = bestOf(3, noSetup, [&]() { manager.shuffleMemory(data.data(), count, 1, ExecutionPolicy::parallel()); });
+        std::printf("shuffle n=%-10lld std::shuffle %8.1f ms  Fisher-Yates %8.1f ms  bucket %8.1f ms  bucket parallel %8.1f ms\n", size,
+            standard, fisherYates, bucket, parallel);
+    }
+}
+
+int main(int argc, char** argv) {
+    benchFill(1 << 24);
+    benchShuffle(largestSize(argc, argv, 100000000));
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+// rotateMemoryLeft against std::rotate over a size/shift matrix, in ns per element. Sizes run from
+// L1-resident (4 KiB) through L2 and the last-level cache to DRAM (64M elements by default, or the size given
+// on the command line), and shifts cover the short-shift, cycle-leader and block-swap strategies.
+int main(int argc, char** argv) {
+    long long largest = largestSize(argc, argv, 64 << 20);
+    MemoryManager<int> manager(false);
+
+    for (long long size = 1024; size <= largest; size *= 8) {
+        int count = static_cast<int>(size);
+        std::vector<int> data(count);
+        std::iota(data.begin(), data.end(), 0);
+        int repetitions = static_cast<int>(std::max(3LL, std::min(10000LL, (1LL << 26) / size)));
+        const int shifts[] = { 1, 8, 64, 1000, count / 3, count / 2 };
+
+        for (int s = 0; s < 6; ++s) {
+            int shift = shifts[s];
+            if (shift <= 0 || shift >= count) {
+                continue;
+            }
+            double standard = bestOf(repetitions, noSetup, [&]() { std::rotate(data.begin(), data.begin() + shift, data.end()); });
+            double engine = bestOf(repetitions, noSetup, [&]() { manager.rotateMemoryLeft(data.data(), count, shift); });
+            std::printf("n=%-10lld shift %-9d std::rotate %6.3f  rotateMemoryLeft %6.3f ns/elem  x%.2f\n", size, shift,
+                standard * 1e6 / size, engine * 1e6 / size, standard / engine);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static double lookupsPerSecond(int keyCount, double milliseconds) {
+    return keyCount / milliseconds / 1e3;
+}
+
+// Point lookups in sorted blocks from L1-resident to DRAM-sized, in millions of lookups per second. The sweep
+// crosses each cache boundary so that the size where the Eytzinger layout overtakes binary search is visible;
+// the batch column answers all keys in one batchBinarySearch call.
+static void benchLookups(long long largest) {
+    MemoryManager<int> manager(false);
+    std::mt19937 random(1);
+    const int keyCount = 1 << 20;
+    std::vector<int> keys(keyCount);
+
+    for (long long size = 1024; size <= largest; size *= 4) {
+        int count = static_cast<int>(size);
+        std::vector<int> block(count);
+        for (int i = 0; i < count; ++i) {
+            block[i] = 2 * i;
+        }
+        for (int i = 0; i < keyCount; ++i) {
+            keys[i] = static_cast<int>(random() % (2u * static_cast<unsigned int>(count)));
+        }
+        EytzingerIndex<int> index(block.data(), count);
+        std::vector<int> results(keyCount);
+        long long checksum = 0;
+
+        double standard = bestOf(3, noSetup, [&]() {
+            for (int i = 0; i < keyCount; ++i) {
+                checksum += std::lower_bound(block.begin(), block.end(), keys[i]) - block.begin();
+            }
+        });
+        double branchless = bestOf(3, noSetup, [&]() {
+            for (int i = 0; i < keyCount; ++i) {
+                checksum += manager.lowerBound(block.data(), count, keys[i]);
+            }
+        });
+        double eytzinger = bestOf(3, noSetup, [&]() {
+            for (int i = 0; i < keyCount; ++i) {
+                checksum += index.lowerBound(keys[i]);
+            }
+        });
+        double batch = bestOf(3, noSetup, [&]() { manager.batchBinarySearch(block.data(), count, keys.data(), keyCount, results.data()); });
+        std::printf("n=%-11lld %9.1f KiB  std::lower_bound %6.1f  lowerBound %6.1f  EytzingerIndex %6.1f  batchBinarySearch %6.1f M/s  (%lld)\n",
+            size, size * sizeof(int) / 1024.0, lookupsPerSecond(keyCount, standard), lookupsPerSecond(keyCount, branchless),
+            lookupsPerSecond(keyCount, eytzinger), lookupsPerSecond(keyCount, batch), checksum);
+    }
+}
+
+int main(int argc, char** argv) {
+    benchLookups(largestSize(argc, argv, 64 << 20));
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+// nthElement, topK and the partitions against their standard library counterparts on 10M ints.
+int main() {
+    const int size = 10000000;
+    MemoryManager<int> manager(false);
+    std::mt19937 random(1);
+    std::vector<int> source(size), fewDistinct(size);
+    for (int i = 0; i < size; ++i) {
+        source[i] = static_cast<int>(random());
+        fewDistinct[i] = static_cast<int>(random() % 16);
+    }
+    std::vector<int> data;
+    std::function<void()> reset = [&]() { data = source; };
+    std::function<void()> resetFewDistinct = [&]() { data = fewDistinct; };
+
+    double standard = bestOf(5, reset, [&]() { std::nth_element(data.begin(), data.begin() + size / 2, data.end()); });
+    double select = bestOf(5, reset, [&]() { manager.nthElement(data.data(), size, size / 2); });
+    std::printf("median, random:      std::nth_element %6.1f ms, nthElement %6.1f ms\n", standard, select);
+    standard = bestOf(5, resetFewDistinct, [&]() { std::nth_element(data.begin(), data.begin() + size / 2, data.end()); });
+    select = bestOf(5, resetFewDistinct, [&]() { manager.nthElement(data.data(), size, size / 2); });
+    std::printf("median, 16 distinct: std::nth_element %6.1f ms, nthElement %6.1f ms\n", standard, select);
+
+    const int ks[] = { 100, 10000, 100000, 1000000 };
+    for (int i = 0; i < 4; ++i) {
+        int k = ks[i];
+        std::vector<int> top(k);
+        double partial = bestOf(5, reset, [&]() { std::partial_sort(data.begin(), data.begin() + k, data.end(), std::greater<int>()); });
+        double topK = bestOf(5, noSetup, [&]() { manager.topK(source.data(), size, k, top.data()); });
+        std::printf("top %7d:         std::partial_sort %6.1f ms, topK %6.1f ms\n", k, partial, topK);
+    }
+
+    int lower = 0, upper = 0;
+    double partition = bestOf(5, reset, [&]() { std::partition(data.begin(), data.end(), [](int value) { return value < 0; }); });
+    double partitionMemory = bestOf(5, reset, [&]() { manager.partitionMemory(data.data(), size, 0); });
+    double threeWay = bestOf(5, resetFewDistinct, [&]() { manager.threeWayPartition(data.data(), size, 8, lower, upper); });
+    std::printf("partition at 0:      std::partition %6.1f ms, partitionMemory %6.1f ms, threeWayPartition (16 distinct) %6.1f ms\n",
+        partition, partitionMemory, threeWay);
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include "ptrX.h"
+#include "bench_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Repetitions that keep every size at roughly the same total work.
+static int repetitionsFor(long long size) {
+    return static_cast<int>(std::max(3LL, std::min(1000LL, (1LL << 24) / size)));
+}
+
+// sortMemory against std::sort from cache-resident to DRAM-sized buffers, so that the size at which the
+// radix sort overtakes the comparison sort is visible. The double rows take the comparison-sort path.
+template <typename T>
+static void benchSort(const char* name, long long largest) {
+    MemoryManager<T> manager(false);
+    std::mt19937_64 random(1);
+    for (long long size = 1000; size <= largest; size *= 4) {
+        int count = static_cast<int>(size);
+        std::vector<T> source(count), data;
+        for (int i = 0; i < count; ++i) {
+            source[i] = static_cast<T>(random());
+        }
+        std::function<void()> reset = [&]() { data = source; };
+        int repetitions = repetitionsFor(size);
+
+        double standard = bestOf(repetitions, reset, [&]() { std::sort(data.begin(), data.end()); });
+        double radix = bestOf(repetitions, reset, [&]() { manager.sortMemory(data.data(), count, ExecutionPolicy::sequential()); });
+        std::printf("sort %-9s n=%-10lld std::sort %8.2f ns/elem  sortMemory %8.2f ns/elem  x%.2f\n", name, size,
+            standard * 1e6 / size, radix * 1e6 / size, standard / radix);
+    }
+}
+
+int main(int argc, char** argv) {
+    long long largest = largestSize(argc, argv, 16000000);
+    benchSort<int>("int", largest);
+    benchSort<unsigned int>("unsigned", largest);
+    benchSort<long long>("long long", largest);
+    benchSort<double>("double", largest);
+    return 0;
+}
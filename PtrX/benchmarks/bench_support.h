@@ -0,0 +1,35 @@
+#ifndef PTRX_BENCH_SUPPORT_H
+#define PTRX_BENCH_SUPPORT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+
+// Timing helper shared by the benchmark executables. Each benchmark is a plain program that prints
+// one line per measurement, so the numbers can be compared by eye or diffed between builds.
+
+// Runs setup then body repetitions times and returns the fastest body in milliseconds; setup is not timed.
+static inline double bestOf(int repetitions, const std::function<void()>& setup, const std::function<void()>& body) {
+    double best = 0.0;
+    for (int r = 0; r < repetitions; ++r) {
+        setup();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        body();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+static inline void noSetup() {
+}
+
+// Returns the largest size a sweep should reach: the first command-line argument if one is given, so that
+// DRAM-sized runs are opt-in, and fallback otherwise.
+static inline long long largestSize(int argc, char** argv, long long fallback) {
+    long long size = argc > 1 ? std::atoll(argv[1]) : 0;
+    return size > 0 ? size : fallback;
+}
+
+#endif // PTRX_BENCH_SUPPORT_H
@@ -7,12 +7,402 @@
 #include <cstring>
 #include <vector>
 #include <iterator>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <atomic>
+#include <type_traits>
+#include <cstdint>
+
+// Execution Policies
+enum class ExecutionMode {
+    Sequential,
+    Parallel
+};
+
+struct ExecutionPolicy {
+    ExecutionMode mode;
+    unsigned int threadCount;
+
+    static ExecutionPolicy sequential();
+    static ExecutionPolicy parallel(unsigned int threadCount = 0);
+};
+
+// Compression Formats
+enum class CompressionFormat {
+    RunLength = 0,
+    DeltaBitPacked = 1,
+    Lz = 2
+};
+
+class CpuFeatures {
+public:
+    static bool hasAvx2();
+    static bool hasAvx512();
+    static bool hasAesNi();
+    static bool hasPclmul();
+
+private:
+    static bool cpuidBit(unsigned int leaf, int registerIndex, int bit);
+    static bool osSavesState(std::uint64_t mask);
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int threadCount = 0, bool pinThreads = false);
+    ~ThreadPool();
+    unsigned int getThreadCount() const;
+    void submit(std::function<void()> task);
+    bool runPendingTask();
+    void parallelFor(std::size_t count, std::size_t grainSize, unsigned int maxThreads,
+        const std::function<void(std::size_t, std::size_t)>& body);
+    static std::shared_ptr<ThreadPool> getDefault();
+
+private:
+    struct WorkQueue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    struct WorkerContext {
+        ThreadPool* pool;
+        unsigned int index;
+    };
+
+    void workerLoop(unsigned int index);
+    bool popTask(unsigned int index, std::function<void()>& task);
+    bool stealTask(unsigned int thiefIndex, std::function<void()>& task);
+    static WorkerContext& currentWorker();
+    static void pinCurrentThread(unsigned int core);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> pendingTasks;
+    std::atomic<unsigned int> nextQueue;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+};
+
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+
+    void join();
+    void finishTask(std::exception_ptr error);
+
+    ThreadPool& pool;
+    std::atomic<std::size_t> pendingTasks;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    std::exception_ptr firstError;
+};
+
+class CompressedBitmap {
+public:
+    CompressedBitmap();
+    static CompressedBitmap fromSortedMemory(const int* sortedBlock, int size);
+    int toSortedMemory(int* destination) const;
+    void add(int value);
+    bool contains(int value) const;
+    std::size_t cardinality() const;
+    std::size_t sizeInBytes() const;
+    CompressedBitmap unionWith(const CompressedBitmap& other) const;
+    CompressedBitmap intersectWith(const CompressedBitmap& other) const;
+    CompressedBitmap differenceWith(const CompressedBitmap& other) const;
+    CompressedBitmap xorWith(const CompressedBitmap& other) const;
+
+private:
+    enum ContainerType {
+        ArrayContainer,
+        BitmapContainer,
+        RunContainer
+    };
+
+    enum BitmapOperation {
+        BitmapUnion,
+        BitmapIntersection,
+        BitmapDifference,
+        BitmapXor
+    };
+
+    struct Container {
+        ContainerType type;
+        std::uint16_t key;
+        std::uint32_t cardinality;
+        std::vector<std::uint16_t> values;
+        std::vector<std::uint64_t> words;
+    };
+
+    static CompressedBitmap combine(const CompressedBitmap& left, const CompressedBitmap& right, BitmapOperation operation);
+    static Container combineContainers(const Container& left, const Container& right, BitmapOperation operation);
+    static Container makeContainer(std::uint16_t key, const std::uint16_t* values, std::size_t count);
+    static Container makeContainer(std::uint16_t key, const std::uint64_t* words);
+    static void toWords(const Container& container, std::uint64_t* words);
+    static bool containsLow(const Container& container, std::uint16_t low);
+    static int popcount64(std::uint64_t word);
+    static std::uint32_t toUnsigned(int value);
+    static int toSigned(std::uint32_t value);
+
+    std::vector<Container> containers;
+};
+
+class DeltaCodec {
+public:
+    static const int BlockSize = 128;
+
+    static int maxEncodedSize(int count, int elementSize);
+    template <typename Integer>
+    static int encode(const Integer* source, int count, unsigned char* destination);
+    template <typename Integer>
+    static bool decode(const unsigned char* source, int length, Integer* destination);
+    template <typename Integer>
+    static int decodeBlock(const unsigned char* source, int length, int blockIndex, Integer* destination);
+    template <typename Integer>
+    static bool blockRange(const unsigned char* source, int length, int blockIndex, Integer& minimum, Integer& maximum);
+    static int encodedCount(const unsigned char* source, int length);
+    static int blockCount(const unsigned char* source, int length);
+
+private:
+    static const int HeaderSize = 10;
+
+    static bool readHeader(const unsigned char* source, int length, int elementSize, int& count);
+    static const unsigned char* blockAt(const unsigned char* source, int length, int elementSize, int blockIndex);
+    static int bitWidth(std::uint64_t value);
+    static void packBlock(const std::uint32_t* values, int width, unsigned char* output);
+    static void packBlock(const std::uint64_t* values, int width, unsigned char* output);
+    static void unpackBlock(const unsigned char* input, int width, std::uint32_t base, std::uint32_t* output);
+    static void unpackBlock(const unsigned char* input, int width, std::uint64_t base, std::uint64_t* output);
+};
+
+class LzCodec {
+public:
+    static int maxEncodedSize(int length);
+    static std::uint64_t maxDecodedSize(int length);
+    static int encode(const unsigned char* source, int length, unsigned char* destination);
+    static bool decode(const unsigned char* source, int length, unsigned char* destination, int decodedLength);
+
+private:
+    static const int MinMatch = 4;
+    static const int HashBits = 16;
+    static const int WindowSize = 65536;
+    static const int MaxAttempts = 16;
+    static const int LastLiterals = 5;
+    static const int MatchSearchLimit = 12;
+
+    static std::uint32_t read32(const unsigned char* address);
+    static std::uint32_t hashSequence(std::uint32_t sequence);
+    static void writeLength(unsigned char*& output, int length);
+    static bool readLength(const unsigned char*& input, const unsigned char* end, int& length);
+};
+
+class ChaCha20 {
+public:
+    static const int KeySize = 32;
+    static const int NonceSize = 12;
+    static const int BlockSize = 64;
+
+    static void keystreamBlock(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, unsigned char* output);
+    static bool xorKeystream(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, unsigned char* data, std::size_t length);
+
+private:
+    static void initializeState(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, std::uint32_t* state);
+    static std::uint32_t rotateLeft(std::uint32_t value, int shift);
+    static void xorBlock(const std::uint32_t* state, unsigned char* data, std::size_t length);
+    static void xorBlocks4(const std::uint32_t* state, unsigned char* data);
+    static void xorBlocks8(const std::uint32_t* state, unsigned char* data);
+    static void xorBlocks16(const std::uint32_t* state, unsigned char* data);
+};
+
+class AesKey {
+public:
+    static const int BlockSize = 16;
+    static const int NonceSize = 12;
+    static const int TagSize = 16;
+
+    AesKey();
+    AesKey(const unsigned char* key, int keySize);
+    ~AesKey();
+    bool setKey(const unsigned char* key, int keySize);
+    bool isValid() const;
+    int getKeySize() const;
+    void encryptBlock(const unsigned char* input, unsigned char* output) const;
+    bool ctrXor(const unsigned char* counterBlock, std::uint64_t blockOffset, unsigned char* data, std::size_t length) const;
+    bool gcmEncrypt(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data, std::size_t length,
+        unsigned char* tag) const;
+    bool gcmDecrypt(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data, std::size_t length,
+        const unsigned char* tag) const;
+
+private:
+    static bool useHardware();
+    static std::uint64_t loadBigEndian64(const unsigned char* bytes);
+    static void storeBigEndian64(unsigned char* bytes, std::uint64_t value);
+    static std::uint64_t byteSwap64(std::uint64_t value);
+    static std::uint64_t transposeBits(std::uint64_t value);
+    static void substituteBitPlanes(std::uint64_t* planes);
+    static void substituteBytes(unsigned char* bytes, int length);
+    static unsigned char doubleByte(unsigned char value);
+    static void encryptBlocksSoftware(const unsigned char* roundKeys, int rounds, unsigned char* blocks, int count);
+    static void multiplyHash(std::uint64_t& high, std::uint64_t& low, std::uint64_t hashHigh, std::uint64_t hashLow);
+    static void encryptBlockHardware(const unsigned char* roundKeys, int rounds, const unsigned char* input, unsigned char* output);
+    static void ctrBlocksHardware(const unsigned char* roundKeys, int rounds, std::uint64_t& counterHigh, std::uint64_t& counterLow,
+        unsigned char* data, std::size_t length);
+    static void ghashHardware(const unsigned char* hashPowers, unsigned char* state, const unsigned char* data, std::size_t length);
+    void ctrBlocks(std::uint64_t& counterHigh, std::uint64_t& counterLow, unsigned char* data, std::size_t length) const;
+    void ghashUpdate(unsigned char* state, const unsigned char* data, std::size_t length) const;
+    void gcmAuthenticate(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data,
+        std::size_t length, bool encrypt, unsigned char* tag) const;
+
+    unsigned char roundKeys[240];
+    unsigned char hashPowers[128];
+    int rounds;
+    int keySize;
+};
+
+class RandomEngine {
+public:
+    typedef std::uint64_t result_type;
+
+    explicit RandomEngine(std::uint64_t seed = 0);
+    void seed(std::uint64_t seed);
+    result_type operator()();
+    std::uint32_t nextBounded(std::uint32_t bound);
+    int nextInRange(int low, int high);
+    void jump();
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+    static RandomEngine& threadLocal();
+
+private:
+    static std::uint64_t splitMix64(std::uint64_t& state);
+    static std::uint64_t rotateLeft(std::uint64_t value, int shift);
+
+    std::uint64_t state[4];
+};
+
+class PhiloxEngine {
+public:
+    explicit PhiloxEngine(std::uint64_t seed = 0);
+    void generateBlock(std::uint64_t counter, std::uint32_t* output) const;
+    void fill(std::uint64_t firstWord, std::uint32_t* destination, std::size_t count) const;
+    void fillBounded(std::uint64_t firstWord, std::uint32_t bound, std::uint32_t* destination, std::size_t count) const;
+
+private:
+    static void generateBlock(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output);
+    static void generateBlocks4(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output);
+    static void generateBlocks8(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output);
+
+    std::uint32_t key[2];
+};
+
+template <typename T>
+class EytzingerIndex {
+public:
+    EytzingerIndex();
+    EytzingerIndex(const T* sortedBlock, int size);
+    bool build(const T* sortedBlock, int size);
+    int size() const;
+    int lowerBound(const T& key) const;
+    int upperBound(const T& key) const;
+    int find(const T& key) const;
+
+private:
+    template <bool Upper>
+    std::size_t descend(const T& key) const;
+    std::size_t rankOf(std::size_t k) const;
+    static std::size_t floorLog2(std::size_t value);
+
+    std::vector<T> nodes;
+    std::size_t height;
+    std::size_t lastLevelCount;
+};
+
+template <typename T>
+class RadixSplineIndex {
+public:
+    RadixSplineIndex();
+    RadixSplineIndex(const T* sortedBlock, int size, int maxError = 32, int radixBits = 0);
+    bool build(const T* sortedBlock, int size, int maxError = 32, int radixBits = 0);
+    int size() const;
+    bool searchBound(const T& key, int& begin, int& end) const;
+    int lowerBound(const T* sortedBlock, const T& key) const;
+    int find(const T* sortedBlock, const T& key) const;
+    std::size_t sizeInBytes() const;
+    int serializedSize() const;
+    int serialize(unsigned char* destination) const;
+    bool deserialize(const unsigned char* source, int sourceSize);
+
+private:
+    struct SplinePoint {
+        std::uint64_t key;
+        std::uint32_t position;
+    };
+
+    static std::uint64_t toKey(const T& value);
+    double estimatePosition(std::uint64_t key) const;
+    void addSplinePoint(std::uint64_t key, std::uint32_t position);
+    void buildRadixTable(int requestedBits);
+
+    std::vector<SplinePoint> points;
+    std::vector<std::uint32_t> radixTable;
+    std::uint64_t minKey;
+    std::uint64_t maxKey;
+    int elementCount;
+    int maxError;
+    int radixBits;
+    int shift;
+};
+
+template <typename T>
+class BloomFilter {
+public:
+    BloomFilter();
+    BloomFilter(int expectedCount, double falsePositiveRate = 0.01);
+    BloomFilter(const T* address, int size, double falsePositiveRate = 0.01);
+    bool reset(int expectedCount, double falsePositiveRate = 0.01);
+    void insert(const T& value);
+    bool insert(const T* address, int size);
+    bool mayContain(const T& value) const;
+    void clear();
+    int getHashCount() const;
+    std::size_t sizeInBytes() const;
+
+private:
+    static std::uint64_t hash(const T& value);
+    static const std::uint32_t* salts();
+
+    std::vector<std::uint32_t> words;
+    std::size_t blockCount;
+    int hashCount;
+};
+
+template <typename T>
+class FlatHashSet;
+
+template <typename T>
+class FrameCompressor;
+
+template <typename T>
+class FrameDecompressor;
 
 template <typename T>
 class MemoryManager {
 public:
     // Memory Management
     MemoryManager(bool log);
+    MemoryManager(bool log, std::shared_ptr<ThreadPool> pool);
     ~MemoryManager();
     T* allocateMemory(int size);
     void deallocateMemory(T* ptr);
@@ -41,6 +431,9 @@ public:
     void initializeMemoryWithRandomValues(T* address, int size);
     bool swapMemoryWithOffset(T* address1, T* address2, int size, int offset);
     void shuffleMemory(T* address, int size);
+    bool initializeMemoryWithRandomValues(T* address, int size, RandomEngine& engine);
+    bool initializeMemoryWithRandomValues(T* address, int size, int low, int high, RandomEngine& engine);
+    bool shuffleMemory(T* address, int size, RandomEngine& engine);
     bool reverseMemoryWithOffset(T* address, int size, int offset);
     T* resizeAndInitializeMemory(T* ptr, int oldSize, int newSize, int initValue);
     void shiftMemoryCircular(T* address, int size, int shiftCount);
@@ -58,8 +451,18 @@ public:
     void printMemoryStatistics(const T* address, int size);
     T* compressMemory(const T* source, int size, int& compressedSize);
     T* decompressMemory(const T* compressedData, int compressedSize, int originalSize);
-    void encryptMemory(T* address, int size, const std::string& key);
-    void decryptMemory(T* address, int size, const std::string& key);
+    T* compressMemory(const T* source, int size, int& compressedSize, CompressionFormat format);
+    T* decompressMemory(const T* compressedData, int compressedSize, int originalSize, CompressionFormat format);
+    bool encryptMemory(T* address, int size, const std::string& key, const std::string& nonce);
+    bool decryptMemory(T* address, int size, const std::string& key, const std::string& nonce);
+    bool encryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter);
+    bool decryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter);
+    bool encryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock);
+    bool decryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock);
+    bool encryptMemoryAuthenticated(T* address, int size, const AesKey& key, const unsigned char* nonce,
+        const unsigned char* aad, int aadLength, unsigned char* tag);
+    bool decryptMemoryAuthenticated(T* address, int size, const AesKey& key, const unsigned char* nonce,
+        const unsigned char* aad, int aadLength, const unsigned char* tag);
 
     // Memory Range Operations
     void reverseMemoryInRange(T* address, int start, int end);
@@ -67,9 +470,11 @@ public:
     void rotateMemoryRight(T* address, int size, int shiftCount);
 
     // Memory Set Operations
-    void uniqueMemory(T* address, int& size);
-    void removeValue(T* address, int& size, int value);
-    void removeAllOccurrences(T* address, int& size, int value);
+    int uniqueMemory(T* address, int& size);
+    int removeValue(T* address, int& size, int value);
+    int removeAllOccurrences(T* address, int& size, int value);
+    template <typename Predicate>
+    int removeIf(T* address, int& size, Predicate predicate);
     void resizeMemoryWithDefaultValue(T* address, int& size, int newSize, int defaultValue);
 
     // Memory Checks
@@ -120,12 +525,258 @@ public:
 
     bool isMemoryMountain(const T* address, int size, int& peakIndex);
 
+    // Sorting
+    bool sortMemory(T* address, int size);
+    bool sortMemory(T* address, int size, const ExecutionPolicy& policy);
+
+    // Deduplication
+    int deduplicateMemoryStable(T* address, int size);
+    int deduplicateMemoryStable(T* address, int size, const ExecutionPolicy& policy);
+
+    // Selection
+    bool nthElement(T* address, int size, int n);
+    bool nthElement(T* address, int size, int n, const ExecutionPolicy& policy);
+    bool topK(const T* address, int size, int k, T* destination);
+    bool topK(const T* address, int size, int k, T* destination, const ExecutionPolicy& policy);
+    int partitionMemory(T* address, int size, int pivotValue);
+    int partitionMemory(T* address, int size, int pivotValue, const ExecutionPolicy& policy);
+    bool threeWayPartition(T* address, int size, int pivotValue, int& lowerBound, int& upperBound, const ExecutionPolicy& policy);
+
+    // Sorted Set Operations
+    int mergeSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy);
+    int unionSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy);
+    int differenceSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy);
+    int symmetricDifferenceSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy);
+    T* intersectSortedMemory(const T* block1, int size1, const T* block2, int size2, int& intersectionSize);
+    int intersectSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination);
+    T* intersectManySortedMemory(const T* const* blocks, const int* blockSizes, int blockCount, int& intersectionSize);
+    T* mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, int& mergedSize);
+    int mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, T* destination);
+    int mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, T* destination, const ExecutionPolicy& policy);
+
+    // Sorted Search
+    int lowerBound(const T* sortedBlock, int size, int key);
+    int upperBound(const T* sortedBlock, int size, int key);
+    bool equalRange(const T* sortedBlock, int size, int key, int& first, int& last);
+    bool batchBinarySearch(const T* sortedBlock, int size, const int* keys, int keyCount, int* results);
+    int batchFindValue(const T* address, int size, const int* values, int valueCount, int* positions);
+
+    // Bloom Filter Lookups
+    const T* findValue(const T* address, int value, int size, const BloomFilter<T>& filter);
+    bool writeValue(T* address, int value, int size, BloomFilter<T>& filter);
+    void replaceValue(T* address, int size, int oldValue, int newValue, BloomFilter<T>& filter);
+
+    // Unsorted Set Operations
+    T* unionUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& unionSize);
+    T* intersectUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& intersectionSize);
+    T* differenceUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& differenceSize);
+
+    // Compressed Queries
+    int findValueCompressed(const T* compressedData, int compressedSize, int value);
+    int countValueCompressed(const T* compressedData, int compressedSize, int value);
+    bool sumCompressed(const T* compressedData, int compressedSize, long long& sum);
+    bool minMaxCompressed(const T* compressedData, int compressedSize, T& minimum, T& maximum);
+    int filterRangeCompressed(const T* compressedData, int compressedSize, int low, int high, int* positions);
+    void printMemoryStatisticsCompressed(const T* compressedData, int compressedSize);
+
+    // Parallel Operations
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+    bool copyMemory(const T* source, T* destination, int size, const ExecutionPolicy& policy);
+    bool fillMemory(T* address, int value, int size, const ExecutionPolicy& policy);
+    int calculateChecksum(const T* address, int size, const ExecutionPolicy& policy);
+    void replaceValue(T* address, int size, int oldValue, int newValue, const ExecutionPolicy& policy);
+    void xorMemory(const T* source1, const T* source2, T* destination, int size, const ExecutionPolicy& policy);
+    bool encryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter,
+        const ExecutionPolicy& policy);
+    bool decryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter,
+        const ExecutionPolicy& policy);
+    bool encryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock, const ExecutionPolicy& policy);
+    bool decryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock, const ExecutionPolicy& policy);
+    bool initializeMemoryWithRandomValues(T* address, int size, std::uint64_t seed, const ExecutionPolicy& policy);
+    bool initializeMemoryWithRandomValues(T* address, int size, int low, int high, std::uint64_t seed, const ExecutionPolicy& policy);
+    bool shuffleMemory(T* address, int size, std::uint64_t seed, const ExecutionPolicy& policy);
 
 private:
-    int size;
+    friend class FlatHashSet<T>;
+    friend class FrameCompressor<T>;
+    friend class FrameDecompressor<T>;
+
+    enum SetOperation {
+        SetUnion,
+        SetDifference,
+        SetSymmetricDifference
+    };
+
+    template <typename Function>
+    void runParallel(int size, const ExecutionPolicy& policy, Function body);
+    unsigned int parallelThreadCount(int size, const ExecutionPolicy& policy) const;
+    void sortElements(T* address, int size, unsigned int threads, std::true_type isInteger);
+    void sortElements(T* address, int size, unsigned int threads, std::false_type isInteger);
+    static std::uint64_t hashValue(const T& value);
+    static std::size_t mergePathSplit(const T* block1, std::size_t size1, const T* block2, std::size_t size2, std::size_t diagonal);
+    static std::size_t sortedSetKernel(SetOperation operation, const T* block1, std::size_t size1,
+        const T* block2, std::size_t size2, T* destination);
+    template <bool Upper>
+    static std::size_t branchlessBound(const T* block, std::size_t size, const T& key);
+    static std::size_t gallopLowerBound(const T* block, std::size_t begin, std::size_t size, const T& key);
+    static std::size_t intersectGalloping(const T* smaller, std::size_t smallerSize, const T* larger, std::size_t largerSize, T* destination);
+    static std::size_t intersectBlocks(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination, std::true_type isInt32);
+    static std::size_t intersectBlocks(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination, std::false_type isInt32);
+    static std::size_t intersectSorted(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination);
+    static std::size_t runEnd(const T* data, std::size_t begin, std::size_t size, std::true_type isInt32);
+    static std::size_t runEnd(const T* data, std::size_t begin, std::size_t size, std::false_type isInt32);
+    static bool encodeFrame(const T* source, std::size_t count, CompressionFormat format, std::vector<unsigned char>& frame);
+    static bool decodeFrame(const unsigned char* input, std::size_t length, T* output, std::size_t count);
+    template <typename Prune, typename Segment>
+    static bool scanCompressed(const T* compressedData, int compressedSize, Prune prune, Segment segment);
+    template <typename Prune, typename Segment>
+    static bool scanDeltaBlocks(const unsigned char* input, int length, std::size_t count, Prune prune, Segment segment, std::true_type isDeltaCodable);
+    template <typename Prune, typename Segment>
+    static bool scanDeltaBlocks(const unsigned char* input, int length, std::size_t count, Prune prune, Segment segment, std::false_type isDeltaCodable);
+    static std::size_t encodeRunLength(const T* source, std::size_t count, unsigned char* output);
+    static bool decodeRunLength(const unsigned char* input, std::size_t length, T* output, std::size_t count);
+    static int encodeDelta(const T* source, int count, unsigned char* output, std::true_type isDeltaCodable);
+    static int encodeDelta(const T* source, int count, unsigned char* output, std::false_type isDeltaCodable);
+    static bool decodeDelta(const unsigned char* input, int length, T* output, int count, std::true_type isDeltaCodable);
+    static bool decodeDelta(const unsigned char* input, int length, T* output, int count, std::false_type isDeltaCodable);
+    static void writeVarint(unsigned char*& output, std::uint64_t value);
+    static bool readVarint(const unsigned char*& input, const unsigned char* end, std::uint64_t& value);
+    static void writeCompressionHeader(unsigned char* output, unsigned char format, std::uint32_t count, std::uint32_t payloadBytes);
+    static bool readCompressionHeader(const unsigned char* input, std::size_t length, unsigned char& format,
+        std::uint32_t& count, std::uint32_t& payloadBytes);
+    T* packCompressedBytes(const unsigned char* bytes, std::size_t byteCount, int& compressedSize);
+    static void loserTreeMerge(const T* const* runBegins, const T* const* runEnds, std::size_t runCount, T* destination);
+    std::size_t runSortedSetOperation(SetOperation operation, const T* block1, std::size_t size1,
+        const T* block2, std::size_t size2, T* destination, const ExecutionPolicy& policy);
+    static std::size_t normalizeShift(int shiftCount, int length);
+    static void rotateRange(T* first, std::size_t length, std::size_t shift);
+    static void rotateRange(T* first, std::size_t length, std::size_t shift, std::true_type isTriviallyCopyable);
+    static void rotateRange(T* first, std::size_t length, std::size_t shift, std::false_type isTriviallyCopyable);
+    static void swapBlockBytes(unsigned char* block1, unsigned char* block2, std::size_t length);
+    static std::size_t removeEqual(T* address, std::size_t size, const T& value, std::true_type isInt32);
+    static std::size_t removeEqual(T* address, std::size_t size, const T& value, std::false_type isInt32);
+    template <typename Predicate>
+    static std::size_t removeMatching(T* address, std::size_t size, Predicate predicate, std::true_type isInt32);
+    template <typename Predicate>
+    static std::size_t removeMatching(T* address, std::size_t size, Predicate predicate, std::false_type isInt32);
+    static std::size_t removeAdjacentDuplicates(T* address, std::size_t size, std::true_type isInt32);
+    static std::size_t removeAdjacentDuplicates(T* address, std::size_t size, std::false_type isInt32);
+    static const std::uint64_t* compactionTable();
+    static std::size_t removeEqualAvx2(T* address, std::size_t size, T value, std::size_t& index);
+    static std::size_t removeEqualAvx512(T* address, std::size_t size, T value, std::size_t& index);
+    template <typename Predicate>
+    static std::size_t removeMatchingAvx2(T* address, std::size_t size, Predicate& predicate, std::size_t& index);
+    static std::size_t removeAdjacentDuplicatesAvx2(T* address, std::size_t size, std::size_t& index, T& previous);
+    static std::size_t removeAdjacentDuplicatesAvx512(T* address, std::size_t size, std::size_t& index, T& previous);
+    static T* allocatePartitionScratch(std::size_t size);
+    std::size_t partitionElements(T* address, std::size_t size, const T& pivot, bool inclusive, T* scratch, const ExecutionPolicy& policy);
+    static std::size_t partitionBlock(T* address, std::size_t size, const T& pivot, bool inclusive, T* scratch, std::true_type isInt32);
+    static std::size_t partitionBlock(T* address, std::size_t size, const T& pivot, bool inclusive, T* scratch, std::false_type isInt32);
+    static std::size_t partitionBlockAvx2(T* address, std::size_t size, T pivot, bool inclusive, T* scratch, std::size_t& index, std::size_t& above);
+    static std::size_t partitionBlockAvx512(T* address, std::size_t size, T pivot, bool inclusive, T* scratch, std::size_t& index, std::size_t& above);
+    void selectElement(T* address, std::size_t size, std::size_t n, T* scratch, const ExecutionPolicy& policy);
+    T medianOfMedians(T* address, std::size_t size, T* scratch, const ExecutionPolicy& policy);
+    static T selectionPivot(const T* address, std::size_t size);
+
+    static const std::size_t CompressionHeaderSize = 14;
+    static const std::size_t RotationBufferBytes = 1024;
+    static const std::size_t RotationCacheBytes = 256 * 1024;
+    static const std::size_t SelectionCutoff = 32;
+    static const std::size_t TopKHeapRatio = 256;
+
+    std::shared_ptr<ThreadPool> threadPool;
     static bool logging;
 };
 
+template <typename T>
+class FlatHashSet {
+public:
+    enum InsertResult {
+        Inserted,
+        AlreadyPresent,
+        InsertFailed
+    };
+
+    explicit FlatHashSet(MemoryManager<T>& manager, int expectedCount = 0);
+    ~FlatHashSet();
+    FlatHashSet(const FlatHashSet&) = delete;
+    FlatHashSet& operator=(const FlatHashSet&) = delete;
+
+    InsertResult insert(const T& value);
+    int insert(const T* address, int size);
+    bool contains(const T& value) const;
+    bool erase(const T& value);
+    void clear();
+    bool reserve(int count);
+    int size() const;
+    int capacity() const;
+
+private:
+    static const std::size_t GroupWidth = 16;
+    static const std::int8_t EmptyControl = -128;
+    static const std::int8_t DeletedControl = -2;
+
+    static std::uint32_t matchByte(const std::int8_t* group, std::int8_t byte);
+    static std::uint32_t matchNonFull(const std::int8_t* group);
+    static int lowestBit(std::uint32_t mask);
+    std::size_t findSlot(const T& value, std::uint64_t hash) const;
+    std::size_t findInsertSlot(std::uint64_t hash) const;
+    void setControl(std::size_t slot, std::int8_t byte);
+    bool rehash(std::size_t newSlotCount);
+
+    MemoryManager<T>* manager;
+    T* slots;
+    std::vector<std::int8_t> control;
+    std::size_t slotCount;
+    std::size_t elementCount;
+    std::size_t deletedCount;
+};
+
+template <typename T>
+class FrameCompressor {
+public:
+    explicit FrameCompressor(MemoryManager<T>& manager, CompressionFormat format = CompressionFormat::Lz,
+        int frameSize = 65536, const ExecutionPolicy& policy = ExecutionPolicy::parallel());
+
+    bool push(const T* source, int size);
+    bool finish();
+    bool nextFrame(std::vector<unsigned char>& frame);
+    int readyFrameCount() const;
+    bool isFinished() const;
+
+private:
+    bool encodeFrames(const T* source, std::size_t count);
+
+    MemoryManager<T>* manager;
+    CompressionFormat format;
+    int frameSize;
+    ExecutionPolicy policy;
+    std::vector<T> pending;
+    std::deque<std::vector<unsigned char>> ready;
+    bool finished;
+};
+
+template <typename T>
+class FrameDecompressor {
+public:
+    explicit FrameDecompressor(MemoryManager<T>& manager);
+
+    bool open(const unsigned char* data, std::size_t length);
+    int frameCount() const;
+    int frameSize(int index) const;
+    std::size_t totalSize() const;
+    bool decodeFrame(int index, T* destination) const;
+    bool decodeAll(T* destination, const ExecutionPolicy& policy) const;
+    static std::size_t frameLength(const unsigned char* header, std::size_t available);
+
+private:
+    MemoryManager<T>* manager;
+    const unsigned char* data;
+    std::vector<std::size_t> frameOffsets;
+    std::vector<std::size_t> elementOffsets;
+};
+
 #include "ptrX_impl.h"
 
 #endif // PTRX_H
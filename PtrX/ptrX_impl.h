@@ -12,10 +12,64 @@
 #include <iomanip>
 #include <bitset>
 #include <vector> 
+#include <atomic>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PTRX_SSE2
+#include <emmintrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PTRX_X86_DISPATCH
+#define PTRX_TARGET(features) __attribute__((target(features)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define PTRX_X86_DISPATCH
+#define PTRX_TARGET(features)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PTRX_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(PTRX_SSE2)
+#define PTRX_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define PTRX_PREFETCH(address) ((void)0)
+#endif
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 template <typename T>
 bool MemoryManager<T>::logging = false;
 
+template <typename T>
+const std::size_t MemoryManager<T>::CompressionHeaderSize;
+
+template <typename T>
+const std::size_t MemoryManager<T>::RotationBufferBytes;
+
+template <typename T>
+const std::size_t MemoryManager<T>::RotationCacheBytes;
+
+template <typename T>
+const std::size_t MemoryManager<T>::SelectionCutoff;
+
+template <typename T>
+const std::size_t MemoryManager<T>::TopKHeapRatio;
+
 /**
  * @brief Constructs a MemoryManager object.
  *
@@ -25,7 +79,25 @@ bool MemoryManager<T>::logging = false;
  * @param log If true, logging is enabled, and a construction message is printed.
  */
 template <typename T>
-inline MemoryManager<T>::MemoryManager(bool log) {
+inline MemoryManager<T>::MemoryManager(bool log) : threadPool(ThreadPool::getDefault()) {
+    if (log) {
+        std::cout << "MemoryManager constructed" << std::endl;
+    }
+}
+
+/**
+ * @brief Constructs a MemoryManager object that runs parallel operations on the given pool.
+ *
+ * @details This constructor behaves like MemoryManager(bool), but parallel operations are scheduled
+ * on the given pool instead of the process-wide default. The pool can be shared by any number of
+ * MemoryManager instances. A null pool falls back to the default one.
+ *
+ * @param log If true, logging is enabled, and a construction message is printed.
+ * @param pool The thread pool to run parallel operations on.
+ */
+template <typename T>
+inline MemoryManager<T>::MemoryManager(bool log, std::shared_ptr<ThreadPool> pool)
+    : threadPool(pool ? pool : ThreadPool::getDefault()) {
     if (log) {
         std::cout << "MemoryManager constructed" << std::endl;
     }
@@ -57,7 +129,7 @@ inline MemoryManager<T>::~MemoryManager() {
  */
 template <typename T>
 inline T* MemoryManager<T>::allocateMemory(int size) {
-    T* ptr = new (std::nothrow) int[size];
+    T* ptr = new (std::nothrow) T[size];
     if (ptr == nullptr) {
 #ifdef DEBUG_MODE
         std::cerr << "Memory allocation failed" << std::endl;
@@ -185,7 +257,7 @@ inline bool MemoryManager<T>::readValue(const T* address, int& value, int size)
 template <typename T>
 inline T* MemoryManager<T>::resizeMemory(T* ptr, int newSize) {
     if (ptr != nullptr && newSize > 0) {
-        T* newPtr = new (std::nothrow) int[newSize];
+        T* newPtr = new (std::nothrow) T[newSize];
         if (newPtr != nullptr) {
             std::memcpy(newPtr, ptr, std::min(sizeof(int) * newSize, sizeof(int) * sizeof(ptr)));
             delete[] ptr;
@@ -513,21 +585,192 @@ inline bool MemoryManager<T>::reverseMemory(T* address, int size) {
 }
 
 /**
- * @brief Shifts the elements in the specified memory range to the right by a given count.
+ * @brief Reduces a signed shift count to an equivalent left shift within a block.
  *
- * @details This function performs a circular shift to the right on the elements in the memory range
- * starting from the specified address. If the address is nullptr or the size is invalid, the function
- * prints an error message and returns false.
+ * @param shiftCount The number of positions to shift to the left. Negative counts shift to the right.
+ * @param length The size of the block, which must be positive.
+ * @return The equivalent left shift, in the range [0, length).
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::normalizeShift(int shiftCount, int length) {
+    long long shift = static_cast<long long>(shiftCount) % length;
+    return static_cast<std::size_t>(shift < 0 ? shift + length : shift);
+}
+
+/**
+ * @brief Rotates a block to the left by the given number of positions.
+ *
+ * @details This is the engine behind all rotation and circular shift operations. The strategy is
+ * picked from the element type, the block size and the shift amount, see the two overloads below.
+ *
+ * @param first A pointer to the start of the block.
+ * @param length The size of the block.
+ * @param shift The number of positions to rotate to the left, in the range [0, length).
+ */
+template <typename T>
+inline void MemoryManager<T>::rotateRange(T* first, std::size_t length, std::size_t shift) {
+    if (shift == 0 || shift >= length) {
+        return;
+    }
+    rotateRange(first, length, shift, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+}
+
+/**
+ * @brief Rotates a block of trivially copyable elements to the left.
+ *
+ * @details When the shorter side of the rotation fits into a RotationBufferBytes stack buffer, it is
+ * parked there, the longer side is moved over with a single memmove and the short side is copied back,
+ * so every element is moved once. Otherwise the block is rotated by block swapping (Gries-Mills): the
+ * shorter side is swapped with the head of the longer one, which puts one side in its final place and
+ * leaves a smaller rotation of the same kind. The swaps run forward through memory in 16-byte words,
+ * and the loop finishes with the buffered copy as soon as the remaining short side fits the buffer.
+ *
+ * @param first A pointer to the start of the block.
+ * @param length The size of the block.
+ * @param shift The number of positions to rotate to the left, in the range (0, length).
+ */
+template <typename T>
+inline void MemoryManager<T>::rotateRange(T* first, std::size_t length, std::size_t shift, std::true_type) {
+    unsigned char buffer[RotationBufferBytes];
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(first);
+    std::size_t left = shift * sizeof(T);
+    std::size_t right = (length - shift) * sizeof(T);
+
+    while (left != 0 && right != 0) {
+        if (left <= right && left <= RotationBufferBytes) {
+            std::memcpy(buffer, bytes, left);
+            std::memmove(bytes, bytes + left, right);
+            std::memcpy(bytes + right, buffer, left);
+            return;
+        }
+        if (right < left && right <= RotationBufferBytes) {
+            std::memcpy(buffer, bytes + left, right);
+            std::memmove(bytes + right, bytes, left);
+            std::memcpy(bytes, buffer, right);
+            return;
+        }
+
+        if (left <= right) {
+            swapBlockBytes(bytes, bytes + left, left);
+            bytes += left;
+            right -= left;
+        }
+        else {
+            swapBlockBytes(bytes, bytes + left, right);
+            bytes += right;
+            left -= right;
+        }
+    }
+}
+
+/**
+ * @brief Rotates a block of non-trivially copyable elements to the left.
+ *
+ * @details Swapping such elements costs three moves, so blocks that fit into RotationCacheBytes are
+ * rotated with the cycle-leader algorithm instead, which walks the gcd(length, shift) permutation
+ * cycles and moves every element exactly once. The strided accesses of the cycles only pay off while
+ * the block stays in cache, so larger blocks are block swapped, which streams through memory.
+ *
+ * @param first A pointer to the start of the block.
+ * @param length The size of the block.
+ * @param shift The number of positions to rotate to the left, in the range (0, length).
+ */
+template <typename T>
+inline void MemoryManager<T>::rotateRange(T* first, std::size_t length, std::size_t shift, std::false_type) {
+    if (length * sizeof(T) <= RotationCacheBytes) {
+        std::size_t cycles = length;
+        for (std::size_t remainder = shift; remainder != 0;) {
+            std::size_t next = cycles % remainder;
+            cycles = remainder;
+            remainder = next;
+        }
+
+        for (std::size_t start = 0; start < cycles; ++start) {
+            T value = std::move(first[start]);
+            std::size_t hole = start;
+            for (;;) {
+                std::size_t source = hole + shift;
+                if (source >= length) {
+                    source -= length;
+                }
+                if (source == start) {
+                    break;
+                }
+                first[hole] = std::move(first[source]);
+                hole = source;
+            }
+            first[hole] = std::move(value);
+        }
+        return;
+    }
+
+    std::size_t left = shift;
+    std::size_t right = length - shift;
+    while (left != 0 && right != 0) {
+        if (left <= right) {
+            std::swap_ranges(first, first + left, first + left);
+            first += left;
+            right -= left;
+        }
+        else {
+            std::swap_ranges(first, first + right, first + left);
+            first += right;
+            left -= right;
+        }
+    }
+}
+
+/**
+ * @brief Swaps the contents of two non-overlapping byte ranges.
+ *
+ * @param block1 A pointer to the first range.
+ * @param block2 A pointer to the second range.
+ * @param length The number of bytes to swap.
+ */
+template <typename T>
+inline void MemoryManager<T>::swapBlockBytes(unsigned char* block1, unsigned char* block2, std::size_t length) {
+    std::size_t i = 0;
+#ifdef PTRX_SSE2
+    for (; i + 32 <= length; i += 32) {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block1 + i));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block1 + i + 16));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block2 + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block2 + i + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block1 + i), b0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block1 + i + 16), b1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block2 + i), a0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block2 + i + 16), a1);
+    }
+#endif
+    for (; i + sizeof(std::uint64_t) <= length; i += sizeof(std::uint64_t)) {
+        std::uint64_t a, b;
+        std::memcpy(&a, block1 + i, sizeof(a));
+        std::memcpy(&b, block2 + i, sizeof(b));
+        std::memcpy(block1 + i, &b, sizeof(b));
+        std::memcpy(block2 + i, &a, sizeof(a));
+    }
+    for (; i < length; ++i) {
+        std::swap(block1[i], block2[i]);
+    }
+}
+
+/**
+ * @brief Shifts the elements in the specified memory range circularly by a given count.
+ *
+ * @details This function performs a circular shift on the elements in the memory range starting from
+ * the specified address, so that the element at index shiftCount ends up first. Negative counts shift
+ * the other way, and counts beyond the size wrap around. If the address is nullptr or the size is
+ * invalid, the function prints an error message and returns false.
  *
  * @param address A pointer to the start of the memory range.
  * @param size The size of the memory range.
- * @param shiftCount The number of positions to shift the elements to the right.
+ * @param shiftCount The number of positions to shift the elements to the left.
  * @return true if the memory is successfully shifted, false otherwise.
  */
 template <typename T>
 inline bool MemoryManager<T>::shiftMemory(T* address, int size, int shiftCount) {
     if (address != nullptr && size > 0) {
-        std::rotate(address, address + shiftCount, address + size);
+        rotateRange(address, size, normalizeShift(shiftCount, size));
         return true;
     }
     else {
@@ -651,8 +894,9 @@ inline bool MemoryManager<T>::compareMemoryWithOffset(const T* address1, const T
 template <typename T>
 inline const T* MemoryManager<T>::findValueFromEnd(const T* address, int value, int size) {
     if (address != nullptr && size > 0) {
-        auto it = std::find(std::make_reverse_iterator(address + size), std::make_reverse_iterator(address), value);
-        if (it != std::make_reverse_iterator(address)) {
+        std::reverse_iterator<const T*> first(address + size), last(address);
+        auto it = std::find(first, last, value);
+        if (it != last) {
             return &(*it);
         }
         else {
@@ -673,9 +917,10 @@ inline const T* MemoryManager<T>::findValueFromEnd(const T* address, int value,
 /**
  * @brief Initializes the specified memory range with random values.
  *
- * @details This function fills the memory range starting from the specified address with random values.
- * If the address is not nullptr and the size is valid, the function uses a random number generator to
- * generate random values for each element in the range.
+ * @details This function fills the memory range starting from the specified address with random values
+ * between 0 and the largest int. If the address is not nullptr and the size is valid, the values are drawn
+ * from RandomEngine::threadLocal(), which is seeded from std::random_device once per thread rather than
+ * on every call. Use the overloads taking a RandomEngine or a seed for reproducible contents.
  *
  * @param address A pointer to the start of the memory range.
  * @param size The size of the memory range.
@@ -683,13 +928,7 @@ inline const T* MemoryManager<T>::findValueFromEnd(const T* address, int value,
 template <typename T>
 inline void MemoryManager<T>::initializeMemoryWithRandomValues(T* address, int size) {
     if (address != nullptr && size > 0) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<int> distribution(0, std::numeric_limits<int>::max());
-
-        for (int i = 0; i < size; ++i) {
-            address[i] = distribution(gen);
-        }
+        initializeMemoryWithRandomValues(address, size, RandomEngine::threadLocal());
     }
     else {
 #ifdef DEBUG_MODE
@@ -729,8 +968,10 @@ inline bool MemoryManager<T>::swapMemoryWithOffset(T* address1, T* address2, int
  * @brief Shuffles the elements of the specified memory range.
  *
  * @details This function shuffles the elements of the memory range starting from the specified address.
- * If the address is not nullptr and the size is valid, the function uses a random number generator to
- * perform the shuffle.
+ * If the address is not nullptr and the size is valid, the function draws a seed from
+ * RandomEngine::threadLocal() and runs the cache-aware bucket shuffle sequentially, which avoids a random
+ * memory access per element on buffers larger than the cache. Use the overloads taking a RandomEngine or a
+ * seed for a reproducible order.
  *
  * @param address A pointer to the start of the memory range.
  * @param size The size of the memory range.
@@ -738,9 +979,7 @@ inline bool MemoryManager<T>::swapMemoryWithOffset(T* address1, T* address2, int
 template <typename T>
 inline void MemoryManager<T>::shuffleMemory(T* address, int size) {
     if (address != nullptr && size > 0) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::shuffle(address, address + size, gen);
+        shuffleMemory(address, size, RandomEngine::threadLocal()(), ExecutionPolicy::sequential());
     }
     else {
 #ifdef DEBUG_MODE
@@ -749,6 +988,97 @@ inline void MemoryManager<T>::shuffleMemory(T* address, int size) {
     }
 }
 
+/**
+ * @brief Fills a memory range with random values drawn from a generator.
+ *
+ * @details Each 64-bit output of the engine supplies two values between 0 and the largest int, so a given
+ * engine state always produces the same contents. If the inputs are invalid, the function prints an error
+ * message and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param engine The generator to draw from; its state advances.
+ * @return True if the range was filled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::initializeMemoryWithRandomValues(T* address, int size, RandomEngine& engine) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid initializeMemoryWithRandomValues operation." << std::endl;
+#endif
+        return false;
+    }
+
+    int i = 0;
+    for (; i + 1 < size; i += 2) {
+        std::uint64_t bits = engine();
+        address[i] = static_cast<T>(static_cast<int>(bits >> 33));
+        address[i + 1] = static_cast<T>(static_cast<int>(bits & 0x7FFFFFFF));
+    }
+    if (i < size) {
+        address[i] = static_cast<T>(static_cast<int>(engine() >> 33));
+    }
+    return true;
+}
+
+/**
+ * @brief Fills a memory range with random values uniformly distributed over a closed interval.
+ *
+ * @details Values are drawn with RandomEngine::nextInRange, which rejects the few raw outputs that would make
+ * some values more likely than others, so there is no modulo bias. If the inputs are invalid or low is greater
+ * than high, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param low The smallest value that can be generated.
+ * @param high The largest value that can be generated.
+ * @param engine The generator to draw from; its state advances.
+ * @return True if the range was filled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::initializeMemoryWithRandomValues(T* address, int size, int low, int high, RandomEngine& engine) {
+    if (address == nullptr || size <= 0 || low > high) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid initializeMemoryWithRandomValues operation." << std::endl;
+#endif
+        return false;
+    }
+
+    for (int i = 0; i < size; ++i) {
+        address[i] = static_cast<T>(engine.nextInRange(low, high));
+    }
+    return true;
+}
+
+/**
+ * @brief Shuffles a memory range with a Fisher-Yates shuffle driven by a generator.
+ *
+ * @details Unlike std::shuffle, whose use of the generator differs between standard libraries, the order
+ * produced here depends only on the engine state. Every permutation is equally likely because each swap
+ * index comes from RandomEngine::nextBounded. If the inputs are invalid, the function prints an error message
+ * and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param engine The generator to draw from; its state advances.
+ * @return True if the range was shuffled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::shuffleMemory(T* address, int size, RandomEngine& engine) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid shuffleMemory operation." << std::endl;
+#endif
+        return false;
+    }
+
+    for (int i = size - 1; i > 0; --i) {
+        std::uint32_t j = engine.nextBounded(static_cast<std::uint32_t>(i) + 1);
+        std::swap(address[i], address[j]);
+    }
+    return true;
+}
+
 /**
  * @brief Reverses a portion of memory with an offset.
  *
@@ -793,7 +1123,7 @@ inline bool MemoryManager<T>::reverseMemoryWithOffset(T* address, int size, int
 template <typename T>
 inline T* MemoryManager<T>::resizeAndInitializeMemory(T* ptr, int oldSize, int newSize, int initValue) {
     if (ptr != nullptr && oldSize > 0 && newSize > 0) {
-        T* newPtr = new (std::nothrow) int[newSize];
+        T* newPtr = new (std::nothrow) T[newSize];
         if (newPtr != nullptr) {
             std::copy(ptr, ptr + std::min(oldSize, newSize), newPtr);
             std::fill(newPtr + oldSize, newPtr + newSize, initValue);
@@ -829,7 +1159,7 @@ inline T* MemoryManager<T>::resizeAndInitializeMemory(T* ptr, int oldSize, int n
 template <typename T>
 inline void MemoryManager<T>::shiftMemoryCircular(T* address, int size, int shiftCount) {
     if (address != nullptr && size > 0) {
-        std::rotate(address, address + (shiftCount % size + size) % size, address + size);
+        rotateRange(address, size, normalizeShift(shiftCount, size));
     }
     else {
 #ifdef DEBUG_MODE
@@ -843,8 +1173,8 @@ inline void MemoryManager<T>::shiftMemoryCircular(T* address, int size, int shif
  *
  * @details This function deduplicates the elements of the memory range starting from the specified address.
  * If the address is not nullptr and the size is valid, the function performs deduplication by sorting the
- * elements and removing duplicates. It fills the remaining space with zeros. If any condition is not met,
- * it prints an error message.
+ * elements with sortMemory and removing duplicates. It fills the remaining space with zeros. If any condition
+ * is not met, it prints an error message.
  *
  * @param address A pointer to the start of the memory range.
  * @param size The size of the memory range.
@@ -852,7 +1182,7 @@ inline void MemoryManager<T>::shiftMemoryCircular(T* address, int size, int shif
 template <typename T>
 inline void MemoryManager<T>::deduplicateMemory(T* address, int size) {
     if (address != nullptr && size > 0) {
-        std::sort(address, address + size);
+        sortMemory(address, size);
         auto last = std::unique(address, address + size);
         std::fill(last, address + size, 0);
     }
@@ -908,7 +1238,7 @@ template <typename T>
 inline void MemoryManager<T>::fillMemoryWithIncrementingValues(T* address, int size, int startValue, int increment) {
     if (address != nullptr && size > 0) {
         for (int i = 0; i < size; ++i) {
-            address[i] = startValue + i * increment;
+            address[i] = static_cast<T>(startValue + i * increment);
         }
     }
     else {
@@ -946,33 +1276,6 @@ inline void MemoryManager<T>::interleaveMemory(T* destAddress, const T* block1,
 }
 
 
-/**
- * @brief Interleaves elements from two source memories into a destination memory.
- *
- * @details This function interleaves elements from two source memories into a destination memory. Each element
- * from the first source memory is placed at even indices, and each element from the second source memory is placed
- * at odd indices in the destination memory. If the source1, source2, and destination pointers are not nullptr
- * and the size is valid, the function performs the interleaving. Otherwise, it prints an error message.
- *
- * @param source1 A pointer to the first source memory.
- * @param source2 A pointer to the second source memory.
- * @param destination A pointer to the destination memory.
- * @param size The size of the memory range.
- */
-template <typename T>
-inline void MemoryManager<T>::fillMemoryWithIncrementingValues(T* address, int size, int startValue, int increment) {
-    if (address != nullptr && size > 0) {
-        for (int i = 0; i < size; ++i) {
-            address[i] = static_cast<T>(startValue + i * increment);
-        }
-    }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid fillMemoryWithIncrementingValues operation." << std::endl;
-#endif
-    }
-}
-
 /**
  * @brief Performs bitwise XOR on elements from two source memories into a destination memory.
  *
@@ -1126,12 +1429,9 @@ inline void MemoryManager<T>::printMemoryStatistics(const T* address, int size)
 }
 
 /**
- * @brief Compresses a memory block by removing consecutive duplicate elements.
+ * @brief Compresses a memory block with run-length encoding.
  *
- * @details This function compresses a memory block by removing consecutive duplicate elements.
- * If the source, size, and compressedSize parameters are valid, the function returns a pointer to
- * the compressed memory block along with the size of the compressed block. Otherwise, it prints
- * an error message and returns nullptr.
+ * @details This is compressMemory with CompressionFormat::RunLength.
  *
  * @param source A pointer to the start of the memory block.
  * @param size The size of the memory block.
@@ -1140,43 +1440,17 @@ inline void MemoryManager<T>::printMemoryStatistics(const T* address, int size)
  */
 template <typename T>
 inline T* MemoryManager<T>::compressMemory(const T* source, int size, int& compressedSize) {
-    if (!source || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid compressMemory operation." << std::endl;
-#endif
-        return nullptr;
-    }
-
-    std::vector<T> compressedData;
-
-    for (int i = 0; i < size; ++i) {
-        if (i == 0 || source[i] != source[i - 1]) {
-            compressedData.push_back(source[i]);
-        }
-    }
-
-    compressedSize = compressedData.size();
-    T* compressedPtr = new (std::nothrow) T[compressedSize];
-
-    if (compressedPtr) {
-        std::copy(compressedData.begin(), compressedData.end(), compressedPtr);
-        return compressedPtr;
-    }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Memory allocation for compressed data failed." << std::endl;
-#endif
-        return nullptr;
-    }
+    return compressMemory(source, size, compressedSize, CompressionFormat::RunLength);
 }
 
 
 /**
- * @brief Decompresses a memory block by expanding consecutive elements based on counts.
+ * @brief Decompresses a memory block produced by compressMemory.
  *
- * @details This function decompresses a memory block by expanding consecutive elements based on counts.
- * If the compressedData, compressedSize, and originalSize parameters are valid, the function returns a pointer
- * to the decompressed memory block. Otherwise, it prints an error message and returns nullptr.
+ * @details The format is read from the header, so blocks written with any CompressionFormat are accepted.
+ * The header is checked before anything is written: the magic bytes, version, element size and element count
+ * must match, and originalSize must equal the stored count. If the inputs are invalid or the data is corrupt,
+ * the function prints an error message and returns nullptr.
  *
  * @param compressedData A pointer to the start of the compressed memory block.
  * @param compressedSize The size of the compressed memory block.
@@ -1192,1006 +1466,10210 @@ inline T* MemoryManager<T>::decompressMemory(const T* compressedData, int compre
         return nullptr;
     }
 
-    T* decompressedPtr = new (std::nothrow) T[originalSize];
-    if (!decompressedPtr) {
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(compressedData);
+    std::size_t length = static_cast<std::size_t>(compressedSize) * sizeof(T);
+    unsigned char format = 0;
+    std::uint32_t count = 0, payloadBytes = 0;
+    if (!readCompressionHeader(input, length, format, count, payloadBytes) || count != static_cast<std::uint32_t>(originalSize)) {
 #ifdef DEBUG_MODE
-        std::cerr << "Memory allocation for decompressed data failed." << std::endl;
+        std::cerr << "Invalid decompressMemory operation: Unrecognized compressed data." << std::endl;
 #endif
         return nullptr;
     }
 
-    int currentIndex = 0;
-    int count = 1;
-
-    for (int i = 0; i < compressedSize && count < originalSize; ++i) {
-        decompressedPtr[currentIndex++] = compressedData[i];
-
-        while (i < compressedSize - 1 && compressedData[i] == compressedData[i + 1] && count < originalSize) {
-            decompressedPtr[currentIndex++] = compressedData[i];
-            ++count;
-            ++i;
-        }
+    T* decompressedPtr = allocateMemory(originalSize);
+    if (!decompressedPtr) {
+        return nullptr;
+    }
 
-        count = 1;
+    bool decoded = decodeFrame(input, length, decompressedPtr, count);
+    if (!decoded) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid decompressMemory operation: Corrupt compressed data." << std::endl;
+#endif
+        deallocateMemory(decompressedPtr);
+        return nullptr;
     }
 
     return decompressedPtr;
 }
 
 /**
- * @brief Encrypts a memory block using XOR with a key.
+ * @brief Compresses a memory block with a chosen format.
  *
- * @details This function encrypts a memory block using XOR with a key.
- * If the address, size, and key parameters are valid, the function performs the encryption.
- * Otherwise, it prints an error message.
+ * @details The output starts with a 14-byte header: the magic bytes "PXC", a format version, the format, the
+ * element size, and the element count and payload length as little-endian 32-bit integers. The payload depends
+ * on the format:
+ * - RunLength stores every run of equal elements as the element's bytes followed by the run length as a LEB128
+ *   varint. Runs are detected 4 elements at a time with SSE2 for 32-bit elements.
+ * - DeltaBitPacked stores a DeltaCodec stream, for sorted or slowly changing 32- and 64-bit integers.
+ * - Lz stores an LzCodec stream of the block's bytes, for general data with repeated byte sequences.
  *
- * @param address A pointer to the start of the memory block.
+ * The bytes are returned packed in a block of T, and compressedSize is set to the number of T elements of that
+ * block. If the inputs are invalid or the format does not support T, the function prints an error message,
+ * sets compressedSize to 0 and returns nullptr.
+ *
+ * @param source A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param key The encryption key as a string.
+ * @param compressedSize A reference to an integer that will be set to the size of the compressed block.
+ * @param format The compression format to use.
+ * @return A pointer to the compressed memory block if successful, nullptr otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::encryptMemory(T* address, int size, const std::string& key) {
-    if (address != nullptr && size > 0 && !key.empty()) {
-        std::vector<int> xorValues;
-        for (char c : key) {
-            xorValues.push_back(static_cast<int>(c) - '0');
-        }
-
-        for (int i = 0; i < size; ++i) {
-            address[i] ^= xorValues[i % key.size()];
-        }
+inline T* MemoryManager<T>::compressMemory(const T* source, int size, int& compressedSize, CompressionFormat format) {
+    compressedSize = 0;
+    std::uint64_t byteCount = static_cast<std::uint64_t>(std::max(size, 0)) * sizeof(T);
+    if (!source || size <= 0 || byteCount > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid compressMemory operation." << std::endl;
+#endif
+        return nullptr;
     }
-    else {
+
+    std::vector<unsigned char> frame;
+    if (!encodeFrame(source, static_cast<std::size_t>(size), format, frame)) {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid encryptMemory operation." << std::endl;
+        std::cerr << "Invalid compressMemory operation: Unsupported format." << std::endl;
 #endif
+        return nullptr;
     }
+
+    return packCompressedBytes(frame.data(), frame.size(), compressedSize);
 }
 
 /**
- * @brief Decrypts a memory block that was encrypted using XOR with a key.
+ * @brief Decompresses a memory block written with a given format.
  *
- * @details This function decrypts a memory block that was encrypted using XOR with a key.
- * If the address, size, and key parameters are valid, the function performs the decryption.
- * Otherwise, it prints an error message.
+ * @details This overload behaves like decompressMemory, but first checks that the block was written with the
+ * expected format. If it was not, the function prints an error message and returns nullptr.
  *
- * @param address A pointer to the start of the memory block.
- * @param size The size of the memory block.
- * @param key The encryption key as a string.
+ * @param compressedData A pointer to the start of the compressed memory block.
+ * @param compressedSize The size of the compressed memory block.
+ * @param originalSize The size of the original (uncompressed) memory block.
+ * @param format The compression format the block must have been written with.
+ * @return A pointer to the decompressed memory block if successful, nullptr otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::decryptMemory(T* address, int size, const std::string& key) {
-    if (address != nullptr && size > 0 && !key.empty()) {
-        std::vector<int> xorValues;
-        for (char c : key) {
-            xorValues.push_back(static_cast<int>(c) - '0');
-        }
-
-        for (int i = 0; i < size; ++i) {
-            address[i] ^= static_cast<int>(key[i % key.size()]) - '0';
-        }
-    }
-    else {
+inline T* MemoryManager<T>::decompressMemory(const T* compressedData, int compressedSize, int originalSize, CompressionFormat format) {
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(compressedData);
+    if (!compressedData || compressedSize <= 0
+        || static_cast<std::size_t>(compressedSize) * sizeof(T) < CompressionHeaderSize
+        || input[4] != static_cast<unsigned char>(format)) {
 #ifdef DEBUG_MODE
-                std::cerr << "Invalid decryptMemory operation." << std::endl;
+        std::cerr << "Invalid decompressMemory operation: Format mismatch." << std::endl;
 #endif
+        return nullptr;
     }
+
+    return decompressMemory(compressedData, compressedSize, originalSize);
 }
 
 /**
- * @brief Reverses a portion of a memory block within a specified range.
+ * @brief Finds the first occurrence of a value in a compressed memory block without decompressing it.
  *
- * @details This function reverses a portion of a memory block within a specified range.
- * If the address, start, and end parameters are valid, the function performs the reversal.
- * Otherwise, it prints an error message.
+ * @details Runs are compared as a whole, and DeltaBitPacked blocks whose minimum and maximum exclude the value
+ * are skipped without being unpacked. Lz data has no such structure and is decompressed into a temporary
+ * buffer first. If the inputs are invalid or the data is corrupt, the function prints an error message and
+ * returns -1.
  *
- * @param address A pointer to the start of the memory block.
- * @param start The starting index of the range to reverse.
- * @param end The ending index of the range to reverse.
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param value The value to search for.
+ * @return The index of the first occurrence in the original block, or -1 if the value is not found.
  */
 template <typename T>
-inline void MemoryManager<T>::reverseMemoryInRange(T* address, int start, int end) {
-    if (address != nullptr && start >= 0 && end < size && start < end) {
-        std::reverse(address + start, address + end + 1);
-    }
-    else {
+inline int MemoryManager<T>::findValueCompressed(const T* compressedData, int compressedSize, int value) {
+    int index = -1;
+    bool scanned = scanCompressed(compressedData, compressedSize,
+        [value](T minimum, T maximum) {
+            return value < minimum || value > maximum;
+        },
+        [value, &index](std::size_t position, std::size_t length, const T* values, bool constant) {
+            if (constant) {
+                index = static_cast<int>(position);
+                return false;
+            }
+            const T* match = std::find(values, values + length, value);
+            if (match != values + length) {
+                index = static_cast<int>(position + (match - values));
+                return false;
+            }
+            return true;
+        });
+
+    if (!scanned) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid reverseMemoryInRange operation." << std::endl;
+        std::cerr << "Invalid findValueCompressed operation." << std::endl;
 #endif
+        return -1;
     }
+    return index;
 }
 
 /**
- * @brief Rotates a memory block to the left by a specified number of positions.
+ * @brief Counts the occurrences of a value in a compressed memory block without decompressing it.
  *
- * @details This function rotates a memory block to the left by a specified number of positions.
- * If the address and size parameters are valid, the function performs the rotation.
- * Otherwise, it prints an error message.
+ * @details A matching run adds its length without looking at its elements, and blocks are skipped as in
+ * findValueCompressed. If the inputs are invalid or the data is corrupt, the function prints an error message
+ * and returns -1.
  *
- * @param address A pointer to the start of the memory block.
- * @param size The size of the memory block.
- * @param shiftCount The number of positions to rotate the memory block to the left.
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param value The value to count.
+ * @return The number of occurrences, or -1 on error.
  */
 template <typename T>
-inline void MemoryManager<T>::rotateMemoryLeft(T* address, int size, int shiftCount) {
-    if (address != nullptr && size > 0) {
-        std::rotate(address, address + shiftCount % size, address + size);
-    }
-    else {
+inline int MemoryManager<T>::countValueCompressed(const T* compressedData, int compressedSize, int value) {
+    std::size_t count = 0;
+    bool scanned = scanCompressed(compressedData, compressedSize,
+        [value](T minimum, T maximum) {
+            return value < minimum || value > maximum;
+        },
+        [value, &count](std::size_t, std::size_t length, const T* values, bool constant) {
+            count += constant ? length : static_cast<std::size_t>(std::count(values, values + length, value));
+            return true;
+        });
+
+    if (!scanned) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid rotateMemoryLeft operation." << std::endl;
+        std::cerr << "Invalid countValueCompressed operation." << std::endl;
 #endif
+        return -1;
     }
+    return static_cast<int>(count);
 }
 
 /**
- * @brief Rotates a memory block to the right by a specified number of positions.
+ * @brief Sums the elements of a compressed memory block without decompressing it.
  *
- * @details This function rotates a memory block to the right by a specified number of positions.
- * If the address and size parameters are valid, the function performs the rotation.
- * Otherwise, it prints an error message.
+ * @details A run contributes its value times its length. Unlike calculateChecksum the sum is kept in 64 bits, so
+ * it does not wrap for blocks of int. If the sum, or a run's product, does not fit in a long long, the function
+ * stops and returns false rather than wrapping. If the inputs are invalid or the data is corrupt, the function
+ * prints an error message and returns false.
  *
- * @param address A pointer to the start of the memory block.
- * @param size The size of the memory block.
- * @param shiftCount The number of positions to rotate the memory block to the right.
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param sum Reference receiving the sum of the elements.
+ * @return True if the sum was computed, false otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::rotateMemoryRight(T* address, int size, int shiftCount) {
-    if (address != nullptr && size > 0) {
-        shiftCount = (shiftCount % size + size) % size; // Ensure shiftCount is non-negative
-        std::rotate(address, address + size - shiftCount, address + size);
-    }
-    else {
+inline bool MemoryManager<T>::sumCompressed(const T* compressedData, int compressedSize, long long& sum) {
+    long long total = 0;
+    bool overflow = false;
+    auto add = [&total, &overflow](long long value) {
+        if ((value > 0 && total > std::numeric_limits<long long>::max() - value)
+            || (value < 0 && total < std::numeric_limits<long long>::min() - value)) {
+            overflow = true;
+            return false;
+        }
+        total += value;
+        return true;
+    };
+
+    bool scanned = scanCompressed(compressedData, compressedSize,
+        [](T, T) {
+            return false;
+        },
+        [&add, &overflow](std::size_t, std::size_t length, const T* values, bool constant) {
+            // Unsigned values above the long long range come out negative and count as an overflow too.
+            if (constant) {
+                long long value = static_cast<long long>(values[0]);
+                long long runLength = static_cast<long long>(length);
+                if ((!std::is_signed<T>::value && value < 0) || value > std::numeric_limits<long long>::max() / runLength
+                    || value < std::numeric_limits<long long>::min() / runLength) {
+                    overflow = true;
+                    return false;
+                }
+                return add(value * runLength);
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                long long value = static_cast<long long>(values[i]);
+                if (!std::is_signed<T>::value && value < 0) {
+                    overflow = true;
+                    return false;
+                }
+                if (!add(value)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+
+    if (!scanned || overflow) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid rotateMemoryRight operation." << std::endl;
+        std::cerr << "Invalid sumCompressed operation." << std::endl;
 #endif
+        return false;
     }
+    sum = total;
+    return true;
 }
 
 /**
- * @brief Removes consecutive duplicate values from a sorted memory block.
+ * @brief Finds the smallest and largest elements of a compressed memory block without decompressing it.
  *
- * @details This function removes consecutive duplicate values from a sorted memory block.
- * If the address and size parameters are valid, the function performs the removal.
- * The size parameter is updated to reflect the new size of the memory block.
- * Otherwise, it prints an error message.
+ * @details Run values and the stored DeltaBitPacked block bounds are enough, so no block is ever unpacked;
+ * only Lz data is decompressed. If the inputs are invalid or the data is corrupt, the function prints an error
+ * message and returns false.
  *
- * @param address A pointer to the start of the sorted memory block.
- * @param size The size of the memory block.
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param minimum Reference receiving the smallest element.
+ * @param maximum Reference receiving the largest element.
+ * @return True if the bounds were found, false otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::uniqueMemory(T* address, int& size) {
-    if (address != nullptr && size > 0) {
-        auto newEnd = std::unique(address, address + size);
-        size = std::distance(address, newEnd);
+inline bool MemoryManager<T>::minMaxCompressed(const T* compressedData, int compressedSize, T& minimum, T& maximum) {
+    bool found = false;
+    T lowest = T();
+    T highest = T();
+    auto include = [&found, &lowest, &highest](T low, T high) {
+        lowest = found ? std::min(lowest, low) : low;
+        highest = found ? std::max(highest, high) : high;
+        found = true;
+    };
+
+    bool scanned = scanCompressed(compressedData, compressedSize,
+        [&include](T low, T high) {
+            include(low, high);
+            return true;
+        },
+        [&include](std::size_t, std::size_t length, const T* values, bool) {
+            auto bounds = std::minmax_element(values, values + length);
+            include(*bounds.first, *bounds.second);
+            return true;
+        });
+
+    if (!scanned || !found) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid minMaxCompressed operation." << std::endl;
+#endif
+        return false;
     }
-    else {
+    minimum = lowest;
+    maximum = highest;
+    return true;
+}
+
+/**
+ * @brief Finds the positions of the elements within a range in a compressed memory block without decompressing it.
+ *
+ * @details Runs and blocks whose bounds fall outside [low, high] are skipped. Pass nullptr for positions to only
+ * count the matches. If the inputs are invalid or the data is corrupt, the function prints an error message and
+ * returns -1.
+ *
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param low The smallest value to match.
+ * @param high The largest value to match.
+ * @param positions A pointer to room for the matching positions in ascending order, or nullptr.
+ * @return The number of elements within the range, or -1 on error.
+ */
+template <typename T>
+inline int MemoryManager<T>::filterRangeCompressed(const T* compressedData, int compressedSize, int low, int high, int* positions) {
+    std::size_t count = 0;
+    bool scanned = low <= high && scanCompressed(compressedData, compressedSize,
+        [low, high](T minimum, T maximum) {
+            return maximum < low || minimum > high;
+        },
+        [low, high, positions, &count](std::size_t position, std::size_t length, const T* values, bool constant) {
+            if (constant) {
+                if (positions != nullptr) {
+                    for (std::size_t i = 0; i < length; ++i) {
+                        positions[count + i] = static_cast<int>(position + i);
+                    }
+                }
+                count += length;
+                return true;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                if (values[i] >= low && values[i] <= high) {
+                    if (positions != nullptr) {
+                        positions[count] = static_cast<int>(position + i);
+                    }
+                    ++count;
+                }
+            }
+            return true;
+        });
+
+    if (!scanned) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid uniqueMemory operation." << std::endl;
+        std::cerr << "Invalid filterRangeCompressed operation." << std::endl;
 #endif
+        return -1;
     }
+    return static_cast<int>(count);
 }
 
 /**
- * @brief Removes all occurrences of a specified value from a memory block.
+ * @brief Prints the minimum, maximum and average of a compressed memory block without decompressing it.
  *
- * @details This function removes all occurrences of a specified value from a memory block.
- * If the address and size parameters are valid, the function performs the removal.
- * The size parameter is updated to reflect the new size of the memory block.
- * Otherwise, it prints an error message.
+ * @details This reports the same statistics as printMemoryStatistics for the original block, using
+ * minMaxCompressed and sumCompressed.
  *
- * @param address A pointer to the start of the memory block.
- * @param size The size of the memory block.
- * @param value The value to be removed from the memory block.
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
  */
 template <typename T>
-inline void MemoryManager<T>::removeValue(T* address, int& size, int value) {
-    if (address != nullptr && size > 0) {
-        auto newEnd = std::remove(address, address + size, value);
-        size = std::distance(address, newEnd);
-    }
-    else {
+inline void MemoryManager<T>::printMemoryStatisticsCompressed(const T* compressedData, int compressedSize) {
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(compressedData);
+    unsigned char format = 0;
+    std::uint32_t count = 0, payloadBytes = 0;
+    T minValue = T();
+    T maxValue = T();
+    long long sum = 0;
+    if (compressedData == nullptr || compressedSize <= 0
+        || !readCompressionHeader(input, static_cast<std::size_t>(compressedSize) * sizeof(T), format, count, payloadBytes)
+        || !minMaxCompressed(compressedData, compressedSize, minValue, maxValue)
+        || !sumCompressed(compressedData, compressedSize, sum)) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid removeValue operation." << std::endl;
+        std::cerr << "Invalid printMemoryStatisticsCompressed operation." << std::endl;
 #endif
+        return;
     }
+
+    double averageValue = static_cast<double>(sum) / count;
+    std::cout << "Memory Statistics:" << std::endl;
+    std::cout << "  Minimum Value: " << minValue << std::endl;
+    std::cout << "  Maximum Value: " << maxValue << std::endl;
+    std::cout << "  Average Value: " << std::fixed << std::setprecision(2) << averageValue << std::endl;
 }
 
+
 /**
- * @brief Removes all occurrences of a specified value from a memory block.
+ * @brief Encrypts a memory block in place with ChaCha20 under a 32-byte string key and a 12-byte string nonce.
  *
- * @details This function removes all occurrences of a specified value from a memory block.
- * If the address and size parameters are valid, the function performs the removal.
- * The size parameter is updated to reflect the new size of the memory block.
- * Otherwise, it prints an error message.
+ * @details The bytes of the key and nonce are used as the ChaCha20 key and nonce as they are, and the block
+ * counter starts at 0. A key and nonce pair must never be used for two different buffers: XORing the two
+ * ciphertexts would cancel the keystream. If the address is nullptr, the size is invalid, or the key or nonce
+ * has the wrong length, the function prints an error message and returns false without changing the block.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param value The value to be removed from the memory block.
+ * @param key The 32-byte encryption key.
+ * @param nonce The 12-byte nonce, unique for every buffer encrypted under the key.
+ * @return True if the block was encrypted, false otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::removeAllOccurrences(T* address, int& size, int value) {
-    if (address != nullptr && size > 0) {
-        auto newEnd = std::remove(address, address + size, value);
-        size = std::distance(address, newEnd);
-    }
-    else {
+inline bool MemoryManager<T>::encryptMemory(T* address, int size, const std::string& key, const std::string& nonce) {
+    if (key.size() != static_cast<std::size_t>(ChaCha20::KeySize) || nonce.size() != static_cast<std::size_t>(ChaCha20::NonceSize)) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid removeAllOccurrences operation." << std::endl;
+        std::cerr << "Invalid encryptMemory operation: The key must be 32 bytes and the nonce 12 bytes." << std::endl;
 #endif
+        return false;
     }
+
+    return encryptMemory(address, size, reinterpret_cast<const unsigned char*>(key.data()),
+        reinterpret_cast<const unsigned char*>(nonce.data()), 0);
 }
 
 /**
- * @brief Resizes a memory block and initializes the new elements with a default value.
+ * @brief Decrypts a memory block encrypted by encryptMemory with a string key and nonce.
  *
- * @details This function resizes a memory block and initializes the new elements with a default value.
- * If the address parameter is valid and newSize is greater than the current size,
- * the function resizes the memory block, filling the new elements with the specified defaultValue.
- * If newSize is less than or equal to the current size, the size parameter is updated to newSize.
- * Otherwise, it prints an error message.
+ * @details ChaCha20 is a stream cipher, so decryption applies the same keystream again; the key and nonce must
+ * match the ones used to encrypt. If the address is nullptr, the size is invalid, or the key or nonce has the
+ * wrong length, the function prints an error message and returns false without changing the block.
  *
  * @param address A pointer to the start of the memory block.
- * @param size The current size of the memory block.
- * @param newSize The desired size of the memory block after resizing.
- * @param defaultValue The value used to initialize new elements (if any).
+ * @param size The size of the memory block.
+ * @param key The 32-byte encryption key.
+ * @param nonce The 12-byte nonce the block was encrypted with.
+ * @return True if the block was decrypted, false otherwise.
  */
 template <typename T>
-inline void MemoryManager<T>::resizeMemoryWithDefaultValue(T* address, int& size, int newSize, int defaultValue) {
-    if (address != nullptr && newSize > 0) {
-        if (newSize > size) {
-            address = resizeMemory(address, newSize);
-            std::fill(address + size, address + newSize, defaultValue);
-        }
-        else {
-            size = newSize;
-        }
-    }
-    else {
+inline bool MemoryManager<T>::decryptMemory(T* address, int size, const std::string& key, const std::string& nonce) {
+    if (key.size() != static_cast<std::size_t>(ChaCha20::KeySize) || nonce.size() != static_cast<std::size_t>(ChaCha20::NonceSize)) {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid resizeMemoryWithDefaultValue operation." << std::endl;
+        std::cerr << "Invalid decryptMemory operation: The key must be 32 bytes and the nonce 12 bytes." << std::endl;
 #endif
+        return false;
     }
+
+    return decryptMemory(address, size, reinterpret_cast<const unsigned char*>(key.data()),
+        reinterpret_cast<const unsigned char*>(nonce.data()), 0);
 }
 
 /**
- * @brief Checks if a memory block is null.
+ * @brief Encrypts a memory block in place with ChaCha20 (RFC 8439).
  *
- * @details This function checks if a memory block is null.
+ * @details The bytes of the block are XORed with the keystream for the key and nonce, starting at the given
+ * block counter; each 64-byte block of keystream uses the next counter value. A key and nonce pair must never
+ * be used for two different buffers, or for overlapping counter ranges of one. The keystream is generated 16,
+ * 8 or 4 blocks at a time with AVX-512, AVX2 or SSE2, whichever the processor supports. If the inputs are
+ * invalid or the block would run the 32-bit counter past its end, the function prints an error message and
+ * returns false without changing the block.
  *
  * @param address A pointer to the start of the memory block.
- * @return True if the memory block is null, false otherwise.
+ * @param size The size of the memory block.
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter of the first 64 bytes.
+ * @return True if the block was encrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryNull(const T* address) {
-    return (address == nullptr);
+inline bool MemoryManager<T>::encryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter) {
+    return encryptMemory(address, size, key, nonce, counter, ExecutionPolicy::sequential());
 }
 
 /**
- * @brief Checks if a memory block is allocated.
+ * @brief Decrypts a memory block encrypted with ChaCha20 (RFC 8439).
  *
- * @details This function checks if a memory block is allocated.
+ * @details Decryption applies the same keystream as encryption, so the key, nonce and counter must match the
+ * ones used to encrypt. If the inputs are invalid, the function prints an error message and returns false
+ * without changing the block.
  *
  * @param address A pointer to the start of the memory block.
- * @return True if the memory block is allocated, false otherwise.
+ * @param size The size of the memory block.
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter of the first 64 bytes.
+ * @return True if the block was decrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryAllocated(const T* address) {
-    return (address != nullptr);
+inline bool MemoryManager<T>::decryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter) {
+    return encryptMemory(address, size, key, nonce, counter, ExecutionPolicy::sequential());
 }
 
 /**
- * @brief Checks if a memory block is fully initialized with non-zero values.
+ * @brief Encrypts a memory block in place with AES in counter (CTR) mode.
  *
- * @details This function checks if a memory block is fully initialized with non-zero values.
- * If the address and size parameters are valid, the function performs the check.
- * Otherwise, it prints an error message.
+ * @details Block i of the memory is XORed with the encryption of counterBlock + i, where the 16-byte counter
+ * block is read as a big-endian 128-bit integer. A key and counter range must never be used for two different
+ * buffers. The key schedule is expanded once when the AesKey is created and can be reused for any number of
+ * calls. If the inputs are invalid, the function prints an error message and returns false without changing
+ * the block.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is fully initialized, false otherwise.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param counterBlock A pointer to the 16-byte initial counter block.
+ * @return True if the block was encrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryInitialized(const T* address, int size) {
-    if (address == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-            std::cerr << "Invalid isMemoryInitialized check: Null pointer or invalid size." << std::endl;
-#endif
-
-        return false;
-    }
-
-    return !std::any_of(address, address + size, [](const T& value) { return value == 0; });
+inline bool MemoryManager<T>::encryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock) {
+    return encryptMemory(address, size, key, counterBlock, ExecutionPolicy::sequential());
 }
 
 /**
- * @brief Checks if a memory block is empty.
+ * @brief Decrypts a memory block encrypted with AES in counter (CTR) mode.
  *
- * @details This function checks if a memory block is empty by verifying that all elements are zero.
- * If the address and size parameters are valid, the function performs the check.
- * Otherwise, it prints an error message.
+ * @details CTR decryption applies the same keystream as encryption, so the key and counter block must match the
+ * ones used to encrypt. CTR mode does not detect tampering; use decryptMemoryAuthenticated for that. If the
+ * inputs are invalid, the function prints an error message and returns false without changing the block.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is empty, false otherwise.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param counterBlock A pointer to the 16-byte initial counter block.
+ * @return True if the block was decrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryEmpty(const T* address, int size) {
-    if (address == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryEmpty check: Null pointer or invalid size." << std::endl;
-#endif
-
-        return false;
-    }
-
-    return std::all_of(address, address + size, [](const T& value) { return value == 0; });
+inline bool MemoryManager<T>::decryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock) {
+    return encryptMemory(address, size, key, counterBlock, ExecutionPolicy::sequential());
 }
 
 /**
- * @brief Checks if a memory block is readable.
+ * @brief Encrypts a memory block in place with AES-GCM and computes its authentication tag.
  *
- * @details This function checks if a memory block is readable.
- * If the address parameter is valid and size is greater than zero, the function returns true.
- * Otherwise, it prints an error message and returns false.
+ * @details The block is encrypted in counter mode from a 12-byte nonce, and a 16-byte tag is computed over the
+ * additional authenticated data and the ciphertext. The tag must be stored with the ciphertext; decryption
+ * fails if either the ciphertext, the additional data or the tag has been altered. A nonce must never be used
+ * twice with the same key. If the inputs are invalid, the function prints an error message and returns false
+ * without changing the block.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is readable, false otherwise.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param aad A pointer to additional data that is authenticated but not encrypted, or nullptr if aadLength is 0.
+ * @param aadLength The length of the additional data in bytes.
+ * @param tag A pointer to 16 bytes receiving the authentication tag.
+ * @return True if the block was encrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryReadable(const T* address, int size) {
-    if (address == nullptr) {
-        #ifdef DEBUG_MODE
-            std::cerr << "Invalid isMemoryReadable check: Null pointer." << std::endl;
-        #endif
-
-        return false;
-    }
-
-    if (size <= 0) {
-        #ifdef DEBUG_MODE
-            std::cerr << "Invalid isMemoryReadable check: Invalid size." << std::endl;
-        #endif
-
+inline bool MemoryManager<T>::encryptMemoryAuthenticated(T* address, int size, const AesKey& key, const unsigned char* nonce,
+    const unsigned char* aad, int aadLength, unsigned char* tag) {
+    if (address == nullptr || size <= 0 || aadLength < 0
+        || !key.gcmEncrypt(nonce, aad, static_cast<std::size_t>(std::max(aadLength, 0)), reinterpret_cast<unsigned char*>(address),
+            static_cast<std::size_t>(size) * sizeof(T), tag)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid encryptMemoryAuthenticated operation." << std::endl;
+#endif
         return false;
     }
-
     return true;
 }
 
 /**
- * @brief Checks if a memory block is writable.
+ * @brief Verifies and decrypts a memory block encrypted with AES-GCM.
  *
- * @details This function checks if a memory block is writable.
- * If the address parameter is valid and size is greater than zero, the function returns true.
- * Otherwise, it prints an error message and returns false.
+ * @details The tag is checked against the ciphertext and additional data before anything is decrypted, with a
+ * comparison whose time does not depend on where the tags differ. If the tag does not match, the block is left
+ * unchanged, the function prints an error message and returns false, so unauthenticated plaintext is never
+ * produced.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is writable, false otherwise.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param nonce A pointer to the 12-byte nonce used to encrypt.
+ * @param aad A pointer to the additional authenticated data, or nullptr if aadLength is 0.
+ * @param aadLength The length of the additional data in bytes.
+ * @param tag A pointer to the 16-byte authentication tag.
+ * @return True if the block was authenticated and decrypted, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryWritable(T* address, int size) {
-    if (address == nullptr) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryWritable check: Null pointer." << std::endl;
-#endif
-        return false;
-    }
-
-    if (size <= 0) {
+inline bool MemoryManager<T>::decryptMemoryAuthenticated(T* address, int size, const AesKey& key, const unsigned char* nonce,
+    const unsigned char* aad, int aadLength, const unsigned char* tag) {
+    if (address == nullptr || size <= 0 || aadLength < 0
+        || !key.gcmDecrypt(nonce, aad, static_cast<std::size_t>(std::max(aadLength, 0)), reinterpret_cast<unsigned char*>(address),
+            static_cast<std::size_t>(size) * sizeof(T), tag)) {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryWritable check: Invalid size." << std::endl;
+        std::cerr << "Invalid decryptMemoryAuthenticated operation." << std::endl;
 #endif
         return false;
     }
-
     return true;
 }
 
 /**
- * @brief Swaps adjacent values in a memory block.
+ * @brief Reverses a portion of a memory block within a specified range.
  *
- * @details This function swaps adjacent values in a memory block.
- * If the address parameter is valid and size is greater than one, the function performs the swap.
+ * @details This function reverses a portion of a memory block within a specified range.
+ * If the address, start, and end parameters are valid, the function performs the reversal.
  * Otherwise, it prints an error message.
  *
  * @param address A pointer to the start of the memory block.
- * @param size The size of the memory block.
+ * @param start The starting index of the range to reverse.
+ * @param end The ending index of the range to reverse.
  */
 template <typename T>
-inline void MemoryManager<T>::swapAdjacentValues(T* address, int size) {
-    if (address != nullptr && size > 1) {
-        for (int i = 0; i < size - 1; i += 2) {
-            std::swap(address[i], address[i + 1]);
-        }
+inline void MemoryManager<T>::reverseMemoryInRange(T* address, int start, int end) {
+    if (address != nullptr && start >= 0 && start < end) {
+        std::reverse(address + start, address + end + 1);
     }
     else {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid swapAdjacentValues operation." << std::endl;
+            std::cerr << "Invalid reverseMemoryInRange operation." << std::endl;
 #endif
     }
 }
 
 /**
- * @brief Replaces occurrences of a value in a memory block.
+ * @brief Rotates a memory block to the left by a specified number of positions.
  *
- * @details This function replaces occurrences of a specified old value with a new value in a memory block.
- * If the address parameter is valid and size is greater than zero, the function performs the replacement.
+ * @details This function rotates a memory block to the left by a specified number of positions.
+ * If the address and size parameters are valid, the function performs the rotation.
  * Otherwise, it prints an error message.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param oldValue The value to be replaced.
- * @param newValue The new value to replace the old value.
+ * @param shiftCount The number of positions to rotate the memory block to the left.
  */
 template <typename T>
-inline void MemoryManager<T>::replaceValue(T* address, int size, int oldValue, int newValue) {
+inline void MemoryManager<T>::rotateMemoryLeft(T* address, int size, int shiftCount) {
     if (address != nullptr && size > 0) {
-        std::replace(address, address + size, oldValue, newValue);
+        rotateRange(address, size, normalizeShift(shiftCount, size));
     }
     else {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid replaceValue operation." << std::endl;
+            std::cerr << "Invalid rotateMemoryLeft operation." << std::endl;
 #endif
     }
 }
 
 /**
- * @brief Merges two sorted memory blocks into a new sorted block.
+ * @brief Rotates a memory block to the right by a specified number of positions.
  *
- * @details This function merges two sorted memory blocks into a new sorted block.
- * If both input blocks are valid (non-null and non-empty), the function performs the merge.
- * Otherwise, it prints an error message and returns a null pointer.
+ * @details This function rotates a memory block to the right by a specified number of positions.
+ * If the address and size parameters are valid, the function performs the rotation.
+ * Otherwise, it prints an error message.
  *
- * @param block1 A pointer to the first sorted memory block.
- * @param size1 The size of the first memory block.
- * @param block2 A pointer to the second sorted memory block.
- * @param size2 The size of the second memory block.
- * @return A pointer to the newly merged sorted memory block, or nullptr if there are invalid inputs.
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param shiftCount The number of positions to rotate the memory block to the right.
  */
 template <typename T>
-inline T* MemoryManager<T>::mergeSortedMemory(const T* block1, int size1, const T* block2, int size2) {
-    if (block1 == nullptr || size1 <= 0 || block2 == nullptr || size2 <= 0) {
+inline void MemoryManager<T>::rotateMemoryRight(T* address, int size, int shiftCount) {
+    if (address != nullptr && size > 0) {
+        std::size_t rightShift = normalizeShift(shiftCount, size);
+        rotateRange(address, size, rightShift == 0 ? 0 : size - rightShift);
+    }
+    else {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid mergeSortedMemory operation: Null or empty blocks." << std::endl;
+            std::cerr << "Invalid rotateMemoryRight operation." << std::endl;
 #endif
-        return nullptr;
     }
+}
 
-    T* mergedBlock = new T[size1 + size2];
-    int i = 0, j = 0, k = 0;
-
-    while (i < size1 && j < size2) {
-        if (block1[i] < block2[j]) {
-            mergedBlock[k++] = block1[i++];
-        }
-        else {
-            mergedBlock[k++] = block2[j++];
-        }
+/**
+ * @brief Removes the elements equal to a value from a block of 32-bit integers.
+ *
+ * @details The block is compacted in place with the widest available kernel, and the remaining elements
+ * are handled by a scalar loop that stores every element and only advances the output on a keep, so
+ * no path branches on the data and the throughput does not depend on how many elements match.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param value The value to remove.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::removeEqual(T* address, std::size_t size, const T& value, std::true_type) {
+    std::size_t index = 0;
+    std::size_t kept = 0;
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx512()) {
+        kept = removeEqualAvx512(address, size, value, index);
     }
-
-    while (i < size1) {
-        mergedBlock[k++] = block1[i++];
+    else if (CpuFeatures::hasAvx2()) {
+        kept = removeEqualAvx2(address, size, value, index);
     }
-
-    while (j < size2) {
-        mergedBlock[k++] = block2[j++];
+#endif
+    for (; index < size; ++index) {
+        T element = address[index];
+        address[kept] = element;
+        kept += element != value;
     }
+    return kept;
+}
 
-    return mergedBlock;
+/**
+ * @brief Removes the elements equal to a value from a memory block.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param value The value to remove.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::removeEqual(T* address, std::size_t size, const T& value, std::false_type) {
+    return std::remove(address, address + size, value) - address;
 }
 
 /**
- * @brief Checks if a memory block is a palindrome.
+ * @brief Removes the elements matching a predicate from a block of 32-bit integers.
  *
- * @details This function checks if a memory block is a palindrome.
- * If the address parameter is valid and size is greater than zero, the function performs the check.
- * Otherwise, it prints an error message and returns false.
+ * @details The predicate is evaluated once per element into a lane mask, which drives the same
+ * compaction as removeEqual.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is a palindrome, false otherwise.
+ * @param predicate A callable returning true for the elements to remove.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryPalindrome(const T* address, int size) {
-    if (address == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryPalindrome operation: Null or empty block." << std::endl;
-#endif
-        return false;
+template <typename Predicate>
+inline std::size_t MemoryManager<T>::removeMatching(T* address, std::size_t size, Predicate predicate, std::true_type) {
+    std::size_t index = 0;
+    std::size_t kept = 0;
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx2()) {
+        kept = removeMatchingAvx2(address, size, predicate, index);
     }
-
-    int halfSize = size / 2;
-    for (int i = 0; i < halfSize; ++i) {
-        if (address[i] != address[size - 1 - i]) {
-            return false;
-        }
+#endif
+    for (; index < size; ++index) {
+        T element = address[index];
+        address[kept] = element;
+        kept += !predicate(element);
     }
+    return kept;
+}
 
-    return true;
+/**
+ * @brief Removes the elements matching a predicate from a memory block.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param predicate A callable returning true for the elements to remove.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
+ */
+template <typename T>
+template <typename Predicate>
+inline std::size_t MemoryManager<T>::removeMatching(T* address, std::size_t size, Predicate predicate, std::false_type) {
+    return std::remove_if(address, address + size, predicate) - address;
 }
 
 /**
- * @brief Performs binary search on a sorted memory block.
+ * @brief Removes consecutive duplicates from a block of 32-bit integers.
  *
- * @details This function performs binary search on a sorted memory block to find the target value.
- * If the sortedBlock parameter is valid (non-null and non-empty), the function returns the index of the target value.
- * If the target is not found, it returns -1. If the inputs are invalid, it prints an error message and returns -1.
+ * @details Every element is compared with its predecessor in the original block, which the kernels
+ * keep in registers because their stores may already have overwritten it in memory.
  *
- * @param sortedBlock A pointer to the sorted memory block.
- * @param size The size of the sorted memory block.
- * @param target The value to search for.
- * @return The index of the target value if found, -1 otherwise.
+ * @param address A pointer to the start of the memory block, which must not be empty.
+ * @param size The size of the memory block.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
  */
 template <typename T>
-inline int MemoryManager<T>::binarySearch(const T* sortedBlock, int size, int target) {
-    if (sortedBlock == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid binarySearch operation: Null or empty sorted block." << std::endl;
-#endif
-        return -1;
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicates(T* address, std::size_t size, std::true_type) {
+    std::size_t index = 1;
+    std::size_t kept = 1;
+    T previous = address[0];
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx512()) {
+        kept = removeAdjacentDuplicatesAvx512(address, size, index, previous);
     }
-
-    int left = 0;
-    int right = size - 1;
-
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-
-        if (sortedBlock[mid] == target) {
-            return mid;
-        }
-        else if (sortedBlock[mid] < target) {
-            left = mid + 1;
-        }
-        else {
-            right = mid - 1;
-        }
+    else if (CpuFeatures::hasAvx2()) {
+        kept = removeAdjacentDuplicatesAvx2(address, size, index, previous);
+    }
+#endif
+    for (; index < size; ++index) {
+        T element = address[index];
+        address[kept] = element;
+        kept += element != previous;
+        previous = element;
     }
+    return kept;
+}
 
-    return -1;
+/**
+ * @brief Removes consecutive duplicates from a memory block.
+ *
+ * @param address A pointer to the start of the memory block, which must not be empty.
+ * @param size The size of the memory block.
+ * @return The number of elements kept, which now occupy the front of the block in their original order.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicates(T* address, std::size_t size, std::false_type) {
+    return std::unique(address, address + size) - address;
 }
 
 /**
- * @brief Rotates a specified range of a memory block to the left by a given shift count.
+ * @brief Returns the lane permutations used to compact eight 32-bit lanes.
  *
- * @details This function rotates a specified range of a memory block to the left by a given shift count.
- * If the address parameter is valid and the start, end, and shiftCount parameters are within bounds,
- * the function performs the rotation. Otherwise, it prints an error message.
+ * @details Entry m lists, one byte per lane, the indices of the set bits of m in ascending order, so
+ * permuting a vector by it moves the lanes selected by m to the front. The table is built on first use.
  *
- * @param address A pointer to the start of the memory block.
- * @param start The start index of the range to rotate.
- * @param end The end index of the range to rotate.
- * @param shiftCount The number of positions to rotate the range to the left.
+ * @return A pointer to the 256 entries.
  */
 template <typename T>
-inline void MemoryManager<T>::rotateMemoryRangeLeft(T* address, int start, int end, int shiftCount) {
-    if (address != nullptr && start >= 0 && end < size && start < end) {
-        std::rotate(address + start, address + start + (shiftCount % (end - start + 1)), address + end + 1);
-    }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid rotateMemoryRangeLeft operation." << std::endl;
-#endif
-    }
+inline const std::uint64_t* MemoryManager<T>::compactionTable() {
+    struct Table {
+        std::uint64_t entries[256];
+
+        Table() {
+            for (unsigned int mask = 0; mask < 256; ++mask) {
+                std::uint64_t entry = 0;
+                unsigned int slot = 0;
+                for (unsigned int lane = 0; lane < 8; ++lane) {
+                    if (mask & (1u << lane)) {
+                        entry |= static_cast<std::uint64_t>(lane) << (8 * slot++);
+                    }
+                }
+                entries[mask] = entry;
+            }
+        }
+    };
+    static const Table table;
+    return table.entries;
 }
 
+#ifdef PTRX_X86_DISPATCH
 /**
- * @brief Rotates a specified range of a memory block to the right by a given shift count.
+ * @brief Compacts the elements not equal to a value with AVX2.
  *
- * @details This function rotates a specified range of a memory block to the right by a given shift count.
- * If the address parameter is valid and the start, end, and shiftCount parameters are within bounds,
- * the function performs the rotation. Otherwise, it prints an error message.
+ * @details Each group of eight elements is compared with the value, the resulting keep mask selects a
+ * permutation from compactionTable, and the permuted vector is stored in full at the output position.
+ * The lanes past the kept ones are scratch that the next store overwrites. The output never passes the
+ * input, so the store only touches elements that have already been loaded.
  *
  * @param address A pointer to the start of the memory block.
- * @param start The start index of the range to rotate.
- * @param end The end index of the range to rotate.
- * @param shiftCount The number of positions to rotate the range to the right.
+ * @param size The size of the memory block.
+ * @param value The value to remove.
+ * @param index Receives the index of the first element left for the caller.
+ * @return The number of elements kept so far.
  */
 template <typename T>
-inline void MemoryManager<T>::rotateMemoryRangeRight(T* address, int start, int end, int shiftCount) {
-    if (address != nullptr && start >= 0 && end < size && start < end) {
-        std::rotate(address + start, address + end - (shiftCount % (end - start + 1)) + 1, address + end + 1);
-    }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid rotateMemoryRangeRight operation." << std::endl;
-#endif
-    }
+PTRX_TARGET("avx2,popcnt")
+inline std::size_t MemoryManager<T>::removeEqualAvx2(T* address, std::size_t size, T value, std::size_t& index) {
+    const std::uint64_t* table = compactionTable();
+    const __m256i needle = _mm256_set1_epi32(static_cast<int>(value));
+    std::size_t kept = 0;
+    for (; index + 8 <= size; index += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address + index));
+        unsigned int keep = ~static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)))) & 0xFF;
+        __m256i permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table + keep)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(address + kept), _mm256_permutevar8x32_epi32(block, permutation));
+        kept += _mm_popcnt_u32(keep);
+    }
+    return kept;
 }
 
 /**
- * @brief Swaps adjacent memory ranges in a memory block.
+ * @brief Compacts the elements not equal to a value with AVX-512.
  *
- * @details This function swaps adjacent memory ranges in a memory block.
- * If the address parameter is valid and the range indices are within bounds,
- * the function performs the swap. Otherwise, it prints an error message.
+ * @details This is the AVX2 kernel on sixteen lanes, with the permutation done by a compress instruction.
  *
  * @param address A pointer to the start of the memory block.
- * @param range1Start The start index of the first range to swap.
- * @param range1End The end index of the first range to swap.
- * @param range2Start The start index of the second range to swap.
- * @param range2End The end index of the second range to swap.
+ * @param size The size of the memory block.
+ * @param value The value to remove.
+ * @param index Receives the index of the first element left for the caller.
+ * @return The number of elements kept so far.
  */
 template <typename T>
-inline void MemoryManager<T>::swapAdjacentMemoryRanges(T* address, int range1Start, int range1End, int range2Start, int range2End) {
-    if (address != nullptr && range1Start >= 0 && range1End < size && range1Start < range1End &&
-        range2Start >= 0 && range2End < size && range2Start < range2End) {
-
-        std::swap_ranges(address + range1Start, address + range1End + 1, address + range2Start);
-    }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid swapAdjacentMemoryRanges operation." << std::endl;
-#endif
-    }
+PTRX_TARGET("avx512f,popcnt")
+inline std::size_t MemoryManager<T>::removeEqualAvx512(T* address, std::size_t size, T value, std::size_t& index) {
+    const __m512i needle = _mm512_set1_epi32(static_cast<int>(value));
+    std::size_t kept = 0;
+    for (; index + 16 <= size; index += 16) {
+        __m512i block = _mm512_loadu_si512(address + index);
+        __mmask16 keep = _mm512_cmpneq_epi32_mask(block, needle);
+        _mm512_storeu_si512(address + kept, _mm512_maskz_compress_epi32(keep, block));
+        kept += _mm_popcnt_u32(keep);
+    }
+    return kept;
 }
 
 /**
- * @brief Performs three-way partitioning on a memory block based on a pivot value.
+ * @brief Compacts the elements not matching a predicate with AVX2.
  *
- * @details This function performs three-way partitioning on a memory block based on a pivot value.
- * If the address parameter is valid and the size is greater than zero, the function partitions the block.
- * It updates the lowerBound and upperBound parameters to indicate the resulting partitions.
- * If the inputs are invalid, it prints an error message.
+ * @details The keep mask of each group of eight elements is built from the predicate without branches,
+ * then the group is compacted like in removeEqualAvx2.
  *
  * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param pivotValue The pivot value for partitioning.
- * @param lowerBound Reference to the lower bound of the partition with values less than the pivot.
- * @param upperBound Reference to the upper bound of the partition with values greater than the pivot.
+ * @param predicate A callable returning true for the elements to remove.
+ * @param index Receives the index of the first element left for the caller.
+ * @return The number of elements kept so far.
  */
 template <typename T>
-inline void MemoryManager<T>::threeWayPartition(T* address, int size, int pivotValue, int& lowerBound, int& upperBound) {
-    if (address != nullptr && size > 0) {
-        lowerBound = 0;
-        upperBound = size - 1;
-
-        int i = 0;
-        while (i <= upperBound) {
-            if (address[i] < pivotValue) {
-                std::swap(address[i], address[lowerBound]);
-                ++lowerBound;
-                ++i;
-            }
-            else if (address[i] > pivotValue) {
-                std::swap(address[i], address[upperBound]);
-                --upperBound;
-            }
-            else {
-                ++i;
-            }
+template <typename Predicate>
+PTRX_TARGET("avx2,popcnt")
+inline std::size_t MemoryManager<T>::removeMatchingAvx2(T* address, std::size_t size, Predicate& predicate, std::size_t& index) {
+    const std::uint64_t* table = compactionTable();
+    std::size_t kept = 0;
+    for (; index + 8 <= size; index += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address + index));
+        unsigned int keep = 0;
+        for (unsigned int lane = 0; lane < 8; ++lane) {
+            keep |= static_cast<unsigned int>(!predicate(address[index + lane])) << lane;
         }
+        __m256i permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table + keep)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(address + kept), _mm256_permutevar8x32_epi32(block, permutation));
+        kept += _mm_popcnt_u32(keep);
     }
-    else {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid threeWayPartition operation." << std::endl;
-#endif
-    }
+    return kept;
 }
 
 /**
- * @brief Computes the union of two sorted memory blocks.
+ * @brief Compacts away consecutive duplicates with AVX2.
  *
- * @details This function computes the union of two sorted memory blocks, removing duplicate elements.
- * If the input blocks are valid (non-null and sizes greater than zero), the function returns a new memory block
- * containing the union and sets the unionSize parameter to the size of the union. If the inputs are invalid,
- * it prints an error message, sets unionSize to 0, and returns a null pointer.
+ * @details Each group of eight elements is compared with itself shifted by one lane, with the last
+ * element of the previous group carried in from a register, and compacted like in removeEqualAvx2.
  *
- * @param block1 A pointer to the first sorted memory block.
- * @param size1 The size of the first memory block.
- * @param block2 A pointer to the second sorted memory block.
- * @param size2 The size of the second memory block.
- * @param unionSize Reference to store the size of the resulting union.
- * @return A pointer to the memory block containing the union, or nullptr if the operation is invalid.
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param index The index of the first element to process, which receives the index of the first
+ * element left for the caller.
+ * @param previous The element before index, which receives the element before the returned index.
+ * @return The number of elements kept so far, counting the index elements before the first one processed.
  */
 template <typename T>
-inline T* MemoryManager<T>::unionSortedMemory(const T* block1, int size1, const T* block2, int size2, int& unionSize) {
-    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid unionSortedMemory operation." << std::endl;
-#endif
-
-        unionSize = 0;
-        return nullptr;
-    }
-
-    std::vector<int> result;
-    std::merge(block1, block1 + size1, block2, block2 + size2, std::back_inserter(result));
-    result.erase(std::unique(result.begin(), result.end()), result.end());
-
-    unionSize = static_cast<int>(result.size());
-    T* unionMemory = new int[unionSize];
-    std::copy(result.begin(), result.end(), unionMemory);
-
-    return unionMemory;
+PTRX_TARGET("avx2,popcnt")
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicatesAvx2(T* address, std::size_t size, std::size_t& index, T& previous) {
+    const std::uint64_t* table = compactionTable();
+    const __m256i rotation = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    __m256i carry = _mm256_set1_epi32(static_cast<int>(previous));
+    std::size_t kept = index;
+    for (; index + 8 <= size; index += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address + index));
+        __m256i predecessors = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(block, rotation), carry, 0x01);
+        unsigned int keep = ~static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, predecessors)))) & 0xFF;
+        __m256i permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table + keep)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(address + kept), _mm256_permutevar8x32_epi32(block, permutation));
+        kept += _mm_popcnt_u32(keep);
+        carry = _mm256_permutevar8x32_epi32(block, _mm256_set1_epi32(7));
+    }
+    previous = static_cast<T>(_mm_cvtsi128_si32(_mm256_castsi256_si128(carry)));
+    return kept;
 }
 
 /**
- * @brief Computes the difference of two sorted memory blocks.
+ * @brief Compacts away consecutive duplicates with AVX-512.
  *
- * @details This function computes the difference of two sorted memory blocks, removing common elements.
- * If the input blocks are valid (non-null and sizes greater than zero), the function returns a new memory block
- * containing the difference and sets the differenceSize parameter to the size of the difference.
- * If the inputs are invalid, it prints an error message, sets differenceSize to 0, and returns a null pointer.
+ * @details This is the AVX2 kernel on sixteen lanes, with the predecessors aligned in from the previous
+ * group and the permutation done by a compress instruction.
  *
- * @param block1 A pointer to the first sorted memory block.
- * @param size1 The size of the first memory block.
- * @param block2 A pointer to the second sorted memory block.
- * @param size2 The size of the second memory block.
- * @param differenceSize Reference to store the size of the resulting difference.
- * @return A pointer to the memory block containing the difference, or nullptr if the operation is invalid.
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param index The index of the first element to process, which receives the index of the first
+ * element left for the caller.
+ * @param previous The element before index, which receives the element before the returned index.
+ * @return The number of elements kept so far, counting the index elements before the first one processed.
  */
 template <typename T>
-inline T* MemoryManager<T>::differenceSortedMemory(const T* block1, int size1, const T* block2, int size2, int& differenceSize) {
-    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid differenceSortedMemory operation." << std::endl;
-#endif
-        differenceSize = 0;
-        return nullptr;
-    }
+PTRX_TARGET("avx512f,popcnt")
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicatesAvx512(T* address, std::size_t size, std::size_t& index, T& previous) {
+    __m512i last = _mm512_set1_epi32(static_cast<int>(previous));
+    std::size_t kept = index;
+    for (; index + 16 <= size; index += 16) {
+        __m512i block = _mm512_loadu_si512(address + index);
+        __m512i predecessors = _mm512_maskz_alignr_epi32(0xFFFF, block, last, 15);
+        __mmask16 keep = _mm512_cmpneq_epi32_mask(block, predecessors);
+        _mm512_storeu_si512(address + kept, _mm512_maskz_compress_epi32(keep, block));
+        kept += _mm_popcnt_u32(keep);
+        last = block;
+    }
+    int lanes[16];
+    _mm512_storeu_si512(lanes, last);
+    previous = static_cast<T>(lanes[15]);
+    return kept;
+}
+#else
+template <typename T>
+inline std::size_t MemoryManager<T>::removeEqualAvx2(T*, std::size_t, T, std::size_t& index) {
+    return index;
+}
+
+template <typename T>
+inline std::size_t MemoryManager<T>::removeEqualAvx512(T*, std::size_t, T, std::size_t& index) {
+    return index;
+}
 
-    std::vector<int> result;
-    std::set_difference(block1, block1 + size1, block2, block2 + size2, std::back_inserter(result));
+template <typename T>
+template <typename Predicate>
+inline std::size_t MemoryManager<T>::removeMatchingAvx2(T*, std::size_t, Predicate&, std::size_t& index) {
+    return index;
+}
 
-    differenceSize = static_cast<int>(result.size());
-    T* differenceMemory = new int[differenceSize];
-    std::copy(result.begin(), result.end(), differenceMemory);
+template <typename T>
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicatesAvx2(T*, std::size_t, std::size_t& index, T&) {
+    return index;
+}
 
-    return differenceMemory;
+template <typename T>
+inline std::size_t MemoryManager<T>::removeAdjacentDuplicatesAvx512(T*, std::size_t, std::size_t& index, T&) {
+    return index;
 }
+#endif
 
 /**
- * @brief Computes the symmetric difference of two sorted memory blocks.
+ * @brief Moves the elements below a pivot to the front of a block of 32-bit integers.
  *
- * @details This function computes the symmetric difference of two sorted memory blocks,
- * removing elements common to both blocks. If the input blocks are valid (non-null and sizes greater than zero),
- * the function returns a new memory block containing the symmetric difference and sets the symDiffSize parameter
- * to the size of the symmetric difference. If the inputs are invalid, it prints an error message,
- * sets symDiffSize to 0, and returns a null pointer.
+ * @details The partition is stable and does not branch on the data: every element is written both to the
+ * front of the block and to the scratch block, and only the matching output advances. The elements above
+ * the pivot are then copied back behind the others. The vector kernels do the same with compaction
+ * permutations, as in removeEqual. Without a scratch block the partition runs in place, and is not stable.
  *
- * @param block1 A pointer to the first sorted memory block.
- * @param size1 The size of the first memory block.
- * @param block2 A pointer to the second sorted memory block.
- * @param size2 The size of the second memory block.
- * @param symDiffSize Reference to store the size of the resulting symmetric difference.
- * @return A pointer to the memory block containing the symmetric difference, or nullptr if the operation is invalid.
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivot The pivot value.
+ * @param inclusive If true, elements equal to the pivot count as below it.
+ * @param scratch A pointer to a scratch block of at least size elements, or nullptr.
+ * @return The number of elements below the pivot.
  */
 template <typename T>
-inline T* MemoryManager<T>::symmetricDifferenceSortedMemory(const T* block1, int size1, const T* block2, int size2, int& symDiffSize) {
-    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid symmetricDifferenceSortedMemory operation." << std::endl;
-#endif
-        symDiffSize = 0;
-        return nullptr;
+inline std::size_t MemoryManager<T>::partitionBlock(T* address, std::size_t size, const T& pivot, bool inclusive, T* scratch, std::true_type) {
+    if (scratch == nullptr) {
+        return partitionBlock(address, size, pivot, inclusive, scratch, std::false_type());
     }
 
-    std::vector<int> result;
-    std::set_symmetric_difference(block1, block1 + size1, block2, block2 + size2, std::back_inserter(result));
-
-    symDiffSize = static_cast<int>(result.size());
-    T* symDiffMemory = new int[symDiffSize];
-    std::copy(result.begin(), result.end(), symDiffMemory);
-
-    return symDiffMemory;
+    std::size_t index = 0;
+    std::size_t below = 0;
+    std::size_t above = 0;
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx512()) {
+        below = partitionBlockAvx512(address, size, pivot, inclusive, scratch, index, above);
+    }
+    else if (CpuFeatures::hasAvx2()) {
+        below = partitionBlockAvx2(address, size, pivot, inclusive, scratch, index, above);
+    }
+#endif
+    for (; index < size; ++index) {
+        T element = address[index];
+        bool low = inclusive ? !(pivot < element) : element < pivot;
+        address[below] = element;
+        scratch[above] = element;
+        below += low;
+        above += !low;
+    }
+    std::memcpy(address + below, scratch, above * sizeof(T));
+    return below;
 }
 
 /**
- * @brief Checks if a memory block is a subset of another sorted memory block.
- *
- * @details This function checks if the memory block 'potentialSubset' is a subset of the sorted memory block 'set'.
- * If both blocks are valid (non-null and sizes greater than zero), the function returns true if 'potentialSubset'
- * is a subset of 'set'; otherwise, it returns false. If the inputs are invalid, it prints an error message and
- * returns false.
+ * @brief Moves the elements below a pivot to the front of a memory block.
  *
- * @param potentialSubset A pointer to the potential subset memory block.
- * @param subsetSize The size of the potential subset memory block.
- * @param set A pointer to the sorted memory block.
- * @param setSize The size of the sorted memory block.
- * @return True if 'potentialSubset' is a subset of 'set', false otherwise or in case of invalid inputs.
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivot The pivot value.
+ * @param inclusive If true, elements equal to the pivot count as below it.
+ * @param scratch Unused.
+ * @return The number of elements below the pivot.
  */
 template <typename T>
-inline bool MemoryManager<T>::isSubsetSortedMemory(const T* potentialSubset, int subsetSize, const T* set, int setSize) {
-    if (potentialSubset == nullptr || subsetSize <= 0 || set == nullptr || setSize <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isSubsetSortedMemory operation." << std::endl;
-#endif
-        return false;
-    }
-
-    return std::includes(set, set + setSize, potentialSubset, potentialSubset + subsetSize);
+inline std::size_t MemoryManager<T>::partitionBlock(T* address, std::size_t size, const T& pivot, bool inclusive, T*, std::false_type) {
+    T* middle = inclusive
+        ? std::partition(address, address + size, [&pivot](const T& element) { return !(pivot < element); })
+        : std::partition(address, address + size, [&pivot](const T& element) { return element < pivot; });
+    return middle - address;
 }
 
+#ifdef PTRX_X86_DISPATCH
 /**
- * @brief Checks if a memory block is strictly increasing.
+ * @brief Partitions a block of 32-bit integers around a pivot with AVX2.
  *
- * @details This function checks if the memory block 'address' is strictly increasing.
- * If the block is valid (non-null and size greater than zero), the function returns true if the elements
- * are strictly increasing; otherwise, it returns false. If the input is invalid, it prints an error message
- * and returns false.
+ * @details Each group of eight elements is compared with the pivot, after flipping the sign bits of
+ * unsigned types so that the signed comparison orders them correctly. The low lanes are compacted to
+ * the front of the block and the high lanes to the scratch block, both with full-width stores whose
+ * spare lanes the next store overwrites. Neither output passes the input position.
  *
- * @param address A pointer to the memory block.
+ * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is strictly increasing, false otherwise or in case of invalid input.
+ * @param pivot The pivot value.
+ * @param inclusive If true, elements equal to the pivot count as below it.
+ * @param scratch A pointer to a scratch block of at least size elements.
+ * @param index Receives the index of the first element left for the caller.
+ * @param above Receives the number of elements written to the scratch block.
+ * @return The number of elements written to the front of the block.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryStrictlyIncreasing(const T* address, int size) {
-    if (address == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryStrictlyIncreasing operation." << std::endl;
-#endif
-        return false;
-    }
-
-    return std::is_sorted(address, address + size) && std::adjacent_find(address, address + size, std::greater<int>()) == address + size;
+PTRX_TARGET("avx2,popcnt")
+inline std::size_t MemoryManager<T>::partitionBlockAvx2(T* address, std::size_t size, T pivot, bool inclusive, T* scratch,
+    std::size_t& index, std::size_t& above) {
+    const std::uint64_t* table = compactionTable();
+    const __m256i bias = _mm256_set1_epi32(std::is_signed<T>::value ? 0 : static_cast<int>(0x80000000u));
+    const __m256i bound = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(pivot)), bias);
+    const unsigned int flip = inclusive ? 0xFF : 0;
+    std::size_t below = 0;
+    for (; index + 8 <= size; index += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address + index));
+        __m256i key = _mm256_xor_si256(block, bias);
+        __m256i greater = inclusive ? _mm256_cmpgt_epi32(key, bound) : _mm256_cmpgt_epi32(bound, key);
+        unsigned int low = (static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(greater))) ^ flip) & 0xFF;
+        __m256i lowPermutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table + low)));
+        __m256i highPermutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table + (low ^ 0xFF))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(address + below), _mm256_permutevar8x32_epi32(block, lowPermutation));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scratch + above), _mm256_permutevar8x32_epi32(block, highPermutation));
+        unsigned int lowCount = _mm_popcnt_u32(low);
+        below += lowCount;
+        above += 8 - lowCount;
+    }
+    return below;
 }
 
 /**
- * @brief Checks if a memory block is strictly decreasing.
+ * @brief Partitions a block of 32-bit integers around a pivot with AVX-512.
  *
- * @details This function checks if the memory block 'address' is strictly decreasing.
- * If the block is valid (non-null and size greater than zero), the function returns true if the elements
- * are strictly decreasing; otherwise, it returns false. If the input is invalid, it prints an error message
- * and returns false.
+ * @details This is the AVX2 kernel on sixteen lanes, with native unsigned comparisons and the
+ * permutations done by compress instructions.
  *
- * @param address A pointer to the memory block.
+ * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @return True if the memory block is strictly decreasing, false otherwise or in case of invalid input.
+ * @param pivot The pivot value.
+ * @param inclusive If true, elements equal to the pivot count as below it.
+ * @param scratch A pointer to a scratch block of at least size elements.
+ * @param index Receives the index of the first element left for the caller.
+ * @param above Receives the number of elements written to the scratch block.
+ * @return The number of elements written to the front of the block.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryStrictlyDecreasing(const T* address, int size) {
-    if (address == nullptr || size <= 0) {
-#ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryStrictlyDecreasing operation." << std::endl;
-#endif
-        return false;
+PTRX_TARGET("avx512f,popcnt")
+inline std::size_t MemoryManager<T>::partitionBlockAvx512(T* address, std::size_t size, T pivot, bool inclusive, T* scratch,
+    std::size_t& index, std::size_t& above) {
+    const __m512i bound = _mm512_set1_epi32(static_cast<int>(pivot));
+    std::size_t below = 0;
+    for (; index + 16 <= size; index += 16) {
+        __m512i block = _mm512_loadu_si512(address + index);
+        __mmask16 low;
+        if (std::is_signed<T>::value) {
+            low = inclusive ? _mm512_cmple_epi32_mask(block, bound) : _mm512_cmplt_epi32_mask(block, bound);
+        }
+        else {
+            low = inclusive ? _mm512_cmple_epu32_mask(block, bound) : _mm512_cmplt_epu32_mask(block, bound);
+        }
+        _mm512_storeu_si512(address + below, _mm512_maskz_compress_epi32(low, block));
+        _mm512_storeu_si512(scratch + above, _mm512_maskz_compress_epi32(static_cast<__mmask16>(~low), block));
+        unsigned int lowCount = _mm_popcnt_u32(low);
+        below += lowCount;
+        above += 16 - lowCount;
     }
+    return below;
+}
+#else
+template <typename T>
+inline std::size_t MemoryManager<T>::partitionBlockAvx2(T*, std::size_t, T, bool, T*, std::size_t&, std::size_t&) {
+    return 0;
+}
 
-    return std::is_sorted(address, address + size, std::greater<int>()) && std::adjacent_find(address, address + size, std::less<int>()) == address + size;
+template <typename T>
+inline std::size_t MemoryManager<T>::partitionBlockAvx512(T*, std::size_t, T, bool, T*, std::size_t&, std::size_t&) {
+    return 0;
 }
+#endif
 
 /**
- * @brief Checks if a memory block has a plateau.
+ * @brief Allocates the scratch block used by the 32-bit integer partition kernels.
  *
- * @details This function checks if the memory block 'address' has a plateau,
- * i.e., a contiguous sequence of equal values. If the block is valid (non-null and size greater than zero),
- * the function returns true if there is a plateau, and it sets 'plateauStart' and 'plateauEnd' to the start and end
- * indices of the plateau. If there is no plateau, both indices are set to -1. If the input is invalid, it prints
- * an error message and returns false.
+ * @details Other element types partition in place and get no block. If the allocation fails, the function
+ * returns nullptr and the partition falls back to running in place, like sortElements does for its buffer.
  *
- * @param address A pointer to the memory block.
- * @param size The size of the memory block.
- * @param plateauStart Reference to store the start index of the plateau.
- * @param plateauEnd Reference to store the end index of the plateau.
- * @return True if the memory block has a plateau, false otherwise or in case of invalid input.
+ * @param size The number of elements to make room for.
+ * @return A pointer to the scratch block, or nullptr.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryPlateau(const T* address, int size, int& plateauStart, int& plateauEnd) {
-    if (address == nullptr || size <= 0) {
+inline T* MemoryManager<T>::allocatePartitionScratch(std::size_t size) {
+    typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+    if (!IsInt32::value) {
+        return nullptr;
+    }
+
+    T* scratch = new (std::nothrow) T[size];
+    if (scratch == nullptr) {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryPlateau operation." << std::endl;
+        std::cerr << "Partition buffer allocation failed, falling back to an in-place partition." << std::endl;
 #endif
-        return false;
     }
+    return scratch;
+}
 
-    plateauStart = plateauEnd = -1;
-
-    for (int i = 1; i < size; ++i) {
-        if (address[i] == address[i - 1]) {
-            if (plateauStart == -1) {
-                plateauStart = i - 1;
-            }
-            plateauEnd = i;
+/**
+ * @brief Moves the elements below a pivot to the front of a memory block, splitting the work with a policy.
+ *
+ * @details A parallel policy partitions one chunk per thread, which leaves a low and a high run in every
+ * chunk. The high elements that ended up in front of the final split point and the low elements behind
+ * it are equally many; they are paired up by rank and swapped, with the pairs split evenly across the
+ * threads. Only the sequential partition is stable.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivot The pivot value.
+ * @param inclusive If true, elements equal to the pivot count as below it.
+ * @param scratch A pointer to a scratch block of at least size elements, used for 32-bit integers, or nullptr.
+ * @param policy The execution policy to apply.
+ * @return The number of elements below the pivot.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::partitionElements(T* address, std::size_t size, const T& pivot, bool inclusive, T* scratch,
+    const ExecutionPolicy& policy) {
+    typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+    unsigned int threads = parallelThreadCount(static_cast<int>(std::min<std::size_t>(size, std::numeric_limits<int>::max())), policy);
+    if (threads <= 1) {
+        return partitionBlock(address, size, pivot, inclusive, scratch, IsInt32());
+    }
+
+    std::size_t grainSize = (size + threads - 1) / threads;
+    std::size_t chunkCount = (size + grainSize - 1) / grainSize;
+    std::vector<std::size_t> lowCounts(chunkCount);
+    threadPool->parallelFor(size, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        lowCounts[begin / grainSize] = partitionBlock(address + begin, end - begin, pivot, inclusive,
+            scratch != nullptr ? scratch + begin : nullptr, IsInt32());
+    });
+
+    std::size_t split = std::accumulate(lowCounts.begin(), lowCounts.end(), std::size_t(0));
+    std::vector<std::pair<std::size_t, std::size_t>> misplacedHigh, misplacedLow;
+    std::size_t misplaced = 0;
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        std::size_t begin = chunk * grainSize;
+        std::size_t middle = begin + lowCounts[chunk];
+        std::size_t end = std::min(begin + grainSize, size);
+        if (middle < split && middle < end) {
+            misplacedHigh.push_back(std::make_pair(middle, std::min(end, split)));
+            misplaced += std::min(end, split) - middle;
         }
-        else if (plateauEnd != -1) {
-            break;
+        if (std::max(begin, split) < middle) {
+            misplacedLow.push_back(std::make_pair(std::max(begin, split), middle));
         }
     }
 
-    return plateauStart != -1 && plateauEnd != -1;
+    if (misplaced > 0) {
+        threadPool->parallelFor(misplaced, (misplaced + threads - 1) / threads, threads, [&](std::size_t first, std::size_t last) {
+            std::size_t high = 0, low = 0;
+            std::size_t highOffset = first, lowOffset = first;
+            while (highOffset >= misplacedHigh[high].second - misplacedHigh[high].first) {
+                highOffset -= misplacedHigh[high].second - misplacedHigh[high].first;
+                ++high;
+            }
+            while (lowOffset >= misplacedLow[low].second - misplacedLow[low].first) {
+                lowOffset -= misplacedLow[low].second - misplacedLow[low].first;
+                ++low;
+            }
+            for (std::size_t remaining = last - first; remaining > 0;) {
+                std::size_t step = std::min(remaining, std::min(
+                    misplacedHigh[high].second - misplacedHigh[high].first - highOffset,
+                    misplacedLow[low].second - misplacedLow[low].first - lowOffset));
+                T* highBegin = address + misplacedHigh[high].first + highOffset;
+                std::swap_ranges(highBegin, highBegin + step, address + misplacedLow[low].first + lowOffset);
+                remaining -= step;
+                highOffset += step;
+                lowOffset += step;
+                if (highOffset == misplacedHigh[high].second - misplacedHigh[high].first) {
+                    ++high;
+                    highOffset = 0;
+                }
+                if (lowOffset == misplacedLow[low].second - misplacedLow[low].first) {
+                    ++low;
+                    lowOffset = 0;
+                }
+            }
+        });
+    }
+    return split;
 }
 
 /**
- * @brief Checks if a memory block is a subsequence of another memory block.
+ * @brief Removes consecutive duplicate values from a sorted memory block.
  *
- * @details This function checks if the memory block 'subsequence' is a subsequence of the memory block 'sequence'.
- * If both blocks are valid (non-null and sizes greater than zero), the function returns true if 'subsequence'
- * is a subsequence of 'sequence'; otherwise, it returns false. If the inputs are invalid, it prints an error message
- * and returns false.
+ * @details This function removes consecutive duplicate values from a sorted memory block.
+ * If the address and size parameters are valid, the function performs the removal.
+ * The size parameter is updated to reflect the new size of the memory block.
+ * Otherwise, it prints an error message. Blocks of 32-bit integers are compacted with
+ * branch-free SIMD kernels.
  *
- * @param sequence A pointer to the sequence memory block.
- * @param seqSize The size of the sequence memory block.
- * @param subsequence A pointer to the subsequence memory block.
- * @param subseqSize The size of the subsequence memory block.
- * @return True if 'subsequence' is a subsequence of 'sequence', false otherwise or in case of invalid inputs.
+ * @param address A pointer to the start of the sorted memory block.
+ * @param size The size of the memory block.
+ * @return The new size of the memory block, or 0 if the operation is invalid.
  */
 template <typename T>
-inline bool MemoryManager<T>::isSubsequence(const T* sequence, int seqSize, const T* subsequence, int subseqSize) {
-    if (sequence == nullptr || subsequence == nullptr || seqSize < subseqSize || subseqSize <= 0) {
+inline int MemoryManager<T>::uniqueMemory(T* address, int& size) {
+    if (address != nullptr && size > 0) {
+        typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+        size = static_cast<int>(removeAdjacentDuplicates(address, size, IsInt32()));
+        return size;
+    }
+    else {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid isSubsequence operation." << std::endl;
+            std::cerr << "Invalid uniqueMemory operation." << std::endl;
 #endif
-        return false;
+        return 0;
     }
+}
 
-    return std::search(sequence, sequence + seqSize, subsequence, subsequence + subseqSize) != sequence + seqSize;
+/**
+ * @brief Removes all occurrences of a specified value from a memory block.
+ *
+ * @details This function removes all occurrences of a specified value from a memory block.
+ * If the address and size parameters are valid, the function performs the removal.
+ * The size parameter is updated to reflect the new size of the memory block.
+ * Otherwise, it prints an error message. Blocks of 32-bit integers are compacted with
+ * branch-free SIMD kernels.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param value The value to be removed from the memory block.
+ * @return The new size of the memory block, or 0 if the operation is invalid.
+ */
+template <typename T>
+inline int MemoryManager<T>::removeValue(T* address, int& size, int value) {
+    if (address != nullptr && size > 0) {
+        typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+        size = static_cast<int>(removeEqual(address, size, static_cast<T>(value), IsInt32()));
+        return size;
+    }
+    else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid removeValue operation." << std::endl;
+#endif
+        return 0;
+    }
 }
 
 /**
- * @brief Reverses portions of a memory block based on subblock sizes.
+ * @brief Removes all occurrences of a specified value from a memory block.
  *
- * @details This function reverses portions of the memory block 'address' based on the given subblock sizes.
- * If the block and subblock size array are valid (non-null and sizes greater than zero), the function performs
- * the reverse operation, preserving the order of subblocks. If the inputs are invalid, it prints an error message
- * and does nothing.
+ * @details This function removes all occurrences of a specified value from a memory block.
+ * If the address and size parameters are valid, the function performs the removal.
+ * The size parameter is updated to reflect the new size of the memory block.
+ * Otherwise, it prints an error message. Blocks of 32-bit integers are compacted with
+ * branch-free SIMD kernels.
  *
- * @param address A pointer to the memory block.
+ * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param subblockSizes An array containing the sizes of subblocks to be reversed.
- * @param numSubblocks The number of subblocks.
+ * @param value The value to be removed from the memory block.
+ * @return The new size of the memory block, or 0 if the operation is invalid.
  */
 template <typename T>
-inline void MemoryManager<T>::reverseMemoryWithPreservation(T* address, int size, const int* subblockSizes, int numSubblocks) {
-    if (address == nullptr || size <= 0 || subblockSizes == nullptr || numSubblocks <= 0) {
+inline int MemoryManager<T>::removeAllOccurrences(T* address, int& size, int value) {
+    if (address != nullptr && size > 0) {
+        typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+        size = static_cast<int>(removeEqual(address, size, static_cast<T>(value), IsInt32()));
+        return size;
+    }
+    else {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid reverseMemoryWithPreservation operation." << std::endl;
+            std::cerr << "Invalid removeAllOccurrences operation." << std::endl;
 #endif
-        return;
+        return 0;
     }
+}
 
-    int start = 0;
-    for (int i = 0; i < numSubblocks; ++i) {
-        int subblockSize = subblockSizes[i];
-        if (start + subblockSize <= size) {
-            std::reverse(address + start, address + start + subblockSize);
-            start += subblockSize;
+/**
+ * @brief Removes the elements matching a predicate from a memory block.
+ *
+ * @details This function removes every element for which the predicate returns true, keeping the
+ * order of the others. If the address and size parameters are valid, the function performs the removal.
+ * The size parameter is updated to reflect the new size of the memory block.
+ * Otherwise, it prints an error message. Blocks of 32-bit integers are compacted with a
+ * branch-free SIMD kernel, and the predicate is called exactly once per element.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param predicate A callable taking an element and returning true if it should be removed.
+ * @return The new size of the memory block, or 0 if the operation is invalid.
+ */
+template <typename T>
+template <typename Predicate>
+inline int MemoryManager<T>::removeIf(T* address, int& size, Predicate predicate) {
+    if (address != nullptr && size > 0) {
+        typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+        size = static_cast<int>(removeMatching(address, size, predicate, IsInt32()));
+        return size;
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid removeIf operation." << std::endl;
+#endif
+        return 0;
+    }
+}
+
+/**
+ * @brief Resizes a memory block and initializes the new elements with a default value.
+ *
+ * @details This function resizes a memory block and initializes the new elements with a default value.
+ * If the address parameter is valid and newSize is greater than the current size,
+ * the function resizes the memory block, filling the new elements with the specified defaultValue.
+ * If newSize is less than or equal to the current size, the size parameter is updated to newSize.
+ * Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The current size of the memory block.
+ * @param newSize The desired size of the memory block after resizing.
+ * @param defaultValue The value used to initialize new elements (if any).
+ */
+template <typename T>
+inline void MemoryManager<T>::resizeMemoryWithDefaultValue(T* address, int& size, int newSize, int defaultValue) {
+    if (address != nullptr && newSize > 0) {
+        if (newSize > size) {
+            address = resizeMemory(address, newSize);
+            std::fill(address + size, address + newSize, defaultValue);
         }
         else {
+            size = newSize;
+        }
+    }
+    else {
 #ifdef DEBUG_MODE
-            std::cerr << "Invalid subblock size at index " << i << "." << std::endl;
+            std::cerr << "Invalid resizeMemoryWithDefaultValue operation." << std::endl;
 #endif
-            return;
-        }
     }
 }
 
 /**
- * @brief Checks if a memory block forms a mountain shape.
+ * @brief Checks if a memory block is null.
  *
- * @details This function checks if the memory block 'address' forms a mountain shape,
- * i.e., has a peak greater than its neighbors. If the block is valid (non-null and size greater than two),
- * the function returns true if a mountain is found, and it sets 'peakIndex' to the index of the peak.
- * If no mountain is found, 'peakIndex' is set to -1. If the input is invalid, it prints an error message
- * and returns false.
+ * @details This function checks if a memory block is null.
  *
- * @param address A pointer to the memory block.
+ * @param address A pointer to the start of the memory block.
+ * @return True if the memory block is null, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryNull(const T* address) {
+    return (address == nullptr);
+}
+
+/**
+ * @brief Checks if a memory block is allocated.
+ *
+ * @details This function checks if a memory block is allocated.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @return True if the memory block is allocated, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryAllocated(const T* address) {
+    return (address != nullptr);
+}
+
+/**
+ * @brief Checks if a memory block is fully initialized with non-zero values.
+ *
+ * @details This function checks if a memory block is fully initialized with non-zero values.
+ * If the address and size parameters are valid, the function performs the check.
+ * Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
  * @param size The size of the memory block.
- * @param peakIndex Reference to store the index of the peak.
- * @return True if the memory block forms a mountain shape, false otherwise or in case of invalid input.
+ * @return True if the memory block is fully initialized, false otherwise.
  */
 template <typename T>
-inline bool MemoryManager<T>::isMemoryMountain(const T* address, int size, int& peakIndex) {
-    if (address == nullptr || size <= 2) {
+inline bool MemoryManager<T>::isMemoryInitialized(const T* address, int size) {
+    if (address == nullptr || size <= 0) {
 #ifdef DEBUG_MODE
-        std::cerr << "Invalid isMemoryMountain operation." << std::endl;
+            std::cerr << "Invalid isMemoryInitialized check: Null pointer or invalid size." << std::endl;
 #endif
-        return false;
-    }
-
-    peakIndex = -1;
 
-    for (int i = 1; i < size - 1; ++i) {
-        if (address[i] > address[i - 1] && address[i] > address[i + 1]) {
-            peakIndex = i;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    return !std::any_of(address, address + size, [](const T& value) { return value == 0; });
 }
 
+/**
+ * @brief Checks if a memory block is empty.
+ *
+ * @details This function checks if a memory block is empty by verifying that all elements are zero.
+ * If the address and size parameters are valid, the function performs the check.
+ * Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is empty, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryEmpty(const T* address, int size) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryEmpty check: Null pointer or invalid size." << std::endl;
+#endif
+
+        return false;
+    }
+
+    return std::all_of(address, address + size, [](const T& value) { return value == 0; });
+}
+
+/**
+ * @brief Checks if a memory block is readable.
+ *
+ * @details This function checks if a memory block is readable.
+ * If the address parameter is valid and size is greater than zero, the function returns true.
+ * Otherwise, it prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is readable, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryReadable(const T* address, int size) {
+    if (address == nullptr) {
+        #ifdef DEBUG_MODE
+            std::cerr << "Invalid isMemoryReadable check: Null pointer." << std::endl;
+        #endif
+
+        return false;
+    }
+
+    if (size <= 0) {
+        #ifdef DEBUG_MODE
+            std::cerr << "Invalid isMemoryReadable check: Invalid size." << std::endl;
+        #endif
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks if a memory block is writable.
+ *
+ * @details This function checks if a memory block is writable.
+ * If the address parameter is valid and size is greater than zero, the function returns true.
+ * Otherwise, it prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is writable, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryWritable(T* address, int size) {
+    if (address == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryWritable check: Null pointer." << std::endl;
+#endif
+        return false;
+    }
+
+    if (size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryWritable check: Invalid size." << std::endl;
+#endif
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Swaps adjacent values in a memory block.
+ *
+ * @details This function swaps adjacent values in a memory block.
+ * If the address parameter is valid and size is greater than one, the function performs the swap.
+ * Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ */
+template <typename T>
+inline void MemoryManager<T>::swapAdjacentValues(T* address, int size) {
+    if (address != nullptr && size > 1) {
+        for (int i = 0; i < size - 1; i += 2) {
+            std::swap(address[i], address[i + 1]);
+        }
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid swapAdjacentValues operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Replaces occurrences of a value in a memory block.
+ *
+ * @details This function replaces occurrences of a specified old value with a new value in a memory block.
+ * If the address parameter is valid and size is greater than zero, the function performs the replacement.
+ * Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param oldValue The value to be replaced.
+ * @param newValue The new value to replace the old value.
+ */
+template <typename T>
+inline void MemoryManager<T>::replaceValue(T* address, int size, int oldValue, int newValue) {
+    if (address != nullptr && size > 0) {
+        std::replace(address, address + size, oldValue, newValue);
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid replaceValue operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Merges two sorted memory blocks into a new sorted block.
+ *
+ * @details This function merges two sorted memory blocks into a new sorted block.
+ * If both input blocks are valid (non-null and non-empty), the function performs the merge.
+ * Equal elements keep their order, with those of block1 placed first.
+ * Otherwise, it prints an error message and returns a null pointer.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @return A pointer to the newly merged sorted memory block, or nullptr if there are invalid inputs.
+ */
+template <typename T>
+inline T* MemoryManager<T>::mergeSortedMemory(const T* block1, int size1, const T* block2, int size2) {
+    if (block1 == nullptr || size1 <= 0 || block2 == nullptr || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid mergeSortedMemory operation: Null or empty blocks." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    T* mergedBlock = allocateMemory(size1 + size2);
+    if (mergedBlock != nullptr) {
+        std::merge(block1, block1 + size1, block2, block2 + size2, mergedBlock);
+    }
+
+    return mergedBlock;
+}
+
+
+/**
+ * @brief Checks if a memory block is a palindrome.
+ *
+ * @details This function checks if a memory block is a palindrome.
+ * If the address parameter is valid and size is greater than zero, the function performs the check.
+ * Otherwise, it prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is a palindrome, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryPalindrome(const T* address, int size) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryPalindrome operation: Null or empty block." << std::endl;
+#endif
+        return false;
+    }
+
+    int halfSize = size / 2;
+    for (int i = 0; i < halfSize; ++i) {
+        if (address[i] != address[size - 1 - i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Performs binary search on a sorted memory block.
+ *
+ * @details This function performs binary search on a sorted memory block to find the target value.
+ * If the sortedBlock parameter is valid (non-null and non-empty), the function returns the index of the first
+ * element equal to the target. If the target is not found, it returns -1. If the inputs are invalid, it prints
+ * an error message and returns -1. The search runs on the branchless lower bound used by lowerBound.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param target The value to search for.
+ * @return The index of the target value if found, -1 otherwise.
+ */
+template <typename T>
+inline int MemoryManager<T>::binarySearch(const T* sortedBlock, int size, int target) {
+    if (sortedBlock == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid binarySearch operation: Null or empty sorted block." << std::endl;
+#endif
+        return -1;
+    }
+
+    T key = static_cast<T>(target);
+    std::size_t index = branchlessBound<false>(sortedBlock, static_cast<std::size_t>(size), key);
+    if (index < static_cast<std::size_t>(size) && !(key < sortedBlock[index])) {
+        return static_cast<int>(index);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Rotates a specified range of a memory block to the left by a given shift count.
+ *
+ * @details This function rotates a specified range of a memory block to the left by a given shift count.
+ * If the address parameter is valid and the start, end, and shiftCount parameters are within bounds,
+ * the function performs the rotation. Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param start The start index of the range to rotate.
+ * @param end The end index of the range to rotate.
+ * @param shiftCount The number of positions to rotate the range to the left.
+ */
+template <typename T>
+inline void MemoryManager<T>::rotateMemoryRangeLeft(T* address, int start, int end, int shiftCount) {
+    if (address != nullptr && start >= 0 && start < end) {
+        rotateRange(address + start, end - start + 1, normalizeShift(shiftCount, end - start + 1));
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid rotateMemoryRangeLeft operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Rotates a specified range of a memory block to the right by a given shift count.
+ *
+ * @details This function rotates a specified range of a memory block to the right by a given shift count.
+ * If the address parameter is valid and the start, end, and shiftCount parameters are within bounds,
+ * the function performs the rotation. Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param start The start index of the range to rotate.
+ * @param end The end index of the range to rotate.
+ * @param shiftCount The number of positions to rotate the range to the right.
+ */
+template <typename T>
+inline void MemoryManager<T>::rotateMemoryRangeRight(T* address, int start, int end, int shiftCount) {
+    if (address != nullptr && start >= 0 && start < end) {
+        std::size_t rightShift = normalizeShift(shiftCount, end - start + 1);
+        rotateRange(address + start, end - start + 1, rightShift == 0 ? 0 : end - start + 1 - rightShift);
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid rotateMemoryRangeRight operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Swaps adjacent memory ranges in a memory block.
+ *
+ * @details This function swaps adjacent memory ranges in a memory block. The second range must start
+ * right after the first one ends, but the two ranges may differ in length: the swap is a rotation of
+ * both ranges by the length of the first one. If the address parameter is valid and the ranges are
+ * adjacent, the function performs the swap. Otherwise, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param range1Start The start index of the first range to swap.
+ * @param range1End The end index of the first range to swap.
+ * @param range2Start The start index of the second range to swap.
+ * @param range2End The end index of the second range to swap.
+ */
+template <typename T>
+inline void MemoryManager<T>::swapAdjacentMemoryRanges(T* address, int range1Start, int range1End, int range2Start, int range2End) {
+    if (address != nullptr && range1Start >= 0 && range1Start <= range1End &&
+        range2Start == range1End + 1 && range2Start <= range2End) {
+        rotateRange(address + range1Start, range2End - range1Start + 1, range1End - range1Start + 1);
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid swapAdjacentMemoryRanges operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Performs three-way partitioning on a memory block based on a pivot value.
+ *
+ * @details This function performs three-way partitioning on a memory block based on a pivot value.
+ * If the address parameter is valid and the size is greater than zero, the function partitions the block.
+ * It updates the lowerBound and upperBound parameters to indicate the resulting partitions.
+ * The block is split with two partitionMemory passes, first around the values below the pivot
+ * and then around the values equal to it, so each part keeps its original order.
+ * If the inputs are invalid, it prints an error message.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivotValue The pivot value for partitioning.
+ * @param lowerBound Reference to the lower bound of the partition with values less than the pivot.
+ * @param upperBound Reference to the upper bound of the partition with values greater than the pivot.
+ */
+template <typename T>
+inline void MemoryManager<T>::threeWayPartition(T* address, int size, int pivotValue, int& lowerBound, int& upperBound) {
+    threeWayPartition(address, size, pivotValue, lowerBound, upperBound, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Computes the union of two sorted memory blocks.
+ *
+ * @details This function computes the union of two sorted memory blocks, removing duplicate elements.
+ * If the input blocks are valid (non-null and sizes greater than zero), the function returns a new memory block
+ * containing the union and sets the unionSize parameter to the size of the union. The block is allocated once
+ * with room for size1 + size2 elements and written directly. If the inputs are invalid,
+ * it prints an error message, sets unionSize to 0, and returns a null pointer.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param unionSize Reference to store the size of the resulting union.
+ * @return A pointer to the memory block containing the union, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::unionSortedMemory(const T* block1, int size1, const T* block2, int size2, int& unionSize) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid unionSortedMemory operation." << std::endl;
+#endif
+
+        unionSize = 0;
+        return nullptr;
+    }
+
+    T* unionMemory = allocateMemory(size1 + size2);
+    unionSize = unionMemory != nullptr ? static_cast<int>(sortedSetKernel(SetUnion, block1, size1, block2, size2, unionMemory)) : 0;
+
+    return unionMemory;
+}
+
+
+/**
+ * @brief Computes the difference of two sorted memory blocks.
+ *
+ * @details This function computes the difference of two sorted memory blocks, removing common elements.
+ * If the input blocks are valid (non-null and sizes greater than zero), the function returns a new memory block
+ * containing the difference and sets the differenceSize parameter to the size of the difference.
+ * The block is allocated once with room for size1 elements and written directly.
+ * If the inputs are invalid, it prints an error message, sets differenceSize to 0, and returns a null pointer.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param differenceSize Reference to store the size of the resulting difference.
+ * @return A pointer to the memory block containing the difference, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::differenceSortedMemory(const T* block1, int size1, const T* block2, int size2, int& differenceSize) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid differenceSortedMemory operation." << std::endl;
+#endif
+        differenceSize = 0;
+        return nullptr;
+    }
+
+    T* differenceMemory = allocateMemory(size1);
+    differenceSize = differenceMemory != nullptr ? static_cast<int>(sortedSetKernel(SetDifference, block1, size1, block2, size2, differenceMemory)) : 0;
+
+    return differenceMemory;
+}
+
+
+/**
+ * @brief Computes the symmetric difference of two sorted memory blocks.
+ *
+ * @details This function computes the symmetric difference of two sorted memory blocks,
+ * removing elements common to both blocks. If the input blocks are valid (non-null and sizes greater than zero),
+ * the function returns a new memory block containing the symmetric difference and sets the symDiffSize parameter
+ * to the size of the symmetric difference. The block is allocated once with room for size1 + size2 elements
+ * and written directly. If the inputs are invalid, it prints an error message,
+ * sets symDiffSize to 0, and returns a null pointer.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param symDiffSize Reference to store the size of the resulting symmetric difference.
+ * @return A pointer to the memory block containing the symmetric difference, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::symmetricDifferenceSortedMemory(const T* block1, int size1, const T* block2, int size2, int& symDiffSize) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid symmetricDifferenceSortedMemory operation." << std::endl;
+#endif
+        symDiffSize = 0;
+        return nullptr;
+    }
+
+    T* symDiffMemory = allocateMemory(size1 + size2);
+    symDiffSize = symDiffMemory != nullptr ? static_cast<int>(sortedSetKernel(SetSymmetricDifference, block1, size1, block2, size2, symDiffMemory)) : 0;
+
+    return symDiffMemory;
+}
+
+
+/**
+ * @brief Checks if a memory block is a subset of another sorted memory block.
+ *
+ * @details This function checks if the memory block 'potentialSubset' is a subset of the sorted memory block 'set'.
+ * If both blocks are valid (non-null and sizes greater than zero), the function returns true if 'potentialSubset'
+ * is a subset of 'set'; otherwise, it returns false. Every element of 'potentialSubset' is located with a galloping
+ * search starting after the previous match, so a small subset of a large set costs O(m log(n / m)) comparisons.
+ * Repeated elements must be matched by as many copies in 'set', as with std::includes. If the inputs are invalid,
+ * it prints an error message and returns false.
+ *
+ * @param potentialSubset A pointer to the potential subset memory block.
+ * @param subsetSize The size of the potential subset memory block.
+ * @param set A pointer to the sorted memory block.
+ * @param setSize The size of the sorted memory block.
+ * @return True if 'potentialSubset' is a subset of 'set', false otherwise or in case of invalid inputs.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isSubsetSortedMemory(const T* potentialSubset, int subsetSize, const T* set, int setSize) {
+    if (potentialSubset == nullptr || subsetSize <= 0 || set == nullptr || setSize <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isSubsetSortedMemory operation." << std::endl;
+#endif
+        return false;
+    }
+
+    if (subsetSize > setSize) {
+        return false;
+    }
+
+    std::size_t position = 0;
+    for (int i = 0; i < subsetSize; ++i) {
+        position = gallopLowerBound(set, position, setSize, potentialSubset[i]);
+        if (position == static_cast<std::size_t>(setSize) || potentialSubset[i] < set[position]) {
+            return false;
+        }
+        ++position;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks if a memory block is strictly increasing.
+ *
+ * @details This function checks if the memory block 'address' is strictly increasing.
+ * If the block is valid (non-null and size greater than zero), the function returns true if the elements
+ * are strictly increasing; otherwise, it returns false. If the input is invalid, it prints an error message
+ * and returns false.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is strictly increasing, false otherwise or in case of invalid input.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryStrictlyIncreasing(const T* address, int size) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryStrictlyIncreasing operation." << std::endl;
+#endif
+        return false;
+    }
+
+    return std::is_sorted(address, address + size) && std::adjacent_find(address, address + size, std::greater<int>()) == address + size;
+}
+
+/**
+ * @brief Checks if a memory block is strictly decreasing.
+ *
+ * @details This function checks if the memory block 'address' is strictly decreasing.
+ * If the block is valid (non-null and size greater than zero), the function returns true if the elements
+ * are strictly decreasing; otherwise, it returns false. If the input is invalid, it prints an error message
+ * and returns false.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @return True if the memory block is strictly decreasing, false otherwise or in case of invalid input.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryStrictlyDecreasing(const T* address, int size) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryStrictlyDecreasing operation." << std::endl;
+#endif
+        return false;
+    }
+
+    return std::is_sorted(address, address + size, std::greater<int>()) && std::adjacent_find(address, address + size, std::less<int>()) == address + size;
+}
+
+/**
+ * @brief Checks if a memory block has a plateau.
+ *
+ * @details This function checks if the memory block 'address' has a plateau,
+ * i.e., a contiguous sequence of equal values. If the block is valid (non-null and size greater than zero),
+ * the function returns true if there is a plateau, and it sets 'plateauStart' and 'plateauEnd' to the start and end
+ * indices of the plateau. If there is no plateau, both indices are set to -1. If the input is invalid, it prints
+ * an error message and returns false.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @param plateauStart Reference to store the start index of the plateau.
+ * @param plateauEnd Reference to store the end index of the plateau.
+ * @return True if the memory block has a plateau, false otherwise or in case of invalid input.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryPlateau(const T* address, int size, int& plateauStart, int& plateauEnd) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryPlateau operation." << std::endl;
+#endif
+        return false;
+    }
+
+    plateauStart = plateauEnd = -1;
+
+    for (int i = 1; i < size; ++i) {
+        if (address[i] == address[i - 1]) {
+            if (plateauStart == -1) {
+                plateauStart = i - 1;
+            }
+            plateauEnd = i;
+        }
+        else if (plateauEnd != -1) {
+            break;
+        }
+    }
+
+    return plateauStart != -1 && plateauEnd != -1;
+}
+
+/**
+ * @brief Checks if a memory block is a subsequence of another memory block.
+ *
+ * @details This function checks if the memory block 'subsequence' is a subsequence of the memory block 'sequence'.
+ * If both blocks are valid (non-null and sizes greater than zero), the function returns true if 'subsequence'
+ * is a subsequence of 'sequence'; otherwise, it returns false. If the inputs are invalid, it prints an error message
+ * and returns false.
+ *
+ * @param sequence A pointer to the sequence memory block.
+ * @param seqSize The size of the sequence memory block.
+ * @param subsequence A pointer to the subsequence memory block.
+ * @param subseqSize The size of the subsequence memory block.
+ * @return True if 'subsequence' is a subsequence of 'sequence', false otherwise or in case of invalid inputs.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isSubsequence(const T* sequence, int seqSize, const T* subsequence, int subseqSize) {
+    if (sequence == nullptr || subsequence == nullptr || seqSize < subseqSize || subseqSize <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isSubsequence operation." << std::endl;
+#endif
+        return false;
+    }
+
+    return std::search(sequence, sequence + seqSize, subsequence, subsequence + subseqSize) != sequence + seqSize;
+}
+
+/**
+ * @brief Reverses portions of a memory block based on subblock sizes.
+ *
+ * @details This function reverses portions of the memory block 'address' based on the given subblock sizes.
+ * If the block and subblock size array are valid (non-null and sizes greater than zero), the function performs
+ * the reverse operation, preserving the order of subblocks. If the inputs are invalid, it prints an error message
+ * and does nothing.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @param subblockSizes An array containing the sizes of subblocks to be reversed.
+ * @param numSubblocks The number of subblocks.
+ */
+template <typename T>
+inline void MemoryManager<T>::reverseMemoryWithPreservation(T* address, int size, const int* subblockSizes, int numSubblocks) {
+    if (address == nullptr || size <= 0 || subblockSizes == nullptr || numSubblocks <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid reverseMemoryWithPreservation operation." << std::endl;
+#endif
+        return;
+    }
+
+    int start = 0;
+    for (int i = 0; i < numSubblocks; ++i) {
+        int subblockSize = subblockSizes[i];
+        if (start + subblockSize <= size) {
+            std::reverse(address + start, address + start + subblockSize);
+            start += subblockSize;
+        }
+        else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid subblock size at index " << i << "." << std::endl;
+#endif
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Checks if a memory block forms a mountain shape.
+ *
+ * @details This function checks if the memory block 'address' forms a mountain shape,
+ * i.e., has a peak greater than its neighbors. If the block is valid (non-null and size greater than two),
+ * the function returns true if a mountain is found, and it sets 'peakIndex' to the index of the peak.
+ * If no mountain is found, 'peakIndex' is set to -1. If the input is invalid, it prints an error message
+ * and returns false.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @param peakIndex Reference to store the index of the peak.
+ * @return True if the memory block forms a mountain shape, false otherwise or in case of invalid input.
+ */
+template <typename T>
+inline bool MemoryManager<T>::isMemoryMountain(const T* address, int size, int& peakIndex) {
+    if (address == nullptr || size <= 2) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid isMemoryMountain operation." << std::endl;
+#endif
+        return false;
+    }
+
+    peakIndex = -1;
+
+    for (int i = 1; i < size - 1; ++i) {
+        if (address[i] > address[i - 1] && address[i] > address[i + 1]) {
+            peakIndex = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Creates a policy that runs an operation on the calling thread.
+ *
+ * @return A sequential execution policy.
+ */
+inline ExecutionPolicy ExecutionPolicy::sequential() {
+    ExecutionPolicy policy;
+    policy.mode = ExecutionMode::Sequential;
+    policy.threadCount = 1;
+    return policy;
+}
+
+/**
+ * @brief Creates a policy that splits an operation across the thread pool.
+ *
+ * @details A threadCount of 0 uses every thread of the pool plus the calling thread.
+ * A non-zero threadCount caps the number of threads taking part, including the calling thread.
+ *
+ * @param threadCount The maximum number of threads to use, or 0 for all of them.
+ * @return A parallel execution policy.
+ */
+inline ExecutionPolicy ExecutionPolicy::parallel(unsigned int threadCount) {
+    ExecutionPolicy policy;
+    policy.mode = ExecutionMode::Parallel;
+    policy.threadCount = threadCount;
+    return policy;
+}
+
+/**
+ * @brief Constructs a ThreadPool and starts its worker threads.
+ *
+ * @details Every worker owns a deque of tasks. Tasks submitted from a worker go to the back of its own
+ * deque and are popped from there, which keeps freshly forked work hot in that core's cache. Idle workers
+ * steal from the front of the other deques. The calling thread takes part in parallelFor and
+ * TaskGroup::wait, so a pool created with a threadCount of 0 starts one worker less than the number
+ * of hardware threads.
+ *
+ * @param threadCount The number of worker threads to start, or 0 to size the pool from the hardware.
+ * @param pinThreads If true, worker i is pinned to core i + 1, leaving core 0 to the calling thread.
+ */
+inline ThreadPool::ThreadPool(unsigned int threadCount, bool pinThreads)
+    : pendingTasks(0), nextQueue(0), stopping(false) {
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this, i, pinThreads]() {
+            if (pinThreads) {
+                pinCurrentThread(i + 1);
+            }
+            workerLoop(i);
+        });
+    }
+}
+
+/**
+ * @brief Stops the worker threads after the queued tasks have run.
+ */
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns the number of worker threads owned by the pool.
+ *
+ * @return The number of worker threads, not counting the calling thread.
+ */
+inline unsigned int ThreadPool::getThreadCount() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+/**
+ * @brief Queues a task for execution on the pool.
+ *
+ * @details A task submitted from one of the pool's workers is pushed onto that worker's own deque.
+ * Tasks from other threads are spread over the worker deques in turn. A pool without workers runs
+ * the task immediately on the calling thread.
+ *
+ * @param task The task to run.
+ */
+inline void ThreadPool::submit(std::function<void()> task) {
+    if (queues.empty()) {
+        task();
+        return;
+    }
+
+    WorkerContext& context = currentWorker();
+    unsigned int index = context.pool == this
+        ? context.index
+        : nextQueue.fetch_add(1) % static_cast<unsigned int>(queues.size());
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    pendingTasks.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+/**
+ * @brief Runs one queued task on the calling thread, if there is one.
+ *
+ * @details Workers look at their own deque first. Any other thread steals from the front of the
+ * worker deques. This lets a thread that is waiting for results help with the work instead of blocking.
+ *
+ * @return True if a task was run, false if no task was available.
+ */
+inline bool ThreadPool::runPendingTask() {
+    if (pendingTasks.load() == 0) {
+        return false;
+    }
+
+    WorkerContext& context = currentWorker();
+    std::function<void()> task;
+    bool found = context.pool == this
+        ? popTask(context.index, task) || stealTask(context.index, task)
+        : stealTask(static_cast<unsigned int>(queues.size()), task);
+
+    if (!found) {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+/**
+ * @brief Runs body over [0, count) split into chunks of grainSize elements.
+ *
+ * @details Chunks are handed out through a shared counter, so threads that finish early pick up
+ * the remaining chunks. Up to maxThreads - 1 helper tasks are forked into a TaskGroup, and the
+ * calling thread works on chunks as well before joining the group.
+ *
+ * @param count The number of elements to process.
+ * @param grainSize The number of elements handed to body at a time.
+ * @param maxThreads The maximum number of threads to use including the caller, or 0 for all of them.
+ * @param body The function called with the [begin, end) range of each chunk.
+ */
+inline void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize, unsigned int maxThreads,
+    const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<std::size_t>(grainSize, 1);
+    std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    std::size_t threads = workers.size() + 1;
+    if (maxThreads != 0) {
+        threads = std::min<std::size_t>(threads, maxThreads);
+    }
+    threads = std::min(threads, chunkCount);
+
+    if (threads <= 1) {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<std::size_t> nextChunk(0);
+    auto runChunks = [&nextChunk, &body, count, grainSize, chunkCount]() {
+        std::size_t chunk;
+        while ((chunk = nextChunk.fetch_add(1)) < chunkCount) {
+            std::size_t begin = chunk * grainSize;
+            body(begin, std::min(begin + grainSize, count));
+        }
+    };
+
+    TaskGroup group(*this);
+    for (std::size_t i = 0; i + 1 < threads; ++i) {
+        group.run(runChunks);
+    }
+    runChunks();
+    group.wait();
+}
+
+/**
+ * @brief Returns the process-wide pool shared by MemoryManager instances by default.
+ *
+ * @return A shared pointer to the default ThreadPool, created on first use.
+ */
+inline std::shared_ptr<ThreadPool> ThreadPool::getDefault() {
+    static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>();
+    return pool;
+}
+
+/**
+ * @brief Executes tasks until the pool is stopped and every queued task has run.
+ *
+ * @details An idle worker spins for a short while before going to sleep, so that tasks forked in
+ * quick succession are picked up without the latency of a condition variable wake-up.
+ *
+ * @param index The index of the worker's own deque.
+ */
+inline void ThreadPool::workerLoop(unsigned int index) {
+    const int spinCount = 256;
+
+    currentWorker().pool = this;
+    currentWorker().index = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (popTask(index, task) || stealTask(index, task)) {
+            task();
+            continue;
+        }
+
+        bool found = false;
+        for (int spin = 0; spin < spinCount && !found; ++spin) {
+            if (pendingTasks.load() != 0) {
+                found = popTask(index, task) || stealTask(index, task);
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+        if (found) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() { return stopping.load() || pendingTasks.load() != 0; });
+        if (stopping.load() && pendingTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Pops the most recently pushed task from a worker's own deque.
+ *
+ * @param index The index of the worker's deque.
+ * @param task Receives the task if one was available.
+ * @return True if a task was popped, false if the deque was empty.
+ */
+inline bool ThreadPool::popTask(unsigned int index, std::function<void()>& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    pendingTasks.fetch_sub(1);
+    return true;
+}
+
+/**
+ * @brief Steals the oldest task from another worker's deque.
+ *
+ * @details Victims are visited starting after the thief, so that thieves spread out over the
+ * deques instead of all contending for the first one.
+ *
+ * @param thiefIndex The index of the stealing worker, or the number of deques for outside threads.
+ * @param task Receives the task if one was stolen.
+ * @return True if a task was stolen, false if every other deque was empty.
+ */
+inline bool ThreadPool::stealTask(unsigned int thiefIndex, std::function<void()>& task) {
+    std::size_t queueCount = queues.size();
+    for (std::size_t offset = 1; offset <= queueCount; ++offset) {
+        std::size_t victim = (thiefIndex + offset) % queueCount;
+        if (victim == thiefIndex) {
+            continue;
+        }
+
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the pool and deque index of the calling thread.
+ *
+ * @return The calling thread's worker context; its pool is null for threads outside any pool.
+ */
+inline ThreadPool::WorkerContext& ThreadPool::currentWorker() {
+    static thread_local WorkerContext context = { nullptr, 0 };
+    return context;
+}
+
+/**
+ * @brief Pins the calling thread to a core.
+ *
+ * @details Cores past the number of hardware threads wrap around. On platforms without an
+ * affinity API the thread is left unpinned.
+ *
+ * @param core The index of the core to pin to.
+ */
+inline void ThreadPool::pinCurrentThread(unsigned int core) {
+    unsigned int hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    core %= hardwareThreads;
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    (void)core;
+#endif
+}
+
+/**
+ * @brief Constructs an empty TaskGroup that forks tasks onto the given pool.
+ *
+ * @param pool The pool to run the group's tasks on.
+ */
+inline TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), pendingTasks(0) {
+}
+
+/**
+ * @brief Waits for the group's outstanding tasks before destroying it.
+ *
+ * @details An exception thrown by a task that was never collected by wait() is dropped here, since a
+ * destructor must not throw.
+ */
+inline TaskGroup::~TaskGroup() {
+    join();
+}
+
+/**
+ * @brief Forks a task into the group.
+ *
+ * @details The task is wrapped so that the group is told about its completion on every path. An
+ * exception thrown by the task is captured and rethrown from wait(). If the task cannot be queued, for
+ * example because copying it throws std::bad_alloc, it is taken off the group's count again so that wait()
+ * does not block on it, and the exception propagates to the caller.
+ *
+ * @param task The task to run.
+ */
+inline void TaskGroup::run(std::function<void()> task) {
+    pendingTasks.fetch_add(1);
+    TaskGroup* group = this;
+    try {
+        pool.submit([task, group]() {
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            group->finishTask(error);
+        });
+    } catch (...) {
+        finishTask(std::exception_ptr());
+        throw;
+    }
+}
+
+/**
+ * @brief Joins every task forked into the group.
+ *
+ * @details The waiting thread runs queued tasks of the pool while it waits, so nested fork/join from
+ * inside a task cannot exhaust the workers. When nothing is queued it blocks until one of the group's
+ * tasks completes, instead of spinning.
+ *
+ * @throws The first exception thrown by any of the group's tasks, once every task has finished.
+ */
+inline void TaskGroup::wait() {
+    join();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        error = firstError;
+        firstError = std::exception_ptr();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Blocks until the group has no outstanding tasks, helping the pool in the meantime.
+ *
+ * @details The timed sleep bounds how long a queued task, forked after the last check, waits for the
+ * joining thread to pick it up. Completion of a group task wakes the joiner immediately.
+ */
+inline void TaskGroup::join() {
+    while (pendingTasks.load() != 0) {
+        if (pool.runPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait_for(lock, std::chrono::microseconds(100), [this]() {
+            return pendingTasks.load() == 0;
+        });
+    }
+
+    // The last finishTask may still hold the mutex after the count reached zero; the group must not be
+    // destroyed before it lets go.
+    std::lock_guard<std::mutex> lock(doneMutex);
+}
+
+/**
+ * @brief Records the completion of one of the group's tasks.
+ *
+ * @param error The exception thrown by the task, or a null pointer if it returned normally.
+ */
+inline void TaskGroup::finishTask(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(doneMutex);
+    if (error && !firstError) {
+        firstError = error;
+    }
+    pendingTasks.fetch_sub(1);
+    doneCondition.notify_all();
+}
+
+/**
+ * @brief Sets the thread pool used by the parallel operations.
+ *
+ * @details A null pool restores the process-wide default pool.
+ *
+ * @param pool The thread pool to run parallel operations on.
+ */
+template <typename T>
+inline void MemoryManager<T>::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    threadPool = pool ? pool : ThreadPool::getDefault();
+}
+
+/**
+ * @brief Returns the thread pool used by the parallel operations.
+ *
+ * @return A shared pointer to the manager's thread pool.
+ */
+template <typename T>
+inline std::shared_ptr<ThreadPool> MemoryManager<T>::getThreadPool() const {
+    return threadPool;
+}
+
+/**
+ * @brief Returns how many threads an operation on size elements should use under a policy.
+ *
+ * @details Blocks smaller than 1 MiB always run on the calling thread, because waking other
+ * threads costs more than the work. Otherwise the policy's thread count is capped by the number
+ * of pool workers plus the calling thread.
+ *
+ * @param size The number of elements the operation processes.
+ * @param policy The execution policy to apply.
+ * @return The number of threads to use, at least 1.
+ */
+template <typename T>
+inline unsigned int MemoryManager<T>::parallelThreadCount(int size, const ExecutionPolicy& policy) const {
+    const std::size_t parallelThresholdBytes = 1 << 20;
+
+    std::size_t bytes = static_cast<std::size_t>(size) * sizeof(T);
+    if (policy.mode == ExecutionMode::Sequential || bytes < parallelThresholdBytes) {
+        return 1;
+    }
+
+    unsigned int available = threadPool->getThreadCount() + 1;
+    return policy.threadCount == 0 ? available : std::min(policy.threadCount, available);
+}
+
+/**
+ * @brief Runs body over [0, size) either inline or split across the manager's thread pool.
+ *
+ * @details Parallel runs cut the block into 256 KiB chunks, which keeps each chunk resident in
+ * a core's L2 cache while it is processed.
+ *
+ * @param size The number of elements to process.
+ * @param policy The execution policy to apply.
+ * @param body The function called with the [begin, end) range of each chunk.
+ */
+template <typename T>
+template <typename Function>
+inline void MemoryManager<T>::runParallel(int size, const ExecutionPolicy& policy, Function body) {
+    const std::size_t chunkBytes = 1 << 18;
+
+    unsigned int threads = parallelThreadCount(size, policy);
+    if (threads <= 1) {
+        body(0, static_cast<std::size_t>(size));
+        return;
+    }
+
+    std::size_t grainSize = std::max<std::size_t>(chunkBytes / sizeof(T), 1);
+    threadPool->parallelFor(static_cast<std::size_t>(size), grainSize, threads, body);
+}
+
+/**
+ * @brief Encrypts a memory block in place with ChaCha20 using an execution policy.
+ *
+ * @details This overload behaves like encryptMemory, but a parallel policy splits large blocks into 256 KiB
+ * chunks that are encrypted concurrently. Every chunk starts on a keystream block boundary and derives its
+ * counter from its offset, so the result does not depend on the policy.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter of the first 64 bytes.
+ * @param policy The execution policy to apply.
+ * @return True if the block was encrypted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::encryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter,
+    const ExecutionPolicy& policy) {
+    const std::size_t chunkBytes = 1 << 18;
+
+    std::size_t length = static_cast<std::size_t>(std::max(size, 0)) * sizeof(T);
+    std::uint64_t blocks = (static_cast<std::uint64_t>(length) + ChaCha20::BlockSize - 1) / ChaCha20::BlockSize;
+    if (address == nullptr || size <= 0 || key == nullptr || nonce == nullptr || counter + blocks > (std::uint64_t(1) << 32)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid encryptMemory operation." << std::endl;
+#endif
+        return false;
+    }
+
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(address);
+    auto body = [bytes, key, nonce, counter](std::size_t begin, std::size_t end) {
+        ChaCha20::xorKeystream(key, nonce, counter + static_cast<std::uint32_t>(begin / ChaCha20::BlockSize), bytes + begin, end - begin);
+    };
+
+    unsigned int threads = parallelThreadCount(size, policy);
+    if (threads <= 1) {
+        body(0, length);
+    }
+    else {
+        threadPool->parallelFor(length, chunkBytes, threads, body);
+    }
+    return true;
+}
+
+/**
+ * @brief Decrypts a memory block encrypted with ChaCha20 using an execution policy.
+ *
+ * @details This overload behaves like decryptMemory, but a parallel policy decrypts large blocks in concurrent
+ * chunks as encryptMemory does.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter of the first 64 bytes.
+ * @param policy The execution policy to apply.
+ * @return True if the block was decrypted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decryptMemory(T* address, int size, const unsigned char* key, const unsigned char* nonce, std::uint32_t counter,
+    const ExecutionPolicy& policy) {
+    return encryptMemory(address, size, key, nonce, counter, policy);
+}
+
+/**
+ * @brief Encrypts a memory block in place with AES-CTR using an execution policy.
+ *
+ * @details This overload behaves like the AES encryptMemory, but a parallel policy splits large blocks into
+ * 256 KiB chunks that are encrypted concurrently, each starting from its own offset of the counter.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param counterBlock A pointer to the 16-byte initial counter block.
+ * @param policy The execution policy to apply.
+ * @return True if the block was encrypted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::encryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock, const ExecutionPolicy& policy) {
+    const std::size_t chunkBytes = 1 << 18;
+
+    if (address == nullptr || size <= 0 || !key.isValid() || counterBlock == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid encryptMemory operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t length = static_cast<std::size_t>(size) * sizeof(T);
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(address);
+    const AesKey* aesKey = &key;
+    auto body = [bytes, aesKey, counterBlock](std::size_t begin, std::size_t end) {
+        aesKey->ctrXor(counterBlock, begin / AesKey::BlockSize, bytes + begin, end - begin);
+    };
+
+    unsigned int threads = parallelThreadCount(size, policy);
+    if (threads <= 1) {
+        body(0, length);
+    }
+    else {
+        threadPool->parallelFor(length, chunkBytes, threads, body);
+    }
+    return true;
+}
+
+/**
+ * @brief Decrypts a memory block encrypted with AES-CTR using an execution policy.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param key The expanded AES-128 or AES-256 key.
+ * @param counterBlock A pointer to the 16-byte initial counter block.
+ * @param policy The execution policy to apply.
+ * @return True if the block was decrypted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decryptMemory(T* address, int size, const AesKey& key, const unsigned char* counterBlock, const ExecutionPolicy& policy) {
+    return encryptMemory(address, size, key, counterBlock, policy);
+}
+
+/**
+ * @brief Fills a memory range with reproducible random values using an execution policy.
+ *
+ * @details Element i receives word i of the Philox stream keyed by seed, shifted down to a value between 0 and
+ * the largest int. Because every element depends only on the seed and its position, a parallel policy splits
+ * the range into chunks that generate independently, and the contents are the same for any thread count. If
+ * the inputs are invalid, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param seed The seed selecting the stream.
+ * @param policy The execution policy to apply.
+ * @return True if the range was filled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::initializeMemoryWithRandomValues(T* address, int size, std::uint64_t seed, const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid initializeMemoryWithRandomValues operation." << std::endl;
+#endif
+        return false;
+    }
+
+    PhiloxEngine engine(seed);
+    runParallel(size, policy, [address, &engine](std::size_t begin, std::size_t end) {
+        std::uint32_t words[1024];
+        for (std::size_t offset = begin; offset < end; offset += 1024) {
+            std::size_t count = std::min<std::size_t>(1024, end - offset);
+            engine.fill(offset, words, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                address[offset + i] = static_cast<T>(static_cast<int>(words[i] >> 1));
+            }
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Fills a memory range with reproducible random values over a closed interval using an execution policy.
+ *
+ * @details Values come from PhiloxEngine::fillBounded keyed by seed, which is free of modulo bias and depends
+ * only on the seed and the element position, so the contents are the same for any thread count. If the inputs
+ * are invalid or low is greater than high, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param low The smallest value that can be generated.
+ * @param high The largest value that can be generated.
+ * @param seed The seed selecting the stream.
+ * @param policy The execution policy to apply.
+ * @return True if the range was filled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::initializeMemoryWithRandomValues(T* address, int size, int low, int high, std::uint64_t seed,
+    const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0 || low > high) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid initializeMemoryWithRandomValues operation." << std::endl;
+#endif
+        return false;
+    }
+
+    PhiloxEngine engine(seed);
+    std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+    runParallel(size, policy, [address, &engine, low, range](std::size_t begin, std::size_t end) {
+        std::uint32_t words[1024];
+        for (std::size_t offset = begin; offset < end; offset += 1024) {
+            std::size_t count = std::min<std::size_t>(1024, end - offset);
+            if (range > 0xFFFFFFFFULL) {
+                engine.fill(offset, words, count);
+            }
+            else {
+                engine.fillBounded(offset, static_cast<std::uint32_t>(range), words, count);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                address[offset + i] = static_cast<T>(static_cast<int>(static_cast<std::uint32_t>(low) + words[i]));
+            }
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Shuffles a memory range with a cache-aware bucket shuffle using an execution policy.
+ *
+ * @details A Fisher-Yates shuffle of a buffer larger than the cache spends almost all of its time waiting on
+ * one random DRAM access per swap. This function instead uses the scatter-then-shuffle scheme of Rao and
+ * Sandelius:
+ * 1. Every element gets an independent, uniformly random bucket label, with a power-of-two number of buckets
+ *    chosen so that each one fits in a core's L2 cache. Labels are 16-bit halves of the Philox stream keyed by
+ *    seed, so label i depends only on seed and i.
+ * 2. The elements are scattered into their buckets by a stable two-pass counting sort, chunk by chunk.
+ * 3. Each bucket is Fisher-Yates shuffled in cache with its own engine and moved back.
+ * Random bucket sizes followed by uniform shuffles within buckets give a uniformly random permutation. A
+ * parallel policy runs every pass concurrently, and the permutation depends only on seed and size, never on
+ * the thread count. Buffers that fit in a single bucket are shuffled directly. The scatter needs a scratch
+ * buffer of the same size plus two bytes of label per element; if they cannot be allocated, the range is
+ * Fisher-Yates shuffled in place instead, which is uniform as well but gives a different permutation for the
+ * same seed. If the inputs are invalid, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param seed The seed selecting the permutation.
+ * @param policy The execution policy to apply.
+ * @return True if the range was shuffled, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::shuffleMemory(T* address, int size, std::uint64_t seed, const ExecutionPolicy& policy) {
+    const std::size_t bucketBytes = 1 << 18;
+    const std::size_t maxBuckets = 4096;
+
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid shuffleMemory operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    std::size_t bucketCount = 1;
+    while (bucketCount < maxBuckets && bucketCount * bucketBytes < count * sizeof(T)) {
+        bucketCount *= 2;
+    }
+    std::unique_ptr<T[]> scratch(bucketCount > 1 ? new (std::nothrow) T[count] : nullptr);
+    std::unique_ptr<std::uint16_t[]> labels(scratch ? new (std::nothrow) std::uint16_t[count] : nullptr);
+    if (!labels) {
+#ifdef DEBUG_MODE
+        if (bucketCount > 1) {
+            std::cerr << "Shuffle buffer allocation failed, falling back to an in-place shuffle." << std::endl;
+        }
+#endif
+        RandomEngine engine(seed);
+        return shuffleMemory(address, size, engine);
+    }
+
+    unsigned int threads = parallelThreadCount(size, policy);
+    std::size_t grainSize = (count + threads - 1) / threads;
+    std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+    PhiloxEngine labelEngine(seed);
+
+    // Label every element with a random bucket and count the labels of each chunk. Label i is the low bits of
+    // half i % 2 of stream word i / 2; the bucket count is a power of two, so the labels are exactly uniform.
+    std::vector<std::size_t> offsets(chunkCount * bucketCount, 0);
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t* chunkCounts = &offsets[(begin / grainSize) * bucketCount];
+        std::uint32_t words[1024];
+        for (std::size_t piece = begin & ~std::size_t(1); piece < end; piece += 2048) {
+            std::size_t pieceEnd = std::min(piece + 2048, end);
+            labelEngine.fill(piece / 2, words, (pieceEnd - piece + 1) / 2);
+            for (std::size_t i = std::max(piece, begin); i < pieceEnd; ++i) {
+                std::size_t label = words[(i - piece) / 2] >> (16 * (i & 1)) & (bucketCount - 1);
+                labels[i] = static_cast<std::uint16_t>(label);
+                ++chunkCounts[label];
+            }
+        }
+    });
+
+    std::vector<std::size_t> bucketStarts(bucketCount + 1, 0);
+    std::size_t running = 0;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        bucketStarts[bucket] = running;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            std::size_t bucketSize = offsets[chunk * bucketCount + bucket];
+            offsets[chunk * bucketCount + bucket] = running;
+            running += bucketSize;
+        }
+    }
+    bucketStarts[bucketCount] = running;
+
+    // Scatter into the buckets; each chunk writes its own slice of every bucket, so the contents of a bucket
+    // before its shuffle do not depend on how the range was split.
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t* chunkOffsets = &offsets[(begin / grainSize) * bucketCount];
+        for (std::size_t i = begin; i < end; ++i) {
+            scratch[chunkOffsets[labels[i]]++] = std::move(address[i]);
+        }
+    });
+
+    threadPool->parallelFor(bucketCount, 1, threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t bucket = first; bucket < last; ++bucket) {
+            T* bucketBegin = scratch.get() + bucketStarts[bucket];
+            std::size_t bucketSize = bucketStarts[bucket + 1] - bucketStarts[bucket];
+            RandomEngine engine(seed + 0x9E3779B97F4A7C15ULL * (bucket + 1));
+            for (std::size_t i = bucketSize; i > 1; --i) {
+                std::swap(bucketBegin[i - 1], bucketBegin[engine.nextBounded(static_cast<std::uint32_t>(i))]);
+            }
+            std::move(bucketBegin, bucketBegin + bucketSize, address + bucketStarts[bucket]);
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Copies the contents of one memory block to another using an execution policy.
+ *
+ * @details This overload behaves like copyMemory, but a parallel policy splits large blocks into
+ * chunks that are copied concurrently. The source and destination must not overlap.
+ *
+ * @param source A pointer to the source memory block.
+ * @param destination A pointer to the destination memory block.
+ * @param size The size, in number of elements, to be copied from the source to the destination.
+ * @param policy The execution policy to apply.
+ * @return True if the copy operation is successful, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::copyMemory(const T* source, T* destination, int size, const ExecutionPolicy& policy) {
+    if (source != nullptr && destination != nullptr && size > 0) {
+        runParallel(size, policy, [source, destination](std::size_t begin, std::size_t end) {
+            std::memcpy(destination + begin, source + begin, (end - begin) * sizeof(T));
+        });
+        return true;
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid copy operation: ";
+#endif
+        if (source == nullptr || destination == nullptr) {
+#ifdef DEBUG_MODE
+            std::cerr << "Null pointer." << std::endl;
+#endif
+        }
+        else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid size." << std::endl;
+#endif
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Fills a block of memory with a specified value using an execution policy.
+ *
+ * @details This overload behaves like fillMemory, but a parallel policy splits large blocks into
+ * chunks that are filled concurrently.
+ *
+ * @param address A pointer to the memory block to be filled.
+ * @param value The value to fill the memory block with.
+ * @param size The size, in number of elements, of the memory block to be filled.
+ * @param policy The execution policy to apply.
+ * @return True if the fill operation is successful, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::fillMemory(T* address, int value, int size, const ExecutionPolicy& policy) {
+    if (address != nullptr && size > 0) {
+        runParallel(size, policy, [address, value](std::size_t begin, std::size_t end) {
+            std::fill(address + begin, address + end, value);
+        });
+        return true;
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid fill operation: ";
+#endif
+        if (address == nullptr) {
+#ifdef DEBUG_MODE
+            std::cerr << "Null pointer." << std::endl;
+#endif
+        }
+        else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid size." << std::endl;
+#endif
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Calculates the checksum of the elements in a memory range using an execution policy.
+ *
+ * @details This overload behaves like calculateChecksum, but a parallel policy sums chunks
+ * concurrently and adds the partial sums together. The sum wraps around on overflow, so the
+ * result does not depend on how the block was split.
+ *
+ * @param address A pointer to the start of the memory range.
+ * @param size The size of the memory range.
+ * @param policy The execution policy to apply.
+ * @return The calculated checksum.
+ */
+template <typename T>
+inline int MemoryManager<T>::calculateChecksum(const T* address, int size, const ExecutionPolicy& policy) {
+    if (address != nullptr && size > 0) {
+        std::atomic<unsigned int> checksum(0);
+        runParallel(size, policy, [address, &checksum](std::size_t begin, std::size_t end) {
+            unsigned int partial = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                partial += static_cast<unsigned int>(address[i]);
+            }
+            checksum.fetch_add(partial);
+        });
+        return static_cast<int>(checksum.load());
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid calculateChecksum operation: ";
+#endif
+        if (address == nullptr) {
+#ifdef DEBUG_MODE
+            std::cerr << "Null pointer." << std::endl;
+#endif
+        }
+        else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid size." << std::endl;
+#endif
+        }
+        return 0;
+    }
+}
+
+/**
+ * @brief Replaces occurrences of a value in a memory block using an execution policy.
+ *
+ * @details This overload behaves like replaceValue, but a parallel policy splits large blocks into
+ * chunks that are processed concurrently.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param oldValue The value to be replaced.
+ * @param newValue The new value to replace the old value.
+ * @param policy The execution policy to apply.
+ */
+template <typename T>
+inline void MemoryManager<T>::replaceValue(T* address, int size, int oldValue, int newValue, const ExecutionPolicy& policy) {
+    if (address != nullptr && size > 0) {
+        runParallel(size, policy, [address, oldValue, newValue](std::size_t begin, std::size_t end) {
+            std::replace(address + begin, address + end, static_cast<T>(oldValue), static_cast<T>(newValue));
+        });
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid replaceValue operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Performs bitwise XOR on two source memories using an execution policy.
+ *
+ * @details This overload behaves like xorMemory, but a parallel policy splits large blocks into
+ * chunks that are processed concurrently.
+ *
+ * @param source1 A pointer to the first source memory.
+ * @param source2 A pointer to the second source memory.
+ * @param destination A pointer to the destination memory.
+ * @param size The size of the memory range.
+ * @param policy The execution policy to apply.
+ */
+template <typename T>
+inline void MemoryManager<T>::xorMemory(const T* source1, const T* source2, T* destination, int size, const ExecutionPolicy& policy) {
+    if (source1 != nullptr && source2 != nullptr && destination != nullptr && size > 0) {
+        runParallel(size, policy, [source1, source2, destination](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                destination[i] = source1[i] ^ source2[i];
+            }
+        });
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid xorMemory operation." << std::endl;
+#endif
+    }
+}
+
+/**
+ * @brief Sorts a memory block in ascending order.
+ *
+ * @details Integer elements are sorted with an LSD radix sort over 8-bit digits. One read pass
+ * builds the histograms of every digit at once, and digits on which all elements agree are skipped.
+ * The radix sort needs a scratch buffer as large as the block. Other element types, blocks too small
+ * to pay for the histograms, and blocks whose scratch buffer cannot be allocated use introsort
+ * (std::sort). If the address is nullptr or the size is invalid, the function prints an error message
+ * and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return True if the block was sorted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::sortMemory(T* address, int size) {
+    return sortMemory(address, size, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Sorts a memory block in ascending order using an execution policy.
+ *
+ * @details This overload behaves like sortMemory, but a parallel policy splits large blocks
+ * across the thread pool. For integers every radix pass counts and scatters the chunks concurrently;
+ * other element types sort the chunks concurrently and then merge them pairwise.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param policy The execution policy to apply.
+ * @return True if the block was sorted, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::sortMemory(T* address, int size, const ExecutionPolicy& policy) {
+    if (address != nullptr && size > 0) {
+        sortElements(address, size, parallelThreadCount(size, policy),
+            std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value>());
+        return true;
+    }
+    else {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid sortMemory operation: ";
+#endif
+        if (address == nullptr) {
+#ifdef DEBUG_MODE
+            std::cerr << "Null pointer." << std::endl;
+#endif
+        }
+        else {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid size." << std::endl;
+#endif
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Sorts integer elements with an LSD radix sort.
+ *
+ * @details Signed keys have their sign bit flipped so that negative values order before
+ * positive ones. Each pass scatters stably from one buffer into the other, and the result is
+ * copied back if it ends up in the scratch buffer.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param threads The number of threads to use.
+ */
+template <typename T>
+inline void MemoryManager<T>::sortElements(T* address, int size, unsigned int threads, std::true_type) {
+    typedef typename std::make_unsigned<T>::type Key;
+    const int radixSortThreshold = 256;
+    const int bucketCount = 256;
+    const int passCount = static_cast<int>(sizeof(T));
+    const Key signFlip = std::is_signed<T>::value ? static_cast<Key>(Key(1) << (sizeof(T) * 8 - 1)) : Key(0);
+
+    if (size < radixSortThreshold) {
+        std::sort(address, address + size);
+        return;
+    }
+
+    T* buffer = new (std::nothrow) T[size];
+    if (buffer == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Radix sort buffer allocation failed, falling back to std::sort." << std::endl;
+#endif
+        std::sort(address, address + size);
+        return;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    std::size_t grainSize = (count + threads - 1) / threads;
+    std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    // Digit counts do not change when elements move, so one pass yields the histograms of every digit.
+    std::vector<std::size_t> histograms(chunkCount * passCount * bucketCount, 0);
+    auto countDigits = [&](std::size_t begin, std::size_t end) {
+        std::size_t* chunkHistograms = &histograms[(begin / grainSize) * passCount * bucketCount];
+        for (std::size_t i = begin; i < end; ++i) {
+            Key key = static_cast<Key>(static_cast<Key>(address[i]) ^ signFlip);
+            for (int pass = 0; pass < passCount; ++pass) {
+                ++chunkHistograms[pass * bucketCount + ((key >> (pass * 8)) & 0xFF)];
+            }
+        }
+    };
+    if (threads <= 1) {
+        countDigits(0, count);
+    }
+    else {
+        threadPool->parallelFor(count, grainSize, threads, countDigits);
+        for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            for (int i = 0; i < passCount * bucketCount; ++i) {
+                histograms[i] += histograms[chunk * passCount * bucketCount + i];
+            }
+        }
+    }
+
+    T* source = address;
+    T* destination = buffer;
+    std::vector<std::size_t> offsets(chunkCount * bucketCount);
+
+    for (int pass = 0; pass < passCount; ++pass) {
+        const std::size_t* histogram = &histograms[pass * bucketCount];
+        int shift = pass * 8;
+        Key firstKey = static_cast<Key>(static_cast<Key>(source[0]) ^ signFlip);
+        if (histogram[(firstKey >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        if (threads <= 1) {
+            std::size_t running = 0;
+            for (int bucket = 0; bucket < bucketCount; ++bucket) {
+                offsets[bucket] = running;
+                running += histogram[bucket];
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                Key key = static_cast<Key>(static_cast<Key>(source[i]) ^ signFlip);
+                destination[offsets[(key >> shift) & 0xFF]++] = source[i];
+            }
+        }
+        else {
+            std::fill(offsets.begin(), offsets.end(), 0);
+            threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+                std::size_t* chunkCounts = &offsets[(begin / grainSize) * bucketCount];
+                for (std::size_t i = begin; i < end; ++i) {
+                    Key key = static_cast<Key>(static_cast<Key>(source[i]) ^ signFlip);
+                    ++chunkCounts[(key >> shift) & 0xFF];
+                }
+            });
+
+            std::size_t running = 0;
+            for (int bucket = 0; bucket < bucketCount; ++bucket) {
+                for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                    std::size_t digitCount = offsets[chunk * bucketCount + bucket];
+                    offsets[chunk * bucketCount + bucket] = running;
+                    running += digitCount;
+                }
+            }
+
+            threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+                std::size_t* chunkOffsets = &offsets[(begin / grainSize) * bucketCount];
+                for (std::size_t i = begin; i < end; ++i) {
+                    Key key = static_cast<Key>(static_cast<Key>(source[i]) ^ signFlip);
+                    destination[chunkOffsets[(key >> shift) & 0xFF]++] = source[i];
+                }
+            });
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != address) {
+        std::memcpy(address, source, count * sizeof(T));
+    }
+    delete[] buffer;
+}
+
+/**
+ * @brief Sorts non-integer elements with introsort.
+ *
+ * @details With more than one thread, equal chunks are sorted concurrently and then merged
+ * pairwise, doubling the run length each round.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param threads The number of threads to use.
+ */
+template <typename T>
+inline void MemoryManager<T>::sortElements(T* address, int size, unsigned int threads, std::false_type) {
+    if (threads <= 1) {
+        std::sort(address, address + size);
+        return;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    std::size_t runLength = (count + threads - 1) / threads;
+    threadPool->parallelFor(count, runLength, threads, [address](std::size_t begin, std::size_t end) {
+        std::sort(address + begin, address + end);
+    });
+
+    for (; runLength < count; runLength *= 2) {
+        std::size_t pairLength = runLength * 2;
+        threadPool->parallelFor(count, pairLength, threads, [address, runLength, count](std::size_t begin, std::size_t end) {
+            std::size_t middle = std::min(begin + runLength, count);
+            if (middle < end) {
+                std::inplace_merge(address + begin, address + middle, address + end);
+            }
+        });
+    }
+}
+
+/**
+ * @brief Hashes an element for the open-addressing tables.
+ *
+ * @details std::hash is the identity for integers on common standard libraries, so the result
+ * is mixed with a multiplicative (Fibonacci) hash to spread consecutive keys over the table.
+ *
+ * @param value The element to hash.
+ * @return The mixed 64-bit hash of the element.
+ */
+template <typename T>
+inline std::uint64_t MemoryManager<T>::hashValue(const T& value) {
+    std::uint64_t hash = static_cast<std::uint64_t>(std::hash<T>()(value));
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Removes duplicate elements while keeping the first occurrence of each value in order.
+ *
+ * @details This function moves the first occurrence of every distinct value to the front of the block,
+ * in their original order, and returns how many there are. Elements past the returned length are left
+ * in an unspecified state. Occurrences are tracked in a FlatHashSet, so the function runs in expected O(n)
+ * time and uses O(n) extra memory.
+ * If the address is nullptr, the size is invalid, or the hash table cannot be allocated, the function prints an
+ * error message and returns 0 without touching the block.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @return The number of distinct elements at the front of the block.
+ */
+template <typename T>
+inline int MemoryManager<T>::deduplicateMemoryStable(T* address, int size) {
+    return deduplicateMemoryStable(address, size, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Removes duplicate elements while keeping first-occurrence order using an execution policy.
+ *
+ * @details This overload behaves like deduplicateMemoryStable. A parallel policy partitions the element
+ * indices by hash, so that all copies of a value fall into the same partition. Every partition then finds
+ * its first occurrences in its own FlatHashSet concurrently. The kept elements are finally compacted chunk
+ * by chunk through a scratch buffer. If a partition's table cannot be allocated, the block is deduplicated
+ * sequentially instead.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of distinct elements at the front of the block.
+ */
+template <typename T>
+inline int MemoryManager<T>::deduplicateMemoryStable(T* address, int size, const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid deduplicateMemoryStable operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    unsigned int threads = parallelThreadCount(size, policy);
+    if (threads <= 1) {
+        // The table is sized for every element up front, so no insert below has to grow it.
+        FlatHashSet<T> seen(*this, 0);
+        if (!seen.reserve(size)) {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid deduplicateMemoryStable operation." << std::endl;
+#endif
+            return 0;
+        }
+
+        int uniqueCount = 0;
+        for (int i = 0; i < size; ++i) {
+            T value = address[i];
+            if (seen.insert(value) == FlatHashSet<T>::Inserted) {
+                address[uniqueCount++] = value;
+            }
+        }
+        return uniqueCount;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    std::size_t grainSize = (count + threads - 1) / threads;
+    std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+    std::size_t partitionCount = threads * 4;
+
+    auto partitionOf = [partitionCount](const T& value) {
+        return static_cast<std::size_t>(((hashValue(value) >> 32) * partitionCount) >> 32);
+    };
+
+    // Scatter the indices into hash partitions; each chunk writes its own slice of every partition,
+    // so the indices of a partition stay in ascending order.
+    std::vector<std::size_t> offsets(chunkCount * partitionCount, 0);
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t* chunkCounts = &offsets[(begin / grainSize) * partitionCount];
+        for (std::size_t i = begin; i < end; ++i) {
+            ++chunkCounts[partitionOf(address[i])];
+        }
+    });
+
+    std::vector<std::size_t> partitionStarts(partitionCount + 1, 0);
+    std::size_t running = 0;
+    for (std::size_t partition = 0; partition < partitionCount; ++partition) {
+        partitionStarts[partition] = running;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            std::size_t partitionSize = offsets[chunk * partitionCount + partition];
+            offsets[chunk * partitionCount + partition] = running;
+            running += partitionSize;
+        }
+    }
+    partitionStarts[partitionCount] = running;
+
+    std::vector<int> indices(count);
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t* chunkOffsets = &offsets[(begin / grainSize) * partitionCount];
+        for (std::size_t i = begin; i < end; ++i) {
+            indices[chunkOffsets[partitionOf(address[i])]++] = static_cast<int>(i);
+        }
+    });
+
+    std::vector<unsigned char> keep(count, 0);
+    std::atomic<bool> tableFailed(false);
+    threadPool->parallelFor(partitionCount, 1, threads, [&](std::size_t first, std::size_t last) {
+        FlatHashSet<T> seen(*this, 0);
+        for (std::size_t partition = first; partition < last && !tableFailed.load(std::memory_order_relaxed); ++partition) {
+            std::size_t begin = partitionStarts[partition];
+            std::size_t end = partitionStarts[partition + 1];
+
+            seen.clear();
+            if (!seen.reserve(static_cast<int>(end - begin))) {
+                tableFailed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                typename FlatHashSet<T>::InsertResult inserted = seen.insert(address[indices[i]]);
+                if (inserted == FlatHashSet<T>::InsertFailed) {
+                    tableFailed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                if (inserted == FlatHashSet<T>::Inserted) {
+                    keep[indices[i]] = 1;
+                }
+            }
+        }
+    });
+    if (tableFailed.load()) {
+        // Nothing has been written to the block yet, so the sequential pass can start over.
+        return deduplicateMemoryStable(address, size, ExecutionPolicy::sequential());
+    }
+
+    std::vector<std::size_t> keptStarts(chunkCount + 1, 0);
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t kept = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            kept += keep[i];
+        }
+        keptStarts[begin / grainSize + 1] = kept;
+    });
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        keptStarts[chunk + 1] += keptStarts[chunk];
+    }
+
+    std::vector<T> compacted(keptStarts[chunkCount]);
+    threadPool->parallelFor(count, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t out = keptStarts[begin / grainSize];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (keep[i]) {
+                compacted[out++] = address[i];
+            }
+        }
+    });
+
+    std::size_t uniqueCount = compacted.size();
+    threadPool->parallelFor(uniqueCount, grainSize, threads, [&](std::size_t begin, std::size_t end) {
+        std::copy(compacted.begin() + begin, compacted.begin() + end, address + begin);
+    });
+    return static_cast<int>(uniqueCount);
+}
+
+/**
+ * @brief Rearranges a memory block so that the element at a given index is the one a full sort would put there.
+ *
+ * @details This function behaves like std::nth_element: afterwards no element before index n is greater
+ * than address[n], and no element after it is smaller. If the address, size and index are valid, the
+ * function performs the selection. Otherwise, it prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param n The index of the element to select.
+ * @return True if the selection is successful, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::nthElement(T* address, int size, int n) {
+    return nthElement(address, size, n, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Rearranges a memory block so that the element at a given index is the one a full sort would put there,
+ * using an execution policy.
+ *
+ * @details The selection is an introselect: quickselect with a median-of-3 or ninther pivot, partitioning
+ * around the pivot value with partitionElements, and switching to median-of-medians pivots once the
+ * recursion depth exceeds twice the logarithm of the size, which bounds the worst case to linear time.
+ * Elements equal to the pivot are split off in a second pass, so blocks with many duplicates do not
+ * degrade. A parallel policy partitions large ranges across threads. Blocks of 32-bit integers are
+ * partitioned through a scratch block of size elements; if it cannot be allocated, they are partitioned in
+ * place instead. If the inputs are invalid, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param n The index of the element to select.
+ * @param policy The execution policy to apply.
+ * @return True if the selection is successful, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::nthElement(T* address, int size, int n, const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0 || n < 0 || n >= size) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid nthElement operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::unique_ptr<T[]> scratch(allocatePartitionScratch(size));
+    selectElement(address, size, n, scratch.get(), policy);
+    return true;
+}
+
+/**
+ * @brief Copies the k largest elements of a memory block in descending order.
+ *
+ * @details If the inputs are valid, the function writes the k largest elements of the block to destination,
+ * largest first. The source block is not modified. Otherwise, it prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param k The number of elements to return, between 1 and size.
+ * @param destination A pointer to a memory block receiving k elements.
+ * @return True if the elements are successfully copied, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::topK(const T* address, int size, int k, T* destination) {
+    return topK(address, size, k, destination, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Copies the k largest elements of a memory block in descending order using an execution policy.
+ *
+ * @details For small k the elements stream once through a min-heap of the k largest seen so far, which
+ * rarely needs updating after the first elements and does not touch the source. Larger k copy the block
+ * to a scratch buffer and select the boundary with nthElement, whose partitions a parallel policy splits
+ * across threads; if the copy cannot be allocated, they use the heap as well. Either way the result is
+ * sorted at the end. If the inputs are invalid, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param k The number of elements to return, between 1 and size.
+ * @param destination A pointer to a memory block receiving k elements.
+ * @param policy The execution policy to apply.
+ * @return True if the elements are successfully copied, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::topK(const T* address, int size, int k, T* destination, const ExecutionPolicy& policy) {
+    if (address == nullptr || destination == nullptr || size <= 0 || k <= 0 || k > size) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid topK operation." << std::endl;
+#endif
+        return false;
+    }
+
+    // Large k select on a copy of the block; small k, or a copy that cannot be allocated, use the heap.
+    std::greater<T> descending;
+    std::unique_ptr<T[]> copy;
+    if (static_cast<std::size_t>(k) * TopKHeapRatio > static_cast<std::size_t>(size)) {
+        copy.reset(new (std::nothrow) T[size]);
+    }
+
+    if (copy) {
+        std::unique_ptr<T[]> scratch(allocatePartitionScratch(size));
+        std::copy(address, address + size, copy.get());
+        selectElement(copy.get(), size, size - k, scratch.get(), policy);
+        std::copy(copy.get() + (size - k), copy.get() + size, destination);
+        std::sort(destination, destination + k, descending);
+        return true;
+    }
+
+    std::copy(address, address + k, destination);
+    std::make_heap(destination, destination + k, descending);
+    for (int i = k; i < size; ++i) {
+        if (destination[0] < address[i]) {
+            std::pop_heap(destination, destination + k, descending);
+            destination[k - 1] = address[i];
+            std::push_heap(destination, destination + k, descending);
+        }
+    }
+    std::sort_heap(destination, destination + k, descending);
+    return true;
+}
+
+/**
+ * @brief Moves the elements smaller than a pivot value to the front of a memory block.
+ *
+ * @details If the address and size parameters are valid, the function partitions the block and returns
+ * the number of elements smaller than the pivot, which now come first in their original order. Blocks of
+ * 32-bit integers are partitioned with branch-free SIMD kernels through a scratch block of size elements; if
+ * it cannot be allocated, they are partitioned in place, without keeping the order. Otherwise, it prints an
+ * error message and returns 0.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivotValue The pivot value.
+ * @return The number of elements smaller than the pivot.
+ */
+template <typename T>
+inline int MemoryManager<T>::partitionMemory(T* address, int size, int pivotValue) {
+    return partitionMemory(address, size, pivotValue, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Moves the elements smaller than a pivot value to the front of a memory block using an execution policy.
+ *
+ * @details This overload behaves like partitionMemory, but a parallel policy partitions one chunk per thread
+ * and then swaps the misplaced elements in parallel. The parallel partition does not keep the original order.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivotValue The pivot value.
+ * @param policy The execution policy to apply.
+ * @return The number of elements smaller than the pivot.
+ */
+template <typename T>
+inline int MemoryManager<T>::partitionMemory(T* address, int size, int pivotValue, const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid partitionMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    std::unique_ptr<T[]> scratch(allocatePartitionScratch(size));
+    return static_cast<int>(partitionElements(address, size, static_cast<T>(pivotValue), false, scratch.get(), policy));
+}
+
+/**
+ * @brief Performs three-way partitioning on a memory block based on a pivot value using an execution policy.
+ *
+ * @details This overload behaves like threeWayPartition, but reports invalid inputs through its return value,
+ * and a parallel policy splits both partitioning passes across threads. Blocks of 32-bit integers are
+ * partitioned through a scratch block of size elements, or in place if it cannot be allocated.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param pivotValue The pivot value.
+ * @param lowerBound Receives the index of the first element equal to the pivot.
+ * @param upperBound Receives the index of the last element equal to the pivot.
+ * @param policy The execution policy to apply.
+ * @return True if the block is successfully partitioned, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::threeWayPartition(T* address, int size, int pivotValue, int& lowerBound, int& upperBound,
+    const ExecutionPolicy& policy) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid threeWayPartition operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::unique_ptr<T[]> scratch(allocatePartitionScratch(size));
+    T pivot = static_cast<T>(pivotValue);
+    std::size_t below = partitionElements(address, size, pivot, false, scratch.get(), policy);
+    std::size_t equal = partitionElements(address + below, size - below, pivot, true, scratch.get(), policy);
+    lowerBound = static_cast<int>(below);
+    upperBound = static_cast<int>(below + equal) - 1;
+    return true;
+}
+
+/**
+ * @brief Moves the element a full sort would put at index n there, with smaller elements before it.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param n The index of the element to select.
+ * @param scratch A pointer to a scratch block of at least size elements, used for 32-bit integers.
+ * @param policy The execution policy to apply.
+ */
+template <typename T>
+inline void MemoryManager<T>::selectElement(T* address, std::size_t size, std::size_t n, T* scratch, const ExecutionPolicy& policy) {
+    std::size_t begin = 0;
+    std::size_t end = size;
+    int depthBudget = 0;
+    for (std::size_t remaining = size; remaining > 1; remaining >>= 1) {
+        depthBudget += 2;
+    }
+
+    while (end - begin > SelectionCutoff) {
+        T pivot = depthBudget-- > 0 ? selectionPivot(address + begin, end - begin)
+            : medianOfMedians(address + begin, end - begin, scratch, policy);
+        std::size_t below = begin + partitionElements(address + begin, end - begin, pivot, false, scratch, policy);
+        if (n < below) {
+            end = below;
+            continue;
+        }
+        std::size_t notAbove = below + partitionElements(address + below, end - below, pivot, true, scratch, policy);
+        if (n < notAbove) {
+            return;
+        }
+        begin = notAbove;
+    }
+    std::sort(address + begin, address + end);
+}
+
+/**
+ * @brief Computes a pivot that splits a range into parts of at least 30% each, in linear time.
+ *
+ * @details The medians of groups of five are gathered at the front of the range and their own median is
+ * selected recursively. The range is reordered.
+ *
+ * @param address A pointer to the start of the range, which must hold at least five elements.
+ * @param size The size of the range.
+ * @param scratch A pointer to a scratch block of at least size elements, used for 32-bit integers.
+ * @param policy The execution policy to apply.
+ * @return The median of the group medians.
+ */
+template <typename T>
+inline T MemoryManager<T>::medianOfMedians(T* address, std::size_t size, T* scratch, const ExecutionPolicy& policy) {
+    std::size_t groups = size / 5;
+    for (std::size_t group = 0; group < groups; ++group) {
+        T* first = address + 5 * group;
+        std::sort(first, first + 5);
+        std::swap(address[group], first[2]);
+    }
+    selectElement(address, groups, groups / 2, scratch, policy);
+    return address[groups / 2];
+}
+
+/**
+ * @brief Estimates the median of a range from a small sample.
+ *
+ * @param address A pointer to the start of the range.
+ * @param size The size of the range, which must be at least 3.
+ * @return The median of the first, middle and last element, or for large ranges the ninther: the median of
+ * the medians of three evenly spaced triples.
+ */
+template <typename T>
+inline T MemoryManager<T>::selectionPivot(const T* address, std::size_t size) {
+    auto median = [](const T& a, const T& b, const T& c) {
+        return std::max(std::min(a, b), std::min(std::max(a, b), c));
+    };
+    std::size_t middle = size / 2;
+    if (size < 1024) {
+        return median(address[0], address[middle], address[size - 1]);
+    }
+    std::size_t step = size / 8;
+    return median(median(address[0], address[step], address[2 * step]),
+        median(address[middle - step], address[middle], address[middle + step]),
+        median(address[size - 1 - 2 * step], address[size - 1 - step], address[size - 1]));
+}
+
+/**
+ * @brief Finds where a diagonal of the merge path crosses two sorted blocks.
+ *
+ * @details The first diagonal elements of the stable merge of block1 and block2 consist of the
+ * first i elements of block1 and the first diagonal - i elements of block2. A binary search along
+ * the diagonal finds i in O(log(min(size1, size2))) steps, which lets every thread locate its share
+ * of the output independently.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param diagonal The number of merged elements preceding the split.
+ * @return The number of elements taken from block1 before the split.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::mergePathSplit(const T* block1, std::size_t size1, const T* block2, std::size_t size2, std::size_t diagonal) {
+    std::size_t low = diagonal > size2 ? diagonal - size2 : 0;
+    std::size_t high = std::min(diagonal, size1);
+
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (!(block2[diagonal - 1 - middle] < block1[middle])) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Computes a set operation of two sorted ranges on the calling thread.
+ *
+ * @details The union drops every repeated value, matching unionSortedMemory. The difference and symmetric
+ * difference follow std::set_difference and std::set_symmetric_difference. If destination is nullptr the
+ * result is only counted, which lets the parallel driver size every segment's output before writing.
+ *
+ * @param operation The set operation to compute.
+ * @param block1 A pointer to the first sorted range.
+ * @param size1 The size of the first range.
+ * @param block2 A pointer to the second sorted range.
+ * @param size2 The size of the second range.
+ * @param destination A pointer to the output, or nullptr to count only.
+ * @return The number of elements in the result.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::sortedSetKernel(SetOperation operation, const T* block1, std::size_t size1,
+    const T* block2, std::size_t size2, T* destination) {
+    std::size_t i = 0, j = 0, k = 0;
+
+    if (operation == SetUnion) {
+        // The last emitted element is tracked through the inputs, so counting needs no output to look back at.
+        const T* last = nullptr;
+        auto emit = [destination, &k, &last](const T& value) {
+            if (last == nullptr || !(*last == value)) {
+                if (destination != nullptr) {
+                    destination[k] = value;
+                }
+                ++k;
+            }
+            last = &value;
+        };
+
+        while (i < size1 && j < size2) {
+            if (block2[j] < block1[i]) {
+                emit(block2[j++]);
+            }
+            else {
+                emit(block1[i++]);
+            }
+        }
+        while (i < size1) {
+            emit(block1[i++]);
+        }
+        while (j < size2) {
+            emit(block2[j++]);
+        }
+        return k;
+    }
+
+    while (i < size1 && j < size2) {
+        if (block1[i] < block2[j]) {
+            if (destination != nullptr) {
+                destination[k] = block1[i];
+            }
+            ++k;
+            ++i;
+        }
+        else if (block2[j] < block1[i]) {
+            if (operation == SetSymmetricDifference) {
+                if (destination != nullptr) {
+                    destination[k] = block2[j];
+                }
+                ++k;
+            }
+            ++j;
+        }
+        else {
+            ++i;
+            ++j;
+        }
+    }
+
+    if (destination != nullptr) {
+        std::copy(block1 + i, block1 + size1, destination + k);
+    }
+    k += size1 - i;
+
+    if (operation == SetSymmetricDifference) {
+        if (destination != nullptr) {
+            std::copy(block2 + j, block2 + size2, destination + k);
+        }
+        k += size2 - j;
+    }
+
+    return k;
+}
+
+/**
+ * @brief Computes a set operation of two sorted blocks, splitting the work with merge paths.
+ *
+ * @details Both blocks are cut at evenly spaced merge-path diagonals. Each cut is then moved back to
+ * the first occurrence of the value it falls on, so that all copies of a value land in the same
+ * segment and the segments can be processed independently. Every segment first counts its result,
+ * and after a prefix sum writes it straight into its place in the destination.
+ *
+ * @param operation The set operation to compute.
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements written to the destination.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::runSortedSetOperation(SetOperation operation, const T* block1, std::size_t size1,
+    const T* block2, std::size_t size2, T* destination, const ExecutionPolicy& policy) {
+    std::size_t total = size1 + size2;
+    unsigned int threads = parallelThreadCount(static_cast<int>(std::min<std::size_t>(total, std::numeric_limits<int>::max())), policy);
+    if (threads <= 1) {
+        return sortedSetKernel(operation, block1, size1, block2, size2, destination);
+    }
+
+    std::size_t segmentCount = threads;
+    std::vector<std::size_t> splits1(segmentCount + 1), splits2(segmentCount + 1);
+    splits1[0] = splits2[0] = 0;
+    splits1[segmentCount] = size1;
+    splits2[segmentCount] = size2;
+
+    for (std::size_t segment = 1; segment < segmentCount; ++segment) {
+        std::size_t diagonal = total / segmentCount * segment;
+        std::size_t i = mergePathSplit(block1, size1, block2, size2, diagonal);
+        std::size_t j = diagonal - i;
+
+        if (i < size1 || j < size2) {
+            const T& key = i == size1 ? block2[j] : (j == size2 ? block1[i] : std::min(block1[i], block2[j]));
+            i = std::lower_bound(block1, block1 + i, key) - block1;
+            j = std::lower_bound(block2, block2 + j, key) - block2;
+        }
+
+        splits1[segment] = std::max(i, splits1[segment - 1]);
+        splits2[segment] = std::max(j, splits2[segment - 1]);
+    }
+
+    std::vector<std::size_t> outputStarts(segmentCount + 1, 0);
+    threadPool->parallelFor(segmentCount, 1, threads, [&](std::size_t segment, std::size_t) {
+        outputStarts[segment + 1] = sortedSetKernel(operation,
+            block1 + splits1[segment], splits1[segment + 1] - splits1[segment],
+            block2 + splits2[segment], splits2[segment + 1] - splits2[segment], nullptr);
+    });
+    for (std::size_t segment = 0; segment < segmentCount; ++segment) {
+        outputStarts[segment + 1] += outputStarts[segment];
+    }
+
+    threadPool->parallelFor(segmentCount, 1, threads, [&](std::size_t segment, std::size_t) {
+        sortedSetKernel(operation,
+            block1 + splits1[segment], splits1[segment + 1] - splits1[segment],
+            block2 + splits2[segment], splits2[segment + 1] - splits2[segment], destination + outputStarts[segment]);
+    });
+
+    return outputStarts[segmentCount];
+}
+
+/**
+ * @brief Merges two sorted memory blocks into a caller-provided block using an execution policy.
+ *
+ * @details This overload behaves like mergeSortedMemory, but writes into destination, which must hold
+ * size1 + size2 elements. A parallel policy cuts the merge path into one segment per thread, and every
+ * thread merges its segment directly into place. If the inputs are invalid, the function prints an
+ * error message and returns 0.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements written to the destination.
+ */
+template <typename T>
+inline int MemoryManager<T>::mergeSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy) {
+    if (block1 == nullptr || size1 <= 0 || block2 == nullptr || size2 <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid mergeSortedMemory operation: Null or empty blocks." << std::endl;
+#endif
+        return 0;
+    }
+
+    std::size_t total = static_cast<std::size_t>(size1) + size2;
+    unsigned int threads = parallelThreadCount(static_cast<int>(std::min<std::size_t>(total, std::numeric_limits<int>::max())), policy);
+    if (threads <= 1) {
+        std::merge(block1, block1 + size1, block2, block2 + size2, destination);
+        return static_cast<int>(total);
+    }
+
+    threadPool->parallelFor(threads, 1, threads, [&](std::size_t segment, std::size_t) {
+        std::size_t begin = total / threads * segment;
+        std::size_t end = segment + 1 == threads ? total : total / threads * (segment + 1);
+        std::size_t i1 = mergePathSplit(block1, size1, block2, size2, begin);
+        std::size_t i2 = mergePathSplit(block1, size1, block2, size2, end);
+        std::merge(block1 + i1, block1 + i2, block2 + (begin - i1), block2 + (end - i2), destination + begin);
+    });
+
+    return static_cast<int>(total);
+}
+
+/**
+ * @brief Computes the union of two sorted memory blocks into a caller-provided block.
+ *
+ * @details This overload behaves like unionSortedMemory, but writes into destination, which must hold
+ * size1 + size2 elements. A parallel policy splits the inputs along merge paths and computes the segments
+ * concurrently. If the inputs are invalid, the function prints an error message and returns 0.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements in the union.
+ */
+template <typename T>
+inline int MemoryManager<T>::unionSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid unionSortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    return static_cast<int>(runSortedSetOperation(SetUnion, block1, size1, block2, size2, destination, policy));
+}
+
+/**
+ * @brief Computes the difference of two sorted memory blocks into a caller-provided block.
+ *
+ * @details This overload behaves like differenceSortedMemory, but writes into destination, which must hold
+ * size1 elements. A parallel policy splits the inputs along merge paths and computes the segments
+ * concurrently. If the inputs are invalid, the function prints an error message and returns 0.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements in the difference.
+ */
+template <typename T>
+inline int MemoryManager<T>::differenceSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid differenceSortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    return static_cast<int>(runSortedSetOperation(SetDifference, block1, size1, block2, size2, destination, policy));
+}
+
+/**
+ * @brief Computes the symmetric difference of two sorted memory blocks into a caller-provided block.
+ *
+ * @details This overload behaves like symmetricDifferenceSortedMemory, but writes into destination, which
+ * must hold size1 + size2 elements. A parallel policy splits the inputs along merge paths and computes the
+ * segments concurrently. If the inputs are invalid, the function prints an error message and returns 0.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements in the symmetric difference.
+ */
+template <typename T>
+inline int MemoryManager<T>::symmetricDifferenceSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination, const ExecutionPolicy& policy) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid symmetricDifferenceSortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    return static_cast<int>(runSortedSetOperation(SetSymmetricDifference, block1, size1, block2, size2, destination, policy));
+}
+
+/**
+ * @brief Merges any number of sorted ranges with a loser tree.
+ *
+ * @details Every internal node of the tree holds the run that lost the match played there, and the
+ * overall winner sits above the root. Emitting the winner replays only the matches on the path from its
+ * leaf to the root, so each output element costs about log2(runCount) comparisons, touching a tree small
+ * enough to stay in L1. Equal elements are taken from lower-numbered runs first, which keeps the merge stable.
+ *
+ * @param runBegins Pointers to the first element of every run.
+ * @param runEnds Pointers one past the last element of every run.
+ * @param runCount The number of runs.
+ * @param destination A pointer to the output, large enough for every element of every run.
+ */
+template <typename T>
+inline void MemoryManager<T>::loserTreeMerge(const T* const* runBegins, const T* const* runEnds, std::size_t runCount, T* destination) {
+    std::size_t leafCount = 1;
+    while (leafCount < runCount) {
+        leafCount *= 2;
+    }
+
+    std::vector<const T*> cursors(leafCount, nullptr);
+    std::vector<const T*> ends(leafCount, nullptr);
+    std::size_t remaining = 0;
+    for (std::size_t run = 0; run < runCount; ++run) {
+        cursors[run] = runBegins[run];
+        ends[run] = runEnds[run];
+        remaining += static_cast<std::size_t>(runEnds[run] - runBegins[run]);
+    }
+
+    // An exhausted run loses against everything; ties go to the lower run index.
+    auto beats = [&cursors, &ends](std::size_t left, std::size_t right) {
+        if (cursors[left] == ends[left]) {
+            return false;
+        }
+        if (cursors[right] == ends[right]) {
+            return true;
+        }
+        return *cursors[left] < *cursors[right] || (!(*cursors[right] < *cursors[left]) && left < right);
+    };
+
+    std::vector<std::size_t> tree(leafCount);
+    std::vector<std::size_t> winners(leafCount * 2);
+    for (std::size_t leaf = 0; leaf < leafCount; ++leaf) {
+        winners[leafCount + leaf] = leaf;
+    }
+    for (std::size_t node = leafCount - 1; node >= 1; --node) {
+        std::size_t left = winners[node * 2];
+        std::size_t right = winners[node * 2 + 1];
+        if (beats(right, left)) {
+            winners[node] = right;
+            tree[node] = left;
+        }
+        else {
+            winners[node] = left;
+            tree[node] = right;
+        }
+    }
+    std::size_t winner = leafCount > 1 ? winners[1] : 0;
+
+    for (std::size_t k = 0; k < remaining; ++k) {
+        destination[k] = *cursors[winner]++;
+
+        for (std::size_t node = (winner + leafCount) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], winner)) {
+                std::swap(tree[node], winner);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Merges many sorted memory blocks into a newly allocated block.
+ *
+ * @details This function merges runCount sorted blocks in a single pass with a loser tree. runs[i] points to
+ * the i-th block and runSizes[i] holds its size; empty blocks are allowed. The output is allocated once with
+ * room for every element. If the inputs are invalid, it prints an error message, sets mergedSize to 0, and
+ * returns a null pointer.
+ *
+ * @param runs An array of pointers to the sorted memory blocks.
+ * @param runSizes An array with the size of every memory block.
+ * @param runCount The number of memory blocks.
+ * @param mergedSize Reference to store the size of the merged block.
+ * @return A pointer to the merged memory block, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, int& mergedSize) {
+    mergedSize = 0;
+    if (runs == nullptr || runSizes == nullptr || runCount <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid mergeManySortedMemory operation." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    long long total = 0;
+    for (int run = 0; run < runCount; ++run) {
+        total += runSizes[run] > 0 ? runSizes[run] : 0;
+    }
+    if (total <= 0 || total > std::numeric_limits<int>::max()) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid mergeManySortedMemory operation: Invalid total size." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    T* mergedBlock = allocateMemory(static_cast<int>(total));
+    if (mergedBlock != nullptr) {
+        mergedSize = mergeManySortedMemory(runs, runSizes, runCount, mergedBlock);
+    }
+
+    return mergedBlock;
+}
+
+/**
+ * @brief Merges many sorted memory blocks into a caller-provided block.
+ *
+ * @details This overload behaves like the allocating mergeManySortedMemory, but writes into destination, which
+ * must hold the sum of runSizes elements. If the inputs are invalid, the function prints an error message and
+ * returns 0.
+ *
+ * @param runs An array of pointers to the sorted memory blocks.
+ * @param runSizes An array with the size of every memory block.
+ * @param runCount The number of memory blocks.
+ * @param destination A pointer to the output memory block.
+ * @return The number of elements written to the destination.
+ */
+template <typename T>
+inline int MemoryManager<T>::mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, T* destination) {
+    return mergeManySortedMemory(runs, runSizes, runCount, destination, ExecutionPolicy::sequential());
+}
+
+/**
+ * @brief Merges many sorted memory blocks into a caller-provided block using an execution policy.
+ *
+ * @details A parallel policy samples every run in proportion to its size and picks splitter keys at even
+ * quantiles of the samples. Cutting every run at the lower bound of each splitter yields independent
+ * slices of the output, which the threads merge concurrently with their own loser trees, each writing
+ * straight to its offset in destination.
+ *
+ * @param runs An array of pointers to the sorted memory blocks.
+ * @param runSizes An array with the size of every memory block.
+ * @param runCount The number of memory blocks.
+ * @param destination A pointer to the output memory block.
+ * @param policy The execution policy to apply.
+ * @return The number of elements written to the destination.
+ */
+template <typename T>
+inline int MemoryManager<T>::mergeManySortedMemory(const T* const* runs, const int* runSizes, int runCount, T* destination, const ExecutionPolicy& policy) {
+    if (runs == nullptr || runSizes == nullptr || runCount <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid mergeManySortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    std::size_t runTotal = static_cast<std::size_t>(runCount);
+    std::vector<const T*> begins(runTotal), ends(runTotal);
+    std::size_t total = 0;
+    for (std::size_t run = 0; run < runTotal; ++run) {
+        if (runs[run] == nullptr && runSizes[run] > 0) {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid mergeManySortedMemory operation: Null run at index " << run << "." << std::endl;
+#endif
+            return 0;
+        }
+        std::size_t runSize = runSizes[run] > 0 ? static_cast<std::size_t>(runSizes[run]) : 0;
+        begins[run] = runs[run];
+        ends[run] = runs[run] + runSize;
+        total += runSize;
+    }
+
+    unsigned int threads = parallelThreadCount(static_cast<int>(std::min<std::size_t>(total, std::numeric_limits<int>::max())), policy);
+    if (threads <= 1) {
+        loserTreeMerge(begins.data(), ends.data(), runTotal, destination);
+        return static_cast<int>(total);
+    }
+
+    // Every sample stands for the elements between it and the next sample of its run.
+    const std::size_t samplesPerThread = 16;
+    std::size_t sampleStride = std::max<std::size_t>(total / (threads * samplesPerThread), 1);
+    std::vector<std::pair<T, std::size_t>> samples;
+    for (std::size_t run = 0; run < runTotal; ++run) {
+        std::size_t runSize = static_cast<std::size_t>(ends[run] - begins[run]);
+        for (std::size_t position = sampleStride / 2; position < runSize; position += sampleStride) {
+            samples.push_back(std::make_pair(begins[run][position], std::min(sampleStride, runSize - position)));
+        }
+    }
+    std::sort(samples.begin(), samples.end(), [](const std::pair<T, std::size_t>& left, const std::pair<T, std::size_t>& right) {
+        return left.first < right.first;
+    });
+
+    std::vector<T> splitters;
+    std::size_t covered = 0;
+    std::size_t nextQuantile = 1;
+    for (std::size_t sample = 0; sample < samples.size() && nextQuantile < threads; ++sample) {
+        covered += samples[sample].second;
+        if (covered >= total / threads * nextQuantile) {
+            splitters.push_back(samples[sample].first);
+            ++nextQuantile;
+        }
+    }
+
+    std::size_t segmentCount = splitters.size() + 1;
+    std::vector<const T*> cuts(runTotal * (segmentCount + 1));
+    std::vector<std::size_t> outputStarts(segmentCount + 1, 0);
+    for (std::size_t run = 0; run < runTotal; ++run) {
+        cuts[run] = begins[run];
+        cuts[segmentCount * runTotal + run] = ends[run];
+        for (std::size_t segment = 1; segment < segmentCount; ++segment) {
+            cuts[segment * runTotal + run] = std::lower_bound(cuts[(segment - 1) * runTotal + run], ends[run], splitters[segment - 1]);
+        }
+    }
+    for (std::size_t segment = 0; segment < segmentCount; ++segment) {
+        std::size_t segmentSize = 0;
+        for (std::size_t run = 0; run < runTotal; ++run) {
+            segmentSize += static_cast<std::size_t>(cuts[(segment + 1) * runTotal + run] - cuts[segment * runTotal + run]);
+        }
+        outputStarts[segment + 1] = outputStarts[segment] + segmentSize;
+    }
+
+    threadPool->parallelFor(segmentCount, 1, threads, [&](std::size_t segment, std::size_t) {
+        loserTreeMerge(&cuts[segment * runTotal], &cuts[(segment + 1) * runTotal], runTotal, destination + outputStarts[segment]);
+    });
+
+    return static_cast<int>(total);
+}
+
+/**
+ * @brief Finds the first element not less than key with an exponential (galloping) search.
+ *
+ * @details The search probes begin + 1, begin + 3, begin + 7, ... until it overshoots the key and then
+ * binary searches the last gap, so the cost grows with the log of the distance travelled instead of the
+ * log of the block size.
+ *
+ * @param block A pointer to the sorted memory block.
+ * @param begin The index to start searching from.
+ * @param size The size of the memory block.
+ * @param key The value to search for.
+ * @return The index of the first element in [begin, size) not less than key, or size if there is none.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::gallopLowerBound(const T* block, std::size_t begin, std::size_t size, const T& key) {
+    if (begin >= size || !(block[begin] < key)) {
+        return begin;
+    }
+
+    std::size_t step = 1;
+    std::size_t low = begin;
+    std::size_t high = begin + step;
+    while (high < size && block[high] < key) {
+        low = high;
+        step *= 2;
+        high = begin + step;
+    }
+    high = std::min(high, size);
+
+    return low + 1 + branchlessBound<false>(block + low + 1, high - low - 1, key);
+}
+
+/**
+ * @brief Intersects a small sorted range with a much larger one by galloping through the larger.
+ *
+ * @param smaller A pointer to the smaller sorted range.
+ * @param smallerSize The size of the smaller range.
+ * @param larger A pointer to the larger sorted range.
+ * @param largerSize The size of the larger range.
+ * @param destination A pointer to the output; it may alias either input, since every match advances
+ * both read positions past the write position.
+ * @return The number of distinct common values written.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::intersectGalloping(const T* smaller, std::size_t smallerSize, const T* larger, std::size_t largerSize, T* destination) {
+    std::size_t k = 0;
+    std::size_t position = 0;
+
+    for (std::size_t i = 0; i < smallerSize && position < largerSize; ++i) {
+        if (i > 0 && smaller[i] == smaller[i - 1]) {
+            continue;
+        }
+
+        position = gallopLowerBound(larger, position, largerSize, smaller[i]);
+        if (position < largerSize && !(smaller[i] < larger[position])) {
+            destination[k++] = smaller[i];
+            ++position;
+        }
+    }
+
+    return k;
+}
+
+/**
+ * @brief Intersects two sorted ranges of 32-bit integers four elements at a time.
+ *
+ * @details Each step loads four elements of both ranges and compares the first vector against all four
+ * rotations of the second, so one mask reports every match in the 4x4 block. The range whose block ends
+ * with the smaller value then advances by a whole block, which removes the data-dependent branch of a
+ * scalar merge. Without SSE2 this falls back to the scalar merge.
+ *
+ * @param block1 A pointer to the first sorted range.
+ * @param size1 The size of the first range.
+ * @param block2 A pointer to the second sorted range.
+ * @param size2 The size of the second range.
+ * @param destination A pointer to the output; it may alias block1.
+ * @return The number of distinct common values written.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::intersectBlocks(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination, std::true_type) {
+#ifdef PTRX_SSE2
+    std::size_t i = 0, j = 0, k = 0;
+
+    while (i + 4 <= size1 && j + 4 <= size2) {
+        __m128i values1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block1 + i));
+        __m128i values2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block2 + j));
+
+        __m128i matches = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(values1, values2),
+                _mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(1, 0, 3, 2))),
+                _mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+
+        for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+            if ((mask & 1) && (k == 0 || !(destination[k - 1] == block1[i + lane]))) {
+                destination[k++] = block1[i + lane];
+            }
+        }
+
+        T last1 = block1[i + 3];
+        T last2 = block2[j + 3];
+        if (!(last2 < last1)) {
+            i += 4;
+        }
+        if (!(last1 < last2)) {
+            j += 4;
+        }
+    }
+
+    while (i < size1 && j < size2) {
+        if (block1[i] < block2[j]) {
+            ++i;
+        }
+        else if (block2[j] < block1[i]) {
+            ++j;
+        }
+        else {
+            if (k == 0 || !(destination[k - 1] == block1[i])) {
+                destination[k++] = block1[i];
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    return k;
+#else
+    return intersectBlocks(block1, size1, block2, size2, destination, std::false_type());
+#endif
+}
+
+/**
+ * @brief Intersects two sorted ranges of similar size with a scalar merge.
+ *
+ * @param block1 A pointer to the first sorted range.
+ * @param size1 The size of the first range.
+ * @param block2 A pointer to the second sorted range.
+ * @param size2 The size of the second range.
+ * @param destination A pointer to the output; it may alias block1.
+ * @return The number of distinct common values written.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::intersectBlocks(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination, std::false_type) {
+    std::size_t i = 0, j = 0, k = 0;
+
+    while (i < size1 && j < size2) {
+        if (block1[i] < block2[j]) {
+            ++i;
+        }
+        else if (block2[j] < block1[i]) {
+            ++j;
+        }
+        else {
+            if (k == 0 || !(destination[k - 1] == block1[i])) {
+                destination[k++] = block1[i];
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    return k;
+}
+
+/**
+ * @brief Intersects two sorted ranges, choosing the kernel from their size ratio.
+ *
+ * @details When one range is more than 32 times longer than the other, galloping through the long range
+ * skips most of it. Otherwise both ranges are scanned with the block kernel.
+ *
+ * @param block1 A pointer to the first sorted range.
+ * @param size1 The size of the first range.
+ * @param block2 A pointer to the second sorted range.
+ * @param size2 The size of the second range.
+ * @param destination A pointer to the output; it may alias block1.
+ * @return The number of distinct common values written.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::intersectSorted(const T* block1, std::size_t size1, const T* block2, std::size_t size2, T* destination) {
+    const std::size_t gallopingRatio = 32;
+
+    if (size1 * gallopingRatio < size2) {
+        return intersectGalloping(block1, size1, block2, size2, destination);
+    }
+    if (size2 * gallopingRatio < size1) {
+        return intersectGalloping(block2, size2, block1, size1, destination);
+    }
+
+    return intersectBlocks(block1, size1, block2, size2, destination,
+        std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4>());
+}
+
+/**
+ * @brief Computes the intersection of two sorted memory blocks.
+ *
+ * @details This function returns a new memory block holding every value present in both sorted blocks,
+ * once each and in ascending order, and sets intersectionSize to its size. Inputs of similar size are
+ * intersected with a SIMD block kernel for 32-bit integers and a merge otherwise; very skewed inputs gallop
+ * through the larger block. The block is allocated once with room for min(size1, size2) elements. If the inputs
+ * are invalid, it prints an error message, sets intersectionSize to 0, and returns a null pointer.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param intersectionSize Reference to store the size of the resulting intersection.
+ * @return A pointer to the memory block containing the intersection, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::intersectSortedMemory(const T* block1, int size1, const T* block2, int size2, int& intersectionSize) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid intersectSortedMemory operation." << std::endl;
+#endif
+        intersectionSize = 0;
+        return nullptr;
+    }
+
+    T* intersectionMemory = allocateMemory(std::min(size1, size2));
+    intersectionSize = intersectionMemory != nullptr ? static_cast<int>(intersectSorted(block1, size1, block2, size2, intersectionMemory)) : 0;
+
+    return intersectionMemory;
+}
+
+/**
+ * @brief Computes the intersection of two sorted memory blocks into a caller-provided block.
+ *
+ * @details This overload behaves like the allocating intersectSortedMemory, but writes into destination,
+ * which must hold min(size1, size2) elements. If the inputs are invalid, the function prints an error
+ * message and returns 0.
+ *
+ * @param block1 A pointer to the first sorted memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second sorted memory block.
+ * @param size2 The size of the second memory block.
+ * @param destination A pointer to the output memory block.
+ * @return The number of elements in the intersection.
+ */
+template <typename T>
+inline int MemoryManager<T>::intersectSortedMemory(const T* block1, int size1, const T* block2, int size2, T* destination) {
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0 || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid intersectSortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    return static_cast<int>(intersectSorted(block1, size1, block2, size2, destination));
+}
+
+/**
+ * @brief Computes the intersection of many sorted memory blocks.
+ *
+ * @details This function intersects blockCount sorted blocks, smallest first. The running result only
+ * shrinks, so after the first step it is usually far smaller than the remaining blocks and the adaptive
+ * kernel gallops through them. The function stops early once the result is empty. blocks[i] points to the
+ * i-th block and blockSizes[i] holds its size. If the inputs are invalid, it prints an error message,
+ * sets intersectionSize to 0, and returns a null pointer.
+ *
+ * @param blocks An array of pointers to the sorted memory blocks.
+ * @param blockSizes An array with the size of every memory block.
+ * @param blockCount The number of memory blocks.
+ * @param intersectionSize Reference to store the size of the resulting intersection.
+ * @return A pointer to the memory block containing the intersection, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::intersectManySortedMemory(const T* const* blocks, const int* blockSizes, int blockCount, int& intersectionSize) {
+    intersectionSize = 0;
+    if (blocks == nullptr || blockSizes == nullptr || blockCount <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid intersectManySortedMemory operation." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    std::vector<int> order(blockCount);
+    for (int block = 0; block < blockCount; ++block) {
+        if (blocks[block] == nullptr || blockSizes[block] <= 0) {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid intersectManySortedMemory operation: Null or empty block at index " << block << "." << std::endl;
+#endif
+            return nullptr;
+        }
+        order[block] = block;
+    }
+    std::sort(order.begin(), order.end(), [blockSizes](int left, int right) { return blockSizes[left] < blockSizes[right]; });
+
+    T* intersectionMemory = allocateMemory(blockSizes[order[0]]);
+    if (intersectionMemory == nullptr) {
+        return nullptr;
+    }
+
+    // Start from the distinct values of the smallest block, then narrow it down in place.
+    std::size_t resultSize = 0;
+    const T* smallest = blocks[order[0]];
+    for (int i = 0; i < blockSizes[order[0]]; ++i) {
+        if (resultSize == 0 || !(intersectionMemory[resultSize - 1] == smallest[i])) {
+            intersectionMemory[resultSize++] = smallest[i];
+        }
+    }
+
+    for (int step = 1; step < blockCount && resultSize > 0; ++step) {
+        resultSize = intersectSorted(intersectionMemory, resultSize, blocks[order[step]], blockSizes[order[step]], intersectionMemory);
+    }
+
+    intersectionSize = static_cast<int>(resultSize);
+    return intersectionMemory;
+}
+
+/**
+ * @brief Constructs an empty CompressedBitmap.
+ *
+ * @details A CompressedBitmap stores a set of int values split into 64K-value chunks by their high 16 bits.
+ * Each chunk is kept in whichever container is smallest: a sorted array of 16-bit values for sparse chunks,
+ * a 65536-bit bitmap for dense chunks, or a list of runs for chunks made of long consecutive ranges.
+ */
+inline CompressedBitmap::CompressedBitmap() {
+}
+
+/**
+ * @brief Builds a CompressedBitmap from a sorted memory block.
+ *
+ * @details Repeated values are stored once. If the block is nullptr or the size is invalid, the function
+ * prints an error message and returns an empty bitmap.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @return A CompressedBitmap holding the distinct values of the block.
+ */
+inline CompressedBitmap CompressedBitmap::fromSortedMemory(const int* sortedBlock, int size) {
+    CompressedBitmap bitmap;
+    if (sortedBlock == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid fromSortedMemory operation." << std::endl;
+#endif
+        return bitmap;
+    }
+
+    std::vector<std::uint16_t> lows;
+    lows.reserve(std::min(size, 65536));
+
+    int i = 0;
+    while (i < size) {
+        std::uint16_t key = static_cast<std::uint16_t>(toUnsigned(sortedBlock[i]) >> 16);
+        lows.clear();
+        for (; i < size && static_cast<std::uint16_t>(toUnsigned(sortedBlock[i]) >> 16) == key; ++i) {
+            std::uint16_t low = static_cast<std::uint16_t>(toUnsigned(sortedBlock[i]));
+            if (lows.empty() || lows.back() != low) {
+                lows.push_back(low);
+            }
+        }
+        bitmap.containers.push_back(makeContainer(key, lows.data(), lows.size()));
+    }
+
+    return bitmap;
+}
+
+/**
+ * @brief Writes the values of the bitmap to a memory block in ascending order.
+ *
+ * @details The destination must hold cardinality() elements. If the destination is nullptr while the bitmap
+ * is not empty, the function prints an error message and returns 0.
+ *
+ * @param destination A pointer to the output memory block.
+ * @return The number of values written.
+ */
+inline int CompressedBitmap::toSortedMemory(int* destination) const {
+    if (destination == nullptr && !containers.empty()) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid toSortedMemory operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    int k = 0;
+    for (const Container& container : containers) {
+        std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+        if (container.type == ArrayContainer) {
+            for (std::uint16_t low : container.values) {
+                destination[k++] = toSigned(high | low);
+            }
+        }
+        else if (container.type == RunContainer) {
+            for (std::size_t run = 0; run < container.values.size(); run += 2) {
+                std::uint32_t start = container.values[run];
+                std::uint32_t end = start + container.values[run + 1];
+                for (std::uint32_t low = start; low <= end; ++low) {
+                    destination[k++] = toSigned(high | low);
+                }
+            }
+        }
+        else {
+            for (std::uint32_t word = 0; word < 1024; ++word) {
+                std::uint64_t bits = container.words[word];
+                while (bits != 0) {
+                    std::uint64_t lowest = bits & (~bits + 1);
+                    destination[k++] = toSigned(high | (word * 64 + static_cast<std::uint32_t>(popcount64(lowest - 1))));
+                    bits ^= lowest;
+                }
+            }
+        }
+    }
+
+    return k;
+}
+
+/**
+ * @brief Adds a value to the bitmap.
+ *
+ * @details Array containers convert to bitmaps once they grow past 4096 values. Run containers are
+ * expanded, updated and stored again in their smallest form.
+ *
+ * @param value The value to add.
+ */
+inline void CompressedBitmap::add(int value) {
+    std::uint32_t unsignedValue = toUnsigned(value);
+    std::uint16_t key = static_cast<std::uint16_t>(unsignedValue >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(unsignedValue);
+
+    auto position = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& container, std::uint16_t searchKey) { return container.key < searchKey; });
+    if (position == containers.end() || position->key != key) {
+        containers.insert(position, makeContainer(key, &low, 1));
+        return;
+    }
+
+    Container& container = *position;
+    if (containsLow(container, low)) {
+        return;
+    }
+
+    if (container.type == ArrayContainer && container.cardinality < 4096) {
+        container.values.insert(std::lower_bound(container.values.begin(), container.values.end(), low), low);
+        ++container.cardinality;
+    }
+    else if (container.type == BitmapContainer) {
+        container.words[low / 64] |= std::uint64_t(1) << (low % 64);
+        ++container.cardinality;
+    }
+    else {
+        std::vector<std::uint64_t> words(1024, 0);
+        toWords(container, words.data());
+        words[low / 64] |= std::uint64_t(1) << (low % 64);
+        container = makeContainer(key, words.data());
+    }
+}
+
+/**
+ * @brief Checks if a value is in the bitmap.
+ *
+ * @param value The value to look up.
+ * @return True if the bitmap contains the value, false otherwise.
+ */
+inline bool CompressedBitmap::contains(int value) const {
+    std::uint32_t unsignedValue = toUnsigned(value);
+    std::uint16_t key = static_cast<std::uint16_t>(unsignedValue >> 16);
+
+    auto position = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& container, std::uint16_t searchKey) { return container.key < searchKey; });
+    return position != containers.end() && position->key == key
+        && containsLow(*position, static_cast<std::uint16_t>(unsignedValue));
+}
+
+/**
+ * @brief Returns the number of values in the bitmap.
+ *
+ * @return The cardinality of the bitmap.
+ */
+inline std::size_t CompressedBitmap::cardinality() const {
+    std::size_t total = 0;
+    for (const Container& container : containers) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the memory used by the bitmap's containers.
+ *
+ * @details The figure counts the payload of every container plus 8 bytes for its key, type and
+ * cardinality. Compare it with cardinality() * sizeof(int) for the footprint of the same set as a sorted block.
+ *
+ * @return The size of the bitmap in bytes.
+ */
+inline std::size_t CompressedBitmap::sizeInBytes() const {
+    std::size_t bytes = 0;
+    for (const Container& container : containers) {
+        bytes += 8 + container.values.size() * sizeof(std::uint16_t) + container.words.size() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Computes the union of two bitmaps.
+ *
+ * @param other The bitmap to combine with.
+ * @return A bitmap holding every value found in either bitmap.
+ */
+inline CompressedBitmap CompressedBitmap::unionWith(const CompressedBitmap& other) const {
+    return combine(*this, other, BitmapUnion);
+}
+
+/**
+ * @brief Computes the intersection of two bitmaps.
+ *
+ * @param other The bitmap to combine with.
+ * @return A bitmap holding every value found in both bitmaps.
+ */
+inline CompressedBitmap CompressedBitmap::intersectWith(const CompressedBitmap& other) const {
+    return combine(*this, other, BitmapIntersection);
+}
+
+/**
+ * @brief Computes the difference of two bitmaps.
+ *
+ * @param other The bitmap whose values are removed.
+ * @return A bitmap holding the values of this bitmap that are not in other.
+ */
+inline CompressedBitmap CompressedBitmap::differenceWith(const CompressedBitmap& other) const {
+    return combine(*this, other, BitmapDifference);
+}
+
+/**
+ * @brief Computes the symmetric difference of two bitmaps.
+ *
+ * @param other The bitmap to combine with.
+ * @return A bitmap holding the values found in exactly one of the bitmaps.
+ */
+inline CompressedBitmap CompressedBitmap::xorWith(const CompressedBitmap& other) const {
+    return combine(*this, other, BitmapXor);
+}
+
+/**
+ * @brief Combines two bitmaps chunk by chunk.
+ *
+ * @details Chunks present on one side only are copied or dropped depending on the operation, without
+ * looking at their contents. Chunks present on both sides are combined by combineContainers, and chunks
+ * that end up empty are dropped.
+ *
+ * @param left The left-hand bitmap.
+ * @param right The right-hand bitmap.
+ * @param operation The operation to apply.
+ * @return The combined bitmap.
+ */
+inline CompressedBitmap CompressedBitmap::combine(const CompressedBitmap& left, const CompressedBitmap& right, BitmapOperation operation) {
+    CompressedBitmap result;
+    bool keepLeftOnly = operation != BitmapIntersection;
+    bool keepRightOnly = operation == BitmapUnion || operation == BitmapXor;
+
+    std::size_t i = 0, j = 0;
+    while (i < left.containers.size() || j < right.containers.size()) {
+        if (j == right.containers.size() || (i < left.containers.size() && left.containers[i].key < right.containers[j].key)) {
+            if (keepLeftOnly) {
+                result.containers.push_back(left.containers[i]);
+            }
+            ++i;
+        }
+        else if (i == left.containers.size() || right.containers[j].key < left.containers[i].key) {
+            if (keepRightOnly) {
+                result.containers.push_back(right.containers[j]);
+            }
+            ++j;
+        }
+        else {
+            Container container = combineContainers(left.containers[i], right.containers[j], operation);
+            if (container.cardinality > 0) {
+                result.containers.push_back(std::move(container));
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Combines two containers that share a key.
+ *
+ * @details Pairs involving an array container are handled on the sorted values directly, probing the other
+ * container for every value; two arrays are also united that way while their sizes sum to at most 4096, so
+ * sparse unions never touch a bitmap. All other pairs are expanded to 1024-word bitmaps and combined word by
+ * word in a loop the compiler vectorizes; the result is then stored in its smallest representation.
+ *
+ * @param left The left-hand container.
+ * @param right The right-hand container.
+ * @param operation The operation to apply.
+ * @return The combined container; its cardinality is 0 if it is empty.
+ */
+inline CompressedBitmap::Container CompressedBitmap::combineContainers(const Container& left, const Container& right, BitmapOperation operation) {
+    std::vector<std::uint16_t> values;
+
+    if (left.type == ArrayContainer && right.type == ArrayContainer
+        && (operation != BitmapUnion || left.values.size() + right.values.size() <= 4096)) {
+        if (operation == BitmapUnion) {
+            std::set_union(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(), std::back_inserter(values));
+        }
+        else if (operation == BitmapIntersection) {
+            std::set_intersection(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(), std::back_inserter(values));
+        }
+        else if (operation == BitmapDifference) {
+            std::set_difference(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(), std::back_inserter(values));
+        }
+        else {
+            std::set_symmetric_difference(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(), std::back_inserter(values));
+        }
+        return makeContainer(left.key, values.data(), values.size());
+    }
+
+    if ((operation == BitmapIntersection || operation == BitmapDifference) && left.type == ArrayContainer) {
+        bool keepMatches = operation == BitmapIntersection;
+        for (std::uint16_t low : left.values) {
+            if (containsLow(right, low) == keepMatches) {
+                values.push_back(low);
+            }
+        }
+        return makeContainer(left.key, values.data(), values.size());
+    }
+
+    if (operation == BitmapIntersection && right.type == ArrayContainer) {
+        for (std::uint16_t low : right.values) {
+            if (containsLow(left, low)) {
+                values.push_back(low);
+            }
+        }
+        return makeContainer(left.key, values.data(), values.size());
+    }
+
+    std::vector<std::uint64_t> leftWords(1024, 0), rightWords(1024, 0);
+    toWords(left, leftWords.data());
+    toWords(right, rightWords.data());
+
+    std::uint64_t* output = leftWords.data();
+    const std::uint64_t* input = rightWords.data();
+    switch (operation) {
+    case BitmapUnion:
+        for (int word = 0; word < 1024; ++word) {
+            output[word] |= input[word];
+        }
+        break;
+    case BitmapIntersection:
+        for (int word = 0; word < 1024; ++word) {
+            output[word] &= input[word];
+        }
+        break;
+    case BitmapDifference:
+        for (int word = 0; word < 1024; ++word) {
+            output[word] &= ~input[word];
+        }
+        break;
+    case BitmapXor:
+        for (int word = 0; word < 1024; ++word) {
+            output[word] ^= input[word];
+        }
+        break;
+    }
+
+    return makeContainer(left.key, output);
+}
+
+/**
+ * @brief Builds the smallest container for a sorted list of distinct 16-bit values.
+ *
+ * @details An array costs 2 bytes per value, a bitmap a fixed 8 KiB, and a run container 4 bytes per run
+ * of consecutive values.
+ *
+ * @param key The high 16 bits shared by the values.
+ * @param values A pointer to the sorted, distinct low 16 bits of the values.
+ * @param count The number of values.
+ * @return The container holding the values.
+ */
+inline CompressedBitmap::Container CompressedBitmap::makeContainer(std::uint16_t key, const std::uint16_t* values, std::size_t count) {
+    std::size_t runCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i == 0 || values[i] != values[i - 1] + 1) {
+            ++runCount;
+        }
+    }
+
+    Container container;
+    container.key = key;
+    container.cardinality = static_cast<std::uint32_t>(count);
+
+    if (runCount * 4 < std::min<std::size_t>(count * 2, 8192)) {
+        container.type = RunContainer;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i == 0 || values[i] != values[i - 1] + 1) {
+                container.values.push_back(values[i]);
+                container.values.push_back(0);
+            }
+            else {
+                ++container.values.back();
+            }
+        }
+    }
+    else if (count <= 4096) {
+        container.type = ArrayContainer;
+        container.values.assign(values, values + count);
+    }
+    else {
+        container.type = BitmapContainer;
+        container.words.assign(1024, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            container.words[values[i] / 64] |= std::uint64_t(1) << (values[i] % 64);
+        }
+    }
+
+    return container;
+}
+
+/**
+ * @brief Builds the smallest container for a 1024-word bitmap.
+ *
+ * @details One pass over the words counts both the values and the runs with popcount: a run starts at
+ * every set bit whose lower neighbour is clear.
+ *
+ * @param key The high 16 bits shared by the values.
+ * @param words A pointer to the 1024 words of the bitmap.
+ * @return The container holding the values; its cardinality is 0 if the bitmap is empty.
+ */
+inline CompressedBitmap::Container CompressedBitmap::makeContainer(std::uint16_t key, const std::uint64_t* words) {
+    std::size_t count = 0;
+    std::size_t runCount = 0;
+    for (int word = 0; word < 1024; ++word) {
+        std::uint64_t previous = (words[word] << 1) | (word > 0 ? words[word - 1] >> 63 : 0);
+        count += static_cast<std::size_t>(popcount64(words[word]));
+        runCount += static_cast<std::size_t>(popcount64(words[word] & ~previous));
+    }
+
+    if (count <= 4096 || runCount * 4 < 8192) {
+        std::vector<std::uint16_t> values;
+        values.reserve(count);
+        for (std::uint32_t word = 0; word < 1024; ++word) {
+            std::uint64_t bits = words[word];
+            while (bits != 0) {
+                std::uint64_t lowest = bits & (~bits + 1);
+                values.push_back(static_cast<std::uint16_t>(word * 64 + static_cast<std::uint32_t>(popcount64(lowest - 1))));
+                bits ^= lowest;
+            }
+        }
+        return makeContainer(key, values.data(), values.size());
+    }
+
+    Container container;
+    container.type = BitmapContainer;
+    container.key = key;
+    container.cardinality = static_cast<std::uint32_t>(count);
+    container.words.assign(words, words + 1024);
+    return container;
+}
+
+/**
+ * @brief Expands a container into a zeroed 1024-word bitmap.
+ *
+ * @param container The container to expand.
+ * @param words A pointer to 1024 zeroed words receiving the bits.
+ */
+inline void CompressedBitmap::toWords(const Container& container, std::uint64_t* words) {
+    if (container.type == BitmapContainer) {
+        std::copy(container.words.begin(), container.words.end(), words);
+    }
+    else if (container.type == ArrayContainer) {
+        for (std::uint16_t low : container.values) {
+            words[low / 64] |= std::uint64_t(1) << (low % 64);
+        }
+    }
+    else {
+        for (std::size_t run = 0; run < container.values.size(); run += 2) {
+            std::uint32_t start = container.values[run];
+            std::uint32_t end = start + container.values[run + 1];
+            std::uint32_t firstWord = start / 64;
+            std::uint32_t lastWord = end / 64;
+            std::uint64_t firstMask = ~std::uint64_t(0) << (start % 64);
+            std::uint64_t lastMask = ~std::uint64_t(0) >> (63 - end % 64);
+
+            if (firstWord == lastWord) {
+                words[firstWord] |= firstMask & lastMask;
+            }
+            else {
+                words[firstWord] |= firstMask;
+                for (std::uint32_t word = firstWord + 1; word < lastWord; ++word) {
+                    words[word] = ~std::uint64_t(0);
+                }
+                words[lastWord] |= lastMask;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks if a container holds a low 16-bit value.
+ *
+ * @param container The container to search.
+ * @param low The low 16 bits of the value.
+ * @return True if the container holds the value, false otherwise.
+ */
+inline bool CompressedBitmap::containsLow(const Container& container, std::uint16_t low) {
+    if (container.type == BitmapContainer) {
+        return (container.words[low / 64] >> (low % 64)) & 1;
+    }
+    if (container.type == ArrayContainer) {
+        return std::binary_search(container.values.begin(), container.values.end(), low);
+    }
+
+    // Runs are stored as (start, length - 1) pairs; find the last run starting at or before low.
+    std::size_t lowIndex = 0, highIndex = container.values.size() / 2;
+    while (lowIndex < highIndex) {
+        std::size_t middle = (lowIndex + highIndex) / 2;
+        if (container.values[middle * 2] <= low) {
+            lowIndex = middle + 1;
+        }
+        else {
+            highIndex = middle;
+        }
+    }
+    if (lowIndex == 0) {
+        return false;
+    }
+    std::uint32_t start = container.values[(lowIndex - 1) * 2];
+    return low <= start + container.values[(lowIndex - 1) * 2 + 1];
+}
+
+/**
+ * @brief Counts the set bits of a 64-bit word.
+ *
+ * @details GCC and Clang lower the builtin to the POPCNT instruction where the target has it. Other
+ * compilers get a branch-free SWAR count that vectorizes inside the word loops.
+ *
+ * @param word The word to count.
+ * @return The number of set bits.
+ */
+inline int CompressedBitmap::popcount64(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Maps an int to an unsigned key that sorts in the same order.
+ *
+ * @param value The value to map.
+ * @return The value with its sign bit flipped.
+ */
+inline std::uint32_t CompressedBitmap::toUnsigned(int value) {
+    return static_cast<std::uint32_t>(value) ^ 0x80000000u;
+}
+
+/**
+ * @brief Maps an unsigned key back to the int it was made from.
+ *
+ * @param value The key to map.
+ * @return The original int value.
+ */
+inline int CompressedBitmap::toSigned(std::uint32_t value) {
+    std::uint32_t flipped = value ^ 0x80000000u;
+    int result;
+    std::memcpy(&result, &flipped, sizeof(result));
+    return result;
+}
+
+/**
+ * @brief Finds the first element of a sorted memory block not less than a key.
+ *
+ * @details The search is branchless: every step halves the range with a conditional move instead of a
+ * jump, so its cost does not depend on mispredicted comparisons. An empty block returns 0. If the block
+ * is nullptr with a positive size, or the size is negative, the function prints an error message and returns -1.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param key The value to search for.
+ * @return The index of the first element not less than key, size if there is none, or -1 on invalid input.
+ */
+template <typename T>
+inline int MemoryManager<T>::lowerBound(const T* sortedBlock, int size, int key) {
+    if ((sortedBlock == nullptr && size > 0) || size < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid lowerBound operation." << std::endl;
+#endif
+        return -1;
+    }
+
+    return static_cast<int>(branchlessBound<false>(sortedBlock, static_cast<std::size_t>(size), static_cast<T>(key)));
+}
+
+/**
+ * @brief Finds the first element of a sorted memory block greater than a key.
+ *
+ * @details Works like lowerBound. If the block is nullptr with a positive size, or the size is negative,
+ * the function prints an error message and returns -1.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param key The value to search for.
+ * @return The index of the first element greater than key, size if there is none, or -1 on invalid input.
+ */
+template <typename T>
+inline int MemoryManager<T>::upperBound(const T* sortedBlock, int size, int key) {
+    if ((sortedBlock == nullptr && size > 0) || size < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid upperBound operation." << std::endl;
+#endif
+        return -1;
+    }
+
+    return static_cast<int>(branchlessBound<true>(sortedBlock, static_cast<std::size_t>(size), static_cast<T>(key)));
+}
+
+/**
+ * @brief Finds the range of elements equal to a key in a sorted memory block.
+ *
+ * @details On return, [first, last) holds every element equal to key; if there is none, first and last both
+ * point to where key would be inserted. The upper bound is searched only from first onwards. If the inputs
+ * are invalid, the function prints an error message, sets both indices to -1 and returns false.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param key The value to search for.
+ * @param first Reference receiving the index of the first element equal to key.
+ * @param last Reference receiving the index one past the last element equal to key.
+ * @return True if the block contains key, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::equalRange(const T* sortedBlock, int size, int key, int& first, int& last) {
+    if ((sortedBlock == nullptr && size > 0) || size < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid equalRange operation." << std::endl;
+#endif
+        first = -1;
+        last = -1;
+        return false;
+    }
+
+    T value = static_cast<T>(key);
+    std::size_t lower = branchlessBound<false>(sortedBlock, static_cast<std::size_t>(size), value);
+    std::size_t upper = lower + branchlessBound<true>(sortedBlock + lower, static_cast<std::size_t>(size) - lower, value);
+
+    first = static_cast<int>(lower);
+    last = static_cast<int>(upper);
+    return lower < upper;
+}
+
+/**
+ * @brief Searches a sorted memory block for many keys in one call.
+ *
+ * @details results[i] receives the index of the first element equal to keys[i], or -1 if there is none,
+ * matching binarySearch. Unsorted keys are searched 16 at a time: the branchless searches advance in lockstep
+ * and each one prefetches its next probe, so up to 16 cache misses are in flight instead of one. Keys in
+ * ascending order, once converted to T, are instead answered by a single forward scan that gallops from the previous match, which
+ * touches each part of the block at most once. If the inputs are invalid, the function prints an error message
+ * and returns false.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param keys A pointer to the keys to search for.
+ * @param keyCount The number of keys.
+ * @param results A pointer to keyCount ints receiving the indices.
+ * @return True if the search was performed, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::batchBinarySearch(const T* sortedBlock, int size, const int* keys, int keyCount, int* results) {
+    if ((sortedBlock == nullptr && size > 0) || size < 0 || ((keys == nullptr || results == nullptr) && keyCount > 0) || keyCount < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid batchBinarySearch operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t blockSize = static_cast<std::size_t>(size);
+    std::size_t count = static_cast<std::size_t>(keyCount);
+    if (blockSize == 0) {
+        std::fill(results, results + count, -1);
+        return true;
+    }
+
+    // The order is checked on the converted keys: for an unsigned T a negative int sorts after every
+    // non-negative one.
+    bool ascending = true;
+    for (std::size_t i = 1; i < count && ascending; ++i) {
+        ascending = !(static_cast<T>(keys[i]) < static_cast<T>(keys[i - 1]));
+    }
+
+    if (ascending) {
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            T key = static_cast<T>(keys[i]);
+            position = gallopLowerBound(sortedBlock, position, blockSize, key);
+            results[i] = position < blockSize && !(key < sortedBlock[position]) ? static_cast<int>(position) : -1;
+        }
+        return true;
+    }
+
+    const std::size_t lanes = 16;
+    const T* bases[lanes];
+    T values[lanes];
+
+    for (std::size_t group = 0; group < count; group += lanes) {
+        std::size_t width = std::min(lanes, count - group);
+        for (std::size_t j = 0; j < width; ++j) {
+            bases[j] = sortedBlock;
+            values[j] = static_cast<T>(keys[group + j]);
+        }
+
+        std::size_t length = blockSize;
+        while (length > 1) {
+            std::size_t half = length / 2;
+            std::size_t nextHalf = (length - half) / 2;
+            for (std::size_t j = 0; j < width; ++j) {
+                bases[j] = bases[j][half] < values[j] ? bases[j] + half : bases[j];
+                PTRX_PREFETCH(bases[j] + nextHalf);
+            }
+            length -= half;
+        }
+
+        for (std::size_t j = 0; j < width; ++j) {
+            std::size_t index = static_cast<std::size_t>(bases[j] - sortedBlock) + (*bases[j] < values[j] ? 1 : 0);
+            results[group + j] = index < blockSize && !(values[j] < sortedBlock[index]) ? static_cast<int>(index) : -1;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Finds the first occurrence of many values in an unsorted memory block.
+ *
+ * @details positions[i] receives the index of the first element equal to values[i], or -1 if there is none.
+ * Instead of one findValue scan per value, the values are sorted once and the block is scanned a single time,
+ * looking up every element among the sorted values with the branchless search. The scan stops as soon as every
+ * distinct value has been found. If the inputs are invalid, the function prints an error message and returns -1.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @param values A pointer to the values to search for.
+ * @param valueCount The number of values.
+ * @param positions A pointer to valueCount ints receiving the indices.
+ * @return The number of values found, or -1 on invalid input.
+ */
+template <typename T>
+inline int MemoryManager<T>::batchFindValue(const T* address, int size, const int* values, int valueCount, int* positions) {
+    if ((address == nullptr && size > 0) || size < 0 || ((values == nullptr || positions == nullptr) && valueCount > 0) || valueCount < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid batchFindValue operation." << std::endl;
+#endif
+        return -1;
+    }
+
+    std::size_t count = static_cast<std::size_t>(valueCount);
+    std::vector<T> sortedValues(values, values + count);
+    std::sort(sortedValues.begin(), sortedValues.end());
+    sortedValues.erase(std::unique(sortedValues.begin(), sortedValues.end()), sortedValues.end());
+
+    std::vector<int> firstIndex(sortedValues.size(), -1);
+    std::size_t remaining = sortedValues.size();
+    for (int i = 0; i < size && remaining > 0; ++i) {
+        std::size_t slot = branchlessBound<false>(sortedValues.data(), sortedValues.size(), address[i]);
+        if (slot < sortedValues.size() && !(address[i] < sortedValues[slot]) && firstIndex[slot] < 0) {
+            firstIndex[slot] = i;
+            --remaining;
+        }
+    }
+
+    int found = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t slot = branchlessBound<false>(sortedValues.data(), sortedValues.size(), static_cast<T>(values[i]));
+        positions[i] = firstIndex[slot];
+        if (positions[i] >= 0) {
+            ++found;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Branchless lower or upper bound over a sorted range.
+ *
+ * @details Each step keeps the lower or upper half with a select the compiler turns into a conditional move,
+ * and prefetches the middle of both candidate halves so the next probe is already on its way from memory
+ * whichever half is chosen.
+ *
+ * @tparam Upper False for the first element not less than key, true for the first element greater than key.
+ * @param block A pointer to the sorted range.
+ * @param size The size of the range.
+ * @param key The value to search for.
+ * @return The index of the bound, or size if every element precedes it.
+ */
+template <typename T>
+template <bool Upper>
+inline std::size_t MemoryManager<T>::branchlessBound(const T* block, std::size_t size, const T& key) {
+    if (size == 0) {
+        return 0;
+    }
+
+    const T* base = block;
+    std::size_t length = size;
+    while (length > 1) {
+        std::size_t half = length / 2;
+        PTRX_PREFETCH(base + half / 2);
+        PTRX_PREFETCH(base + half + half / 2);
+        bool before = Upper ? !(key < base[half]) : (base[half] < key);
+        base = before ? base + half : base;
+        length -= half;
+    }
+
+    bool before = Upper ? !(key < *base) : (*base < key);
+    return static_cast<std::size_t>(base - block) + (before ? 1 : 0);
+}
+
+/**
+ * @brief Constructs an empty EytzingerIndex.
+ *
+ * @details An EytzingerIndex is a copy of a sorted block laid out in breadth-first (Eytzinger) order: the
+ * root at position 1 and the children of position k at 2k and 2k + 1. The top levels of the tree share a few
+ * cache lines, and the 16 or so descendants four levels down sit in one line that can be prefetched ahead of
+ * the search. It pays off for many lookups against one read-only block; queries return indices into the
+ * original block, computed from the tree position without a rank table.
+ */
+template <typename T>
+inline EytzingerIndex<T>::EytzingerIndex() : height(0), lastLevelCount(0) {
+}
+
+/**
+ * @brief Constructs an EytzingerIndex over a sorted memory block.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ */
+template <typename T>
+inline EytzingerIndex<T>::EytzingerIndex(const T* sortedBlock, int size) : height(0), lastLevelCount(0) {
+    build(sortedBlock, size);
+}
+
+/**
+ * @brief Rebuilds the index over a sorted memory block.
+ *
+ * @details Every tree position is filled from the sorted element at its in-order rank. If the block is nullptr or the size is invalid, the function prints an error message, leaves the
+ * index empty and returns false.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @return True if the index was built, false otherwise.
+ */
+template <typename T>
+inline bool EytzingerIndex<T>::build(const T* sortedBlock, int size) {
+    nodes.clear();
+    height = 0;
+    lastLevelCount = 0;
+    if (sortedBlock == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid EytzingerIndex build operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    nodes.resize(count + 1);
+    height = floorLog2(count);
+    lastLevelCount = count - (std::size_t(1) << height) + 1;
+    for (std::size_t k = 1; k <= count; ++k) {
+        nodes[k] = sortedBlock[rankOf(k)];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the number of elements in the index.
+ *
+ * @return The number of indexed elements.
+ */
+template <typename T>
+inline int EytzingerIndex<T>::size() const {
+    return nodes.empty() ? 0 : static_cast<int>(nodes.size() - 1);
+}
+
+/**
+ * @brief Finds the first element not less than a key.
+ *
+ * @param key The value to search for.
+ * @return The index in the original block of the first element not less than key, or size() if there is none.
+ */
+template <typename T>
+inline int EytzingerIndex<T>::lowerBound(const T& key) const {
+    std::size_t k = descend<false>(key);
+    return k == 0 ? size() : static_cast<int>(rankOf(k));
+}
+
+/**
+ * @brief Finds the first element greater than a key.
+ *
+ * @param key The value to search for.
+ * @return The index in the original block of the first element greater than key, or size() if there is none.
+ */
+template <typename T>
+inline int EytzingerIndex<T>::upperBound(const T& key) const {
+    std::size_t k = descend<true>(key);
+    return k == 0 ? size() : static_cast<int>(rankOf(k));
+}
+
+/**
+ * @brief Finds the first element equal to a key.
+ *
+ * @param key The value to search for.
+ * @return The index in the original block of the first element equal to key, or -1 if there is none.
+ */
+template <typename T>
+inline int EytzingerIndex<T>::find(const T& key) const {
+    std::size_t k = descend<false>(key);
+    return k != 0 && !(key < nodes[k]) ? static_cast<int>(rankOf(k)) : -1;
+}
+
+/**
+ * @brief Descends the Eytzinger tree to a lower or upper bound.
+ *
+ * @details The descent is branchless and prefetches the node 4 levels below the current one, which is the
+ * first of the up to 16 descendants the search can reach by then. When the descent falls off the tree, the
+ * trailing right turns are undone to recover the last node where it went left, which is the answer.
+ *
+ * @tparam Upper False for the first element not less than key, true for the first element greater than key.
+ * @param key The value to search for.
+ * @return The tree position of the bound, or 0 if every element precedes it.
+ */
+template <typename T>
+template <bool Upper>
+inline std::size_t EytzingerIndex<T>::descend(const T& key) const {
+    std::size_t count = static_cast<std::size_t>(size());
+    std::size_t k = 1;
+    while (k <= count) {
+        PTRX_PREFETCH(nodes.data() + std::min(16 * k, count));
+        bool right = Upper ? !(key < nodes[k]) : (nodes[k] < key);
+        k = 2 * k + (right ? 1 : 0);
+    }
+
+    while (k % 2 == 1) {
+        k /= 2;
+    }
+    return k / 2;
+}
+
+/**
+ * @brief Maps a tree position to the index of its element in the sorted block.
+ *
+ * @details In a perfect tree of the same height, the node at depth d and offset i has in-order rank
+ * ((2i + 1) << (height - d)) - 1, and the bottom-level slots sit at the even ranks. The tree is only filled
+ * up to lastLevelCount bottom-level slots, so the missing slots ranked below the node are subtracted.
+ *
+ * @param k The tree position, from 1 to size().
+ * @return The index of the element at position k in the sorted block.
+ */
+template <typename T>
+inline std::size_t EytzingerIndex<T>::rankOf(std::size_t k) const {
+    std::size_t depth = floorLog2(k);
+    std::size_t perfectRank = ((2 * (k - (std::size_t(1) << depth)) + 1) << (height - depth)) - 1;
+    std::size_t bottomSlotsBelow = (perfectRank + 1) / 2;
+    return perfectRank - (bottomSlotsBelow > lastLevelCount ? bottomSlotsBelow - lastLevelCount : 0);
+}
+
+/**
+ * @brief Computes the floor of the base-2 logarithm of a positive value.
+ *
+ * @param value The value, which must be positive.
+ * @return The index of the highest set bit of value.
+ */
+template <typename T>
+inline std::size_t EytzingerIndex<T>::floorLog2(std::size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+    std::size_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/**
+ * @brief Constructs an empty RadixSplineIndex.
+ *
+ * @details A RadixSplineIndex is a learned index over a read-mostly sorted block of integers. It models the
+ * position of every key with a linear spline whose error is at most maxError positions, and a radix table on
+ * the top bits of the key narrows the spline search to a few points. A lookup therefore costs a table read,
+ * a short search among spline points, an interpolation, and a final search in a window of about 2 * maxError
+ * elements. The index does not own the block; lookups take the same block it was built over.
+ */
+template <typename T>
+inline RadixSplineIndex<T>::RadixSplineIndex()
+    : minKey(0), maxKey(0), elementCount(0), maxError(0), radixBits(0), shift(0) {
+}
+
+/**
+ * @brief Constructs a RadixSplineIndex over a sorted memory block.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param maxError The largest allowed distance between a predicted and an actual position.
+ * @param radixBits The number of key bits used by the radix table, or 0 to size it from the spline.
+ */
+template <typename T>
+inline RadixSplineIndex<T>::RadixSplineIndex(const T* sortedBlock, int size, int maxError, int radixBits)
+    : minKey(0), maxKey(0), elementCount(0), maxError(0), radixBits(0), shift(0) {
+    build(sortedBlock, size, maxError, radixBits);
+}
+
+/**
+ * @brief Rebuilds the index over a sorted memory block in one pass.
+ *
+ * @details The spline is fitted with a greedy corridor: the slopes from the last spline point to each new
+ * key, plus or minus maxError, narrow a cone, and a new spline point is emitted once a key falls outside it.
+ * Repeated keys map to their first position. If the inputs are invalid, the function prints an error message,
+ * leaves the index empty and returns false.
+ *
+ * @param sortedBlock A pointer to the sorted memory block.
+ * @param size The size of the sorted memory block.
+ * @param maxError The largest allowed distance between a predicted and an actual position.
+ * @param radixBits The number of key bits used by the radix table (at most 24), or 0 to size it from the spline.
+ * @return True if the index was built, false otherwise.
+ */
+template <typename T>
+inline bool RadixSplineIndex<T>::build(const T* sortedBlock, int size, int maxError, int radixBits) {
+    static_assert(std::is_integral<T>::value, "RadixSplineIndex requires an integer element type.");
+
+    points.clear();
+    radixTable.clear();
+    elementCount = 0;
+    if (sortedBlock == nullptr || size <= 0 || maxError < 0 || radixBits < 0 || radixBits > 24) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex build operation." << std::endl;
+#endif
+        return false;
+    }
+
+    elementCount = size;
+    this->maxError = maxError;
+    minKey = toKey(sortedBlock[0]);
+    maxKey = toKey(sortedBlock[size - 1]);
+
+    double error = static_cast<double>(maxError);
+    std::uint64_t previousKey = minKey;
+    std::uint32_t previousPosition = 0;
+    double upperX = 0, upperY = 0, lowerX = 0, lowerY = 0;
+    addSplinePoint(minKey, 0);
+
+    for (int i = 1; i < size; ++i) {
+        std::uint64_t key = toKey(sortedBlock[i]);
+        if (key == previousKey) {
+            continue;
+        }
+
+        double position = static_cast<double>(i);
+        double upperPosition = position + error;
+        double lowerPosition = std::max(0.0, position - error);
+        const SplinePoint& last = points.back();
+        double keyOffset = static_cast<double>(key - last.key);
+        double positionOffset = position - last.position;
+
+        // The corridor is empty after the first point; the second key only opens it.
+        bool opening = previousKey == last.key;
+        bool outside = !opening
+            && (upperY * keyOffset - positionOffset * upperX <= 0 || lowerY * keyOffset - positionOffset * lowerX >= 0);
+
+        if (outside) {
+            addSplinePoint(previousKey, previousPosition);
+            const SplinePoint& base = points.back();
+            upperX = lowerX = static_cast<double>(key - base.key);
+            upperY = upperPosition - base.position;
+            lowerY = lowerPosition - base.position;
+        }
+        else if (opening) {
+            upperX = lowerX = keyOffset;
+            upperY = upperPosition - last.position;
+            lowerY = lowerPosition - last.position;
+        }
+        else {
+            if (upperY * keyOffset - (upperPosition - last.position) * upperX > 0) {
+                upperX = keyOffset;
+                upperY = upperPosition - last.position;
+            }
+            if (lowerY * keyOffset - (lowerPosition - last.position) * lowerX < 0) {
+                lowerX = keyOffset;
+                lowerY = lowerPosition - last.position;
+            }
+        }
+
+        previousKey = key;
+        previousPosition = static_cast<std::uint32_t>(i);
+    }
+
+    if (points.back().key != previousKey) {
+        addSplinePoint(previousKey, previousPosition);
+    }
+
+    buildRadixTable(radixBits);
+    return true;
+}
+
+/**
+ * @brief Returns the number of elements in the indexed block.
+ *
+ * @return The size of the indexed block.
+ */
+template <typename T>
+inline int RadixSplineIndex<T>::size() const {
+    return elementCount;
+}
+
+/**
+ * @brief Computes the window of the block that holds the lower bound of a key.
+ *
+ * @details For keys present in the block, the first occurrence is guaranteed to lie in [begin, end). Keys
+ * below the smallest element give the empty window at 0 and keys above the largest the empty window at size().
+ *
+ * @param key The value to search for.
+ * @param begin Reference receiving the first index of the window.
+ * @param end Reference receiving the index one past the window.
+ * @return True if the index is built, false otherwise.
+ */
+template <typename T>
+inline bool RadixSplineIndex<T>::searchBound(const T& key, int& begin, int& end) const {
+    if (elementCount == 0) {
+        begin = end = 0;
+        return false;
+    }
+
+    std::uint64_t unsignedKey = toKey(key);
+    if (unsignedKey <= minKey) {
+        begin = 0;
+        end = unsignedKey == minKey ? 1 : 0;
+        return true;
+    }
+    if (unsignedKey > maxKey) {
+        begin = end = elementCount;
+        return true;
+    }
+
+    double estimate = estimatePosition(unsignedKey);
+    begin = static_cast<int>(std::max(0.0, estimate - maxError));
+    end = static_cast<int>(std::min(static_cast<double>(elementCount), estimate + maxError + 2));
+    begin = std::min(begin, end);
+    return true;
+}
+
+/**
+ * @brief Finds the first element of the indexed block not less than a key.
+ *
+ * @details The lower bound is searched in the window from searchBound. If the block was changed since the
+ * index was built and the answer lies outside the window, the search falls back to the rest of the block, so
+ * the result is always correct. If the index is empty or the block is nullptr, the function prints an error
+ * message and returns -1.
+ *
+ * @param sortedBlock A pointer to the block the index was built over.
+ * @param key The value to search for.
+ * @return The index of the first element not less than key, or size() if there is none.
+ */
+template <typename T>
+inline int RadixSplineIndex<T>::lowerBound(const T* sortedBlock, const T& key) const {
+    if (sortedBlock == nullptr || elementCount == 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex lowerBound operation." << std::endl;
+#endif
+        return -1;
+    }
+
+    int begin, end;
+    searchBound(key, begin, end);
+    int result = static_cast<int>(std::lower_bound(sortedBlock + begin, sortedBlock + end, key) - sortedBlock);
+
+    if (result == begin && begin > 0 && !(sortedBlock[begin - 1] < key)) {
+        result = static_cast<int>(std::lower_bound(sortedBlock, sortedBlock + begin, key) - sortedBlock);
+    }
+    else if (result == end && end < elementCount && sortedBlock[end] < key) {
+        result = static_cast<int>(std::lower_bound(sortedBlock + end, sortedBlock + elementCount, key) - sortedBlock);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Finds the first element of the indexed block equal to a key.
+ *
+ * @param sortedBlock A pointer to the block the index was built over.
+ * @param key The value to search for.
+ * @return The index of the first element equal to key, or -1 if there is none.
+ */
+template <typename T>
+inline int RadixSplineIndex<T>::find(const T* sortedBlock, const T& key) const {
+    int index = lowerBound(sortedBlock, key);
+    return index >= 0 && index < elementCount && !(key < sortedBlock[index]) ? index : -1;
+}
+
+/**
+ * @brief Returns the memory used by the spline points and the radix table.
+ *
+ * @return The size of the index in bytes.
+ */
+template <typename T>
+inline std::size_t RadixSplineIndex<T>::sizeInBytes() const {
+    return points.size() * sizeof(SplinePoint) + radixTable.size() * sizeof(std::uint32_t);
+}
+
+/**
+ * @brief Returns the number of bytes serialize writes.
+ *
+ * @return The size of the serialized index.
+ */
+template <typename T>
+inline int RadixSplineIndex<T>::serializedSize() const {
+    return static_cast<int>(5 + 8 * 2 + 4 * 5 + points.size() * 12 + radixTable.size() * 4);
+}
+
+/**
+ * @brief Writes the index to a byte buffer.
+ *
+ * @details The layout is the magic bytes "PXRS", a version byte, then the key range, the element count, the
+ * error bound, the radix parameters and the spline point and table counts, followed by the spline points and the
+ * radix table. All integers are stored little-endian regardless of the host. If the destination is nullptr,
+ * the function prints an error message and returns 0.
+ *
+ * @param destination A pointer to a buffer of at least serializedSize() bytes.
+ * @return The number of bytes written.
+ */
+template <typename T>
+inline int RadixSplineIndex<T>::serialize(unsigned char* destination) const {
+    if (destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex serialize operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    unsigned char* output = destination;
+    auto write = [&output](std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            *output++ = static_cast<unsigned char>(value >> (8 * i));
+        }
+    };
+
+    const char magic[] = { 'P', 'X', 'R', 'S' };
+    for (char c : magic) {
+        *output++ = static_cast<unsigned char>(c);
+    }
+    write(1, 1);
+    write(minKey, 8);
+    write(maxKey, 8);
+    write(static_cast<std::uint32_t>(elementCount), 4);
+    write(static_cast<std::uint32_t>(maxError), 4);
+    write(static_cast<std::uint32_t>(radixBits) | (static_cast<std::uint32_t>(shift) << 8), 4);
+    write(points.size(), 4);
+    write(radixTable.size(), 4);
+    for (const SplinePoint& point : points) {
+        write(point.key, 8);
+        write(point.position, 4);
+    }
+    for (std::uint32_t entry : radixTable) {
+        write(entry, 4);
+    }
+
+    return static_cast<int>(output - destination);
+}
+
+/**
+ * @brief Replaces the index with one read from a byte buffer written by serialize.
+ *
+ * @details The spline points and the radix table are checked against each other before the index is used, so
+ * a corrupt buffer cannot send a lookup outside the index. If the buffer is nullptr, truncated, inconsistent, or
+ * does not hold a version 1 index, the function prints an error message, leaves the index empty and returns
+ * false.
+ *
+ * @param source A pointer to the serialized index.
+ * @param sourceSize The size of the buffer in bytes.
+ * @return True if the index was read, false otherwise.
+ */
+template <typename T>
+inline bool RadixSplineIndex<T>::deserialize(const unsigned char* source, int sourceSize) {
+    points.clear();
+    radixTable.clear();
+    elementCount = 0;
+
+    const int headerSize = 5 + 8 * 2 + 4 * 5;
+    if (source == nullptr || sourceSize < headerSize || std::memcmp(source, "PXRS", 4) != 0 || source[4] != 1) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex deserialize operation." << std::endl;
+#endif
+        return false;
+    }
+
+    const unsigned char* input = source + 5;
+    auto read = [&input](int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<std::uint64_t>(*input++) << (8 * i);
+        }
+        return value;
+    };
+
+    std::uint64_t storedMinKey = read(8);
+    std::uint64_t storedMaxKey = read(8);
+    std::uint32_t storedCount = static_cast<std::uint32_t>(read(4));
+    std::uint32_t storedError = static_cast<std::uint32_t>(read(4));
+    std::uint32_t radixParameters = static_cast<std::uint32_t>(read(4));
+    std::uint64_t pointCount = read(4);
+    std::uint64_t tableSize = read(4);
+
+    if (static_cast<std::uint64_t>(sourceSize) != headerSize + pointCount * 12 + tableSize * 4 || pointCount == 0
+        || (radixParameters & 0xFF) > 24 || tableSize != (std::uint64_t(1) << (radixParameters & 0xFF)) + 1) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex deserialize operation." << std::endl;
+#endif
+        return false;
+    }
+
+    points.resize(static_cast<std::size_t>(pointCount));
+    for (SplinePoint& point : points) {
+        point.key = read(8);
+        point.position = static_cast<std::uint32_t>(read(4));
+    }
+    radixTable.resize(static_cast<std::size_t>(tableSize));
+    for (std::uint32_t& entry : radixTable) {
+        entry = static_cast<std::uint32_t>(read(4));
+    }
+
+    // The spline must run from minKey to maxKey with strictly increasing keys and positions inside the
+    // block, and the shift and radix table must be the ones buildRadixTable derives from it; estimatePosition
+    // relies on all of this to stay inside points.
+    std::uint64_t range = storedMaxKey - storedMinKey;
+    int rangeBits = 0;
+    while (rangeBits < 64 && (range >> rangeBits) != 0) {
+        ++rangeBits;
+    }
+    int storedBits = static_cast<int>(radixParameters & 0xFF);
+    bool valid = storedMinKey <= storedMaxKey && storedCount > 0 && storedCount <= static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+        && storedError <= static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+        && rangeBits - storedBits < 64 && (radixParameters >> 8) == static_cast<std::uint32_t>(std::max(0, rangeBits - storedBits))
+        && points.front().key == storedMinKey && points.back().key == storedMaxKey;
+    for (std::size_t i = 0; valid && i < points.size(); ++i) {
+        valid = points[i].position < storedCount && (i == 0 || points[i - 1].key < points[i].key);
+    }
+
+    std::size_t next = 0;
+    int storedShift = static_cast<int>(radixParameters >> 8);
+    for (std::size_t i = 0; valid && i < points.size(); ++i) {
+        std::size_t prefix = static_cast<std::size_t>((points[i].key - storedMinKey) >> storedShift);
+        for (; valid && next <= prefix; ++next) {
+            valid = radixTable[next] == i;
+        }
+    }
+    for (; valid && next < radixTable.size(); ++next) {
+        valid = radixTable[next] == points.size();
+    }
+
+    if (!valid) {
+        points.clear();
+        radixTable.clear();
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid RadixSplineIndex deserialize operation." << std::endl;
+#endif
+        return false;
+    }
+
+    minKey = storedMinKey;
+    maxKey = storedMaxKey;
+    elementCount = static_cast<int>(storedCount);
+    maxError = static_cast<int>(storedError);
+    radixBits = static_cast<int>(radixParameters & 0xFF);
+    shift = static_cast<int>(radixParameters >> 8);
+    return true;
+}
+
+/**
+ * @brief Maps an integer to an unsigned 64-bit key that sorts in the same order.
+ *
+ * @param value The value to map.
+ * @return The value as unsigned, with the sign bit flipped for signed types.
+ */
+template <typename T>
+inline std::uint64_t RadixSplineIndex<T>::toKey(const T& value) {
+    typedef typename std::make_unsigned<T>::type UnsignedType;
+    UnsignedType unsignedValue = static_cast<UnsignedType>(value);
+    if (std::is_signed<T>::value) {
+        unsignedValue ^= static_cast<UnsignedType>(UnsignedType(1) << (sizeof(T) * 8 - 1));
+    }
+    return static_cast<std::uint64_t>(unsignedValue);
+}
+
+/**
+ * @brief Interpolates the position of a key on the spline.
+ *
+ * @details The radix table entry for the key's top bits bounds the spline points to search; the first spline
+ * point not less than the key and its predecessor then give the segment to interpolate on.
+ *
+ * @param key A mapped key with minKey < key <= maxKey.
+ * @return The estimated position of the key.
+ */
+template <typename T>
+inline double RadixSplineIndex<T>::estimatePosition(std::uint64_t key) const {
+    std::size_t prefix = std::min(static_cast<std::size_t>((key - minKey) >> shift), radixTable.size() - 2);
+    std::size_t first = radixTable[prefix];
+    std::size_t last = std::min<std::size_t>(radixTable[prefix + 1] + 1, points.size());
+
+    const SplinePoint* segmentEnd = std::lower_bound(points.data() + first, points.data() + last, key,
+        [](const SplinePoint& point, std::uint64_t searchKey) { return point.key < searchKey; });
+    if (segmentEnd->key == key) {
+        return segmentEnd->position;
+    }
+
+    const SplinePoint* segmentBegin = segmentEnd - 1;
+    double fraction = static_cast<double>(key - segmentBegin->key) / static_cast<double>(segmentEnd->key - segmentBegin->key);
+    return segmentBegin->position + fraction * (static_cast<double>(segmentEnd->position) - segmentBegin->position);
+}
+
+/**
+ * @brief Appends a point to the spline.
+ *
+ * @param key The mapped key of the point.
+ * @param position The position of the key's first occurrence.
+ */
+template <typename T>
+inline void RadixSplineIndex<T>::addSplinePoint(std::uint64_t key, std::uint32_t position) {
+    SplinePoint point;
+    point.key = key;
+    point.position = position;
+    points.push_back(point);
+}
+
+/**
+ * @brief Builds the radix table over the spline points.
+ *
+ * @details Entry p holds the first spline point whose top radixBits bits of (key - minKey) are at least p, so
+ * the points sharing prefix p are [table[p], table[p + 1]). Without an explicit size, the table gets about
+ * two entries per spline point, capped at 2^20 entries.
+ *
+ * @param requestedBits The number of bits requested by build, or 0 to size the table from the spline.
+ */
+template <typename T>
+inline void RadixSplineIndex<T>::buildRadixTable(int requestedBits) {
+    int bits = requestedBits;
+    if (bits == 0) {
+        while (bits < 20 && (std::size_t(1) << bits) < points.size() * 2) {
+            ++bits;
+        }
+    }
+
+    std::uint64_t range = maxKey - minKey;
+    int rangeBits = 0;
+    while (rangeBits < 64 && (range >> rangeBits) != 0) {
+        ++rangeBits;
+    }
+    radixBits = bits;
+    shift = std::max(0, rangeBits - bits);
+
+    std::size_t tableSize = (std::size_t(1) << bits) + 1;
+    radixTable.assign(tableSize, static_cast<std::uint32_t>(points.size()));
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        std::size_t prefix = static_cast<std::size_t>((points[i].key - minKey) >> shift);
+        while (next <= prefix) {
+            radixTable[next++] = static_cast<std::uint32_t>(i);
+        }
+    }
+}
+
+/**
+ * @brief Finds a value in a memory block, asking a Bloom filter first.
+ *
+ * @details If the filter reports that the value was never inserted, the function returns nullptr without
+ * scanning the block; otherwise it behaves like findValue. The filter must cover every value written to the
+ * block, for example by building it over the block and updating the block through the filtered writeValue
+ * and replaceValue overloads. An unsized filter rules nothing out, so the block is always scanned.
+ *
+ * @param address A pointer to the memory block.
+ * @param value The value to search for.
+ * @param size The size of the memory block.
+ * @param filter A Bloom filter holding every value of the block.
+ * @return A pointer to the first occurrence of the value, or nullptr if it is not found.
+ */
+template <typename T>
+inline const T* MemoryManager<T>::findValue(const T* address, int value, int size, const BloomFilter<T>& filter) {
+    if (address != nullptr && size > 0 && !filter.mayContain(static_cast<T>(value))) {
+        return nullptr;
+    }
+
+    return findValue(address, value, size);
+}
+
+/**
+ * @brief Writes a value to memory and records it in a Bloom filter.
+ *
+ * @param address A pointer to the memory location to write to.
+ * @param value The value to write.
+ * @param size The size of the memory block.
+ * @param filter The Bloom filter covering the block.
+ * @return True if the write operation is successful, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::writeValue(T* address, int value, int size, BloomFilter<T>& filter) {
+    if (!writeValue(address, value, size)) {
+        return false;
+    }
+
+    filter.insert(static_cast<T>(value));
+    return true;
+}
+
+/**
+ * @brief Replaces occurrences of a value in a memory block and records the new value in a Bloom filter.
+ *
+ * @details The new value is inserted into the filter only if at least one element was replaced. The old
+ * value stays in the filter, since Bloom filters cannot remove values; this only costs extra scans.
+ *
+ * @param address A pointer to the start of the memory block.
+ * @param size The size of the memory block.
+ * @param oldValue The value to be replaced.
+ * @param newValue The new value to replace the old value.
+ * @param filter The Bloom filter covering the block.
+ */
+template <typename T>
+inline void MemoryManager<T>::replaceValue(T* address, int size, int oldValue, int newValue, BloomFilter<T>& filter) {
+    if (address == nullptr || size <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid replaceValue operation." << std::endl;
+#endif
+        return;
+    }
+
+    T* first = std::find(address, address + size, oldValue);
+    if (first != address + size) {
+        std::replace(first, address + size, static_cast<T>(oldValue), static_cast<T>(newValue));
+        filter.insert(static_cast<T>(newValue));
+    }
+}
+
+/**
+ * @brief Constructs an unsized BloomFilter, which has no bits and reports every value as maybe present.
+ *
+ * @details A BloomFilter answers "definitely not present" or "maybe present" for values, using a fixed
+ * amount of memory. This filter is blocked: a value only touches one 512-bit block, one cache line, and sets
+ * getHashCount() bits in it. The bit positions come from multiplying one 32-bit hash by fixed odd salts, so
+ * an insert or query costs one cache miss and a short loop without further hashing or branches. An unsized
+ * filter cannot record inserts, so it never rules a value out; call reset to size it.
+ */
+template <typename T>
+inline BloomFilter<T>::BloomFilter() : blockCount(0), hashCount(0) {
+}
+
+/**
+ * @brief Constructs an empty BloomFilter sized for a number of values.
+ *
+ * @param expectedCount The number of values the filter is sized for.
+ * @param falsePositiveRate The target probability of reporting an absent value as present.
+ */
+template <typename T>
+inline BloomFilter<T>::BloomFilter(int expectedCount, double falsePositiveRate) : blockCount(0), hashCount(0) {
+    reset(expectedCount, falsePositiveRate);
+}
+
+/**
+ * @brief Constructs a BloomFilter holding every value of a memory block.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @param falsePositiveRate The target probability of reporting an absent value as present.
+ */
+template <typename T>
+inline BloomFilter<T>::BloomFilter(const T* address, int size, double falsePositiveRate) : blockCount(0), hashCount(0) {
+    if (reset(std::max(size, 1), falsePositiveRate)) {
+        insert(address, size);
+    }
+}
+
+/**
+ * @brief Empties the filter and resizes it for a number of values and a false positive rate.
+ *
+ * @details The classic sizing of -ln(p) / ln(2)^2 bits per value is raised by a fifth to make up for values
+ * crowding into the same block, and the number of bits set per value is the matching ln(2) * bits per value,
+ * capped at 16. If the inputs are invalid, the function prints an error message, leaves the filter unsized
+ * and returns false.
+ *
+ * @param expectedCount The number of values the filter is sized for.
+ * @param falsePositiveRate The target probability, between 0 and 1 exclusive.
+ * @return True if the filter was resized, false otherwise.
+ */
+template <typename T>
+inline bool BloomFilter<T>::reset(int expectedCount, double falsePositiveRate) {
+    words.clear();
+    blockCount = 0;
+    hashCount = 0;
+    if (expectedCount <= 0 || !(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid BloomFilter reset operation." << std::endl;
+#endif
+        return false;
+    }
+
+    const double ln2 = 0.6931471805599453;
+    double bitsPerValue = 1.2 * -std::log(falsePositiveRate) / (ln2 * ln2);
+    hashCount = static_cast<int>(std::min(16.0, std::max(1.0, std::round(bitsPerValue * ln2 / 1.2))));
+    blockCount = static_cast<std::size_t>(std::ceil(bitsPerValue * expectedCount / 512.0));
+    blockCount = std::max<std::size_t>(blockCount, 1);
+    words.assign(blockCount * 16, 0);
+    return true;
+}
+
+/**
+ * @brief Adds a value to the filter.
+ *
+ * @param value The value to add.
+ */
+template <typename T>
+inline void BloomFilter<T>::insert(const T& value) {
+    if (blockCount == 0) {
+        return;
+    }
+
+    std::uint64_t hashed = hash(value);
+    std::uint32_t* block = words.data() + ((hashed >> 32) * blockCount >> 32) * 16;
+    std::uint32_t key = static_cast<std::uint32_t>(hashed);
+    const std::uint32_t* salt = salts();
+    for (int i = 0; i < hashCount; ++i) {
+        std::uint32_t position = (key * salt[i]) >> 23;
+        block[position / 32] |= std::uint32_t(1) << (position % 32);
+    }
+}
+
+/**
+ * @brief Adds every value of a memory block to the filter.
+ *
+ * @details If the block is nullptr or the size is invalid, the function prints an error message and returns false.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @return True if the values were added, false otherwise.
+ */
+template <typename T>
+inline bool BloomFilter<T>::insert(const T* address, int size) {
+    if (address == nullptr || size < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid BloomFilter insert operation." << std::endl;
+#endif
+        return false;
+    }
+
+    for (int i = 0; i < size; ++i) {
+        insert(address[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a value may have been added to the filter.
+ *
+ * @details An unsized filter drops its inserts, so it answers true for every value rather than report a
+ * value it was given as absent.
+ *
+ * @param value The value to look up.
+ * @return False if the value was definitely never added, true if it may have been.
+ */
+template <typename T>
+inline bool BloomFilter<T>::mayContain(const T& value) const {
+    if (blockCount == 0) {
+        return true;
+    }
+
+    std::uint64_t hashed = hash(value);
+    const std::uint32_t* block = words.data() + ((hashed >> 32) * blockCount >> 32) * 16;
+    std::uint32_t key = static_cast<std::uint32_t>(hashed);
+    const std::uint32_t* salt = salts();
+    std::uint32_t missing = 0;
+    for (int i = 0; i < hashCount; ++i) {
+        std::uint32_t position = (key * salt[i]) >> 23;
+        missing |= (std::uint32_t(1) << (position % 32)) & ~block[position / 32];
+    }
+    return missing == 0;
+}
+
+/**
+ * @brief Removes every value from the filter, keeping its size.
+ */
+template <typename T>
+inline void BloomFilter<T>::clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
+
+/**
+ * @brief Returns the number of bits set per value.
+ *
+ * @return The number of hash functions of the filter.
+ */
+template <typename T>
+inline int BloomFilter<T>::getHashCount() const {
+    return hashCount;
+}
+
+/**
+ * @brief Returns the memory used by the filter's blocks.
+ *
+ * @return The size of the filter in bytes.
+ */
+template <typename T>
+inline std::size_t BloomFilter<T>::sizeInBytes() const {
+    return words.size() * sizeof(std::uint32_t);
+}
+
+/**
+ * @brief Hashes a value to 64 well-mixed bits.
+ *
+ * @details std::hash is the identity for integers on common standard libraries, so its result goes through
+ * the MurmurHash3 finalizer. The high half picks the block and the low half the bits within it.
+ *
+ * @param value The value to hash.
+ * @return The hash of the value.
+ */
+template <typename T>
+inline std::uint64_t BloomFilter<T>::hash(const T& value) {
+    std::uint64_t hashed = static_cast<std::uint64_t>(std::hash<T>()(value));
+    hashed ^= hashed >> 33;
+    hashed *= 0xFF51AFD7ED558CCDULL;
+    hashed ^= hashed >> 33;
+    hashed *= 0xC4CEB9FE1A85EC53ULL;
+    hashed ^= hashed >> 33;
+    return hashed;
+}
+
+/**
+ * @brief Returns the odd multipliers that pick the bits of a value within its block.
+ *
+ * @return A pointer to 16 salts.
+ */
+template <typename T>
+inline const std::uint32_t* BloomFilter<T>::salts() {
+    static const std::uint32_t values[16] = {
+        0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du, 0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u,
+        0x9E3779B1u, 0x85EBCA77u, 0xC2B2AE3Du, 0x27D4EB2Fu, 0x165667B1u, 0xD3A2646Du, 0xFD7046C5u, 0xB55A4F09u
+    };
+    return values;
+}
+
+/**
+ * @brief Computes the union of two unsorted memory blocks.
+ *
+ * @details The result holds every distinct value of block1 followed by every distinct value of block2 not in
+ * block1, each in order of first occurrence. Values are tracked in a FlatHashSet, so the function runs in
+ * expected O(size1 + size2) time. The block is allocated once with room for size1 + size2 elements. If the
+ * inputs are invalid, it prints an error message, sets unionSize to 0, and returns a null pointer. It does the
+ * same, without the message, if the result or the hash table cannot be allocated.
+ *
+ * @param block1 A pointer to the first memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second memory block.
+ * @param size2 The size of the second memory block.
+ * @param unionSize Reference to store the size of the resulting union.
+ * @return A pointer to the memory block containing the union, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::unionUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& unionSize) {
+    unionSize = 0;
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid unionUnsortedMemory operation." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    T* result = allocateMemory(size1 + size2);
+    if (result == nullptr) {
+        return nullptr;
+    }
+
+    FlatHashSet<T> seen(*this, size1 + size2);
+    for (int i = 0; i < size1 + size2; ++i) {
+        const T& value = i < size1 ? block1[i] : block2[i - size1];
+        typename FlatHashSet<T>::InsertResult inserted = seen.insert(value);
+        if (inserted == FlatHashSet<T>::InsertFailed) {
+            deallocateMemory(result);
+            unionSize = 0;
+            return nullptr;
+        }
+        if (inserted == FlatHashSet<T>::Inserted) {
+            result[unionSize++] = value;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Computes the intersection of two unsorted memory blocks.
+ *
+ * @details The result holds every distinct value of block1 that also occurs in block2, in order of first
+ * occurrence in block1. Block2 is loaded into a FlatHashSet, and values are erased from it once emitted so
+ * each is reported once. The block is allocated once with room for size1 elements. If the inputs are invalid,
+ * it prints an error message, sets intersectionSize to 0, and returns a null pointer. It does the same, without
+ * the message, if the result or the hash table cannot be allocated.
+ *
+ * @param block1 A pointer to the first memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second memory block.
+ * @param size2 The size of the second memory block.
+ * @param intersectionSize Reference to store the size of the resulting intersection.
+ * @return A pointer to the memory block containing the intersection, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::intersectUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& intersectionSize) {
+    intersectionSize = 0;
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid intersectUnsortedMemory operation." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    T* result = allocateMemory(size1);
+    if (result == nullptr) {
+        return nullptr;
+    }
+
+    FlatHashSet<T> remaining(*this, size2);
+    if (remaining.insert(block2, size2) < 0) {
+        deallocateMemory(result);
+        return nullptr;
+    }
+    for (int i = 0; i < size1; ++i) {
+        if (remaining.erase(block1[i])) {
+            result[intersectionSize++] = block1[i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Computes the difference of two unsorted memory blocks.
+ *
+ * @details The result holds every distinct value of block1 that does not occur in block2, in order of first
+ * occurrence in block1. Block2 is loaded into a FlatHashSet, and emitted values are added to it so each is
+ * reported once. The block is allocated once with room for size1 elements. If the inputs are invalid, it prints
+ * an error message, sets differenceSize to 0, and returns a null pointer. It does the same, without the message,
+ * if the result or the hash table cannot be allocated.
+ *
+ * @param block1 A pointer to the first memory block.
+ * @param size1 The size of the first memory block.
+ * @param block2 A pointer to the second memory block.
+ * @param size2 The size of the second memory block.
+ * @param differenceSize Reference to store the size of the resulting difference.
+ * @return A pointer to the memory block containing the difference, or nullptr if the operation is invalid.
+ */
+template <typename T>
+inline T* MemoryManager<T>::differenceUnsortedMemory(const T* block1, int size1, const T* block2, int size2, int& differenceSize) {
+    differenceSize = 0;
+    if (block1 == nullptr || block2 == nullptr || size1 <= 0 || size2 <= 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid differenceUnsortedMemory operation." << std::endl;
+#endif
+        return nullptr;
+    }
+
+    T* result = allocateMemory(size1);
+    if (result == nullptr) {
+        return nullptr;
+    }
+
+    FlatHashSet<T> excluded(*this, size1 + size2);
+    if (excluded.insert(block2, size2) < 0) {
+        deallocateMemory(result);
+        return nullptr;
+    }
+    for (int i = 0; i < size1; ++i) {
+        typename FlatHashSet<T>::InsertResult inserted = excluded.insert(block1[i]);
+        if (inserted == FlatHashSet<T>::InsertFailed) {
+            deallocateMemory(result);
+            differenceSize = 0;
+            return nullptr;
+        }
+        if (inserted == FlatHashSet<T>::Inserted) {
+            result[differenceSize++] = block1[i];
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+const std::size_t FlatHashSet<T>::GroupWidth;
+
+template <typename T>
+const std::int8_t FlatHashSet<T>::EmptyControl;
+
+template <typename T>
+const std::int8_t FlatHashSet<T>::DeletedControl;
+
+/**
+ * @brief Constructs an empty FlatHashSet whose slots are allocated by a MemoryManager.
+ *
+ * @details FlatHashSet is an open-addressing hash set in the style of SwissTable. Next to the slots it keeps one
+ * control byte per slot: empty, deleted, or the low 7 bits of the hash of the value stored there. A lookup loads
+ * 16 control bytes at once and compares them with the value's 7 hash bits in one SSE2 instruction, so only
+ * slots whose bits match are ever compared, and a group with an empty byte ends the probe. Groups are probed
+ * triangularly, and the table grows once it is 7/8 full. The manager must outlive the set.
+ *
+ * @param manager The MemoryManager that allocates and frees the slot storage.
+ * @param expectedCount The number of values to reserve room for.
+ */
+template <typename T>
+inline FlatHashSet<T>::FlatHashSet(MemoryManager<T>& manager, int expectedCount)
+    : manager(&manager), slots(nullptr), slotCount(0), elementCount(0), deletedCount(0) {
+    reserve(std::max(expectedCount, 1));
+}
+
+/**
+ * @brief Destroys the FlatHashSet, returning its slots to the MemoryManager.
+ */
+template <typename T>
+inline FlatHashSet<T>::~FlatHashSet() {
+    if (slots != nullptr) {
+        manager->deallocateMemory(slots);
+    }
+}
+
+/**
+ * @brief Adds a value to the set.
+ *
+ * @details If the table cannot grow because the allocation fails, the value is not added and the function
+ * returns InsertFailed, which callers must not mistake for a duplicate.
+ *
+ * @param value The value to add.
+ * @return Inserted if the value was added, AlreadyPresent if it was in the set, or InsertFailed if it could not
+ * be stored.
+ */
+template <typename T>
+inline typename FlatHashSet<T>::InsertResult FlatHashSet<T>::insert(const T& value) {
+    std::uint64_t hash = MemoryManager<T>::hashValue(value);
+    if (findSlot(value, hash) != slotCount) {
+        return AlreadyPresent;
+    }
+
+    if ((elementCount + deletedCount + 1) * 8 > slotCount * 7) {
+        std::size_t newSlotCount = (elementCount + 1) * 16 > slotCount * 7 ? slotCount * 2 : slotCount;
+        if (!rehash(std::max(newSlotCount, GroupWidth))) {
+            return InsertFailed;
+        }
+    }
+
+    std::size_t slot = findInsertSlot(hash);
+    if (control[slot] == DeletedControl) {
+        --deletedCount;
+    }
+    slots[slot] = value;
+    setControl(slot, static_cast<std::int8_t>(hash & 0x7F));
+    ++elementCount;
+    return Inserted;
+}
+
+/**
+ * @brief Adds every value of a memory block to the set.
+ *
+ * @details The table is grown once up front for the whole block. If the block is nullptr or the size is
+ * invalid, the function prints an error message and returns 0. If the table cannot grow, the function stops
+ * and returns -1; the values added before that stay in the set.
+ *
+ * @param address A pointer to the memory block.
+ * @param size The size of the memory block.
+ * @return The number of values that were not already present, or -1 if the allocation failed.
+ */
+template <typename T>
+inline int FlatHashSet<T>::insert(const T* address, int size) {
+    if (address == nullptr || size < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FlatHashSet insert operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    reserve(static_cast<int>(std::min<std::size_t>(elementCount + static_cast<std::size_t>(size), std::numeric_limits<int>::max())));
+    int added = 0;
+    for (int i = 0; i < size; ++i) {
+        InsertResult result = insert(address[i]);
+        if (result == InsertFailed) {
+            return -1;
+        }
+        added += result == Inserted ? 1 : 0;
+    }
+    return added;
+}
+
+/**
+ * @brief Checks if a value is in the set.
+ *
+ * @param value The value to look up.
+ * @return True if the set contains the value, false otherwise.
+ */
+template <typename T>
+inline bool FlatHashSet<T>::contains(const T& value) const {
+    return findSlot(value, MemoryManager<T>::hashValue(value)) != slotCount;
+}
+
+/**
+ * @brief Removes a value from the set.
+ *
+ * @details The slot is marked deleted rather than empty, so probes for other values keep walking past it.
+ * Deleted slots are reused by later inserts and dropped when the table is rehashed.
+ *
+ * @param value The value to remove.
+ * @return True if the value was removed, false if it was not present.
+ */
+template <typename T>
+inline bool FlatHashSet<T>::erase(const T& value) {
+    std::size_t slot = findSlot(value, MemoryManager<T>::hashValue(value));
+    if (slot == slotCount) {
+        return false;
+    }
+
+    setControl(slot, DeletedControl);
+    --elementCount;
+    ++deletedCount;
+    return true;
+}
+
+/**
+ * @brief Removes every value from the set, keeping its capacity.
+ */
+template <typename T>
+inline void FlatHashSet<T>::clear() {
+    std::fill(control.begin(), control.end(), EmptyControl);
+    elementCount = 0;
+    deletedCount = 0;
+}
+
+/**
+ * @brief Grows the table so that it holds a number of values without rehashing.
+ *
+ * @param count The number of values to make room for.
+ * @return True if the table has room for count values, false if the allocation failed.
+ */
+template <typename T>
+inline bool FlatHashSet<T>::reserve(int count) {
+    std::size_t needed = GroupWidth;
+    while (needed * 7 < static_cast<std::size_t>(std::max(count, 0)) * 8) {
+        needed *= 2;
+    }
+    return needed <= slotCount || rehash(needed);
+}
+
+/**
+ * @brief Returns the number of values in the set.
+ *
+ * @return The size of the set.
+ */
+template <typename T>
+inline int FlatHashSet<T>::size() const {
+    return static_cast<int>(elementCount);
+}
+
+/**
+ * @brief Returns the number of slots in the table.
+ *
+ * @return The capacity of the table.
+ */
+template <typename T>
+inline int FlatHashSet<T>::capacity() const {
+    return static_cast<int>(slotCount);
+}
+
+/**
+ * @brief Finds the control bytes of a group equal to a byte.
+ *
+ * @param group A pointer to 16 control bytes.
+ * @param byte The byte to look for.
+ * @return A mask with bit i set if group[i] equals byte.
+ */
+template <typename T>
+inline std::uint32_t FlatHashSet<T>::matchByte(const std::int8_t* group, std::int8_t byte) {
+#ifdef PTRX_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < GroupWidth; ++i) {
+        mask |= static_cast<std::uint32_t>(group[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Finds the empty or deleted control bytes of a group.
+ *
+ * @details Both markers are negative while full slots hold 7-bit hashes, so the mask is just the sign bits.
+ *
+ * @param group A pointer to 16 control bytes.
+ * @return A mask with bit i set if slot i of the group holds no value.
+ */
+template <typename T>
+inline std::uint32_t FlatHashSet<T>::matchNonFull(const std::int8_t* group) {
+#ifdef PTRX_SSE2
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < GroupWidth; ++i) {
+        mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ *
+ * @param mask The mask, which must be non-zero.
+ * @return The index of its lowest set bit.
+ */
+template <typename T>
+inline int FlatHashSet<T>::lowestBit(std::uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Finds the slot holding a value.
+ *
+ * @param value The value to look up.
+ * @param hash The hash of the value.
+ * @return The slot index, or slotCount if the value is not in the set.
+ */
+template <typename T>
+inline std::size_t FlatHashSet<T>::findSlot(const T& value, std::uint64_t hash) const {
+    if (slotCount == 0) {
+        return slotCount;
+    }
+
+    std::size_t mask = slotCount - 1;
+    std::size_t position = static_cast<std::size_t>(hash >> 7) & mask;
+    std::int8_t tag = static_cast<std::int8_t>(hash & 0x7F);
+
+    for (std::size_t step = GroupWidth; ; step += GroupWidth) {
+        const std::int8_t* group = control.data() + position;
+        for (std::uint32_t matches = matchByte(group, tag); matches != 0; matches &= matches - 1) {
+            std::size_t slot = (position + static_cast<std::size_t>(lowestBit(matches))) & mask;
+            if (slots[slot] == value) {
+                return slot;
+            }
+        }
+        if (matchByte(group, EmptyControl) != 0 || step > slotCount) {
+            return slotCount;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+/**
+ * @brief Finds the first empty or deleted slot on a hash's probe sequence.
+ *
+ * @details The table is never full, so a free slot always exists.
+ *
+ * @param hash The hash of the value to store.
+ * @return The slot index.
+ */
+template <typename T>
+inline std::size_t FlatHashSet<T>::findInsertSlot(std::uint64_t hash) const {
+    std::size_t mask = slotCount - 1;
+    std::size_t position = static_cast<std::size_t>(hash >> 7) & mask;
+
+    for (std::size_t step = GroupWidth; ; step += GroupWidth) {
+        std::uint32_t free = matchNonFull(control.data() + position);
+        if (free != 0) {
+            return (position + static_cast<std::size_t>(lowestBit(free))) & mask;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+/**
+ * @brief Writes the control byte of a slot.
+ *
+ * @details The first 15 control bytes are mirrored past the end of the array, so a group load starting near
+ * the end of the table sees the wrapped-around slots without a bounds check.
+ *
+ * @param slot The slot index.
+ * @param byte The control byte to write.
+ */
+template <typename T>
+inline void FlatHashSet<T>::setControl(std::size_t slot, std::int8_t byte) {
+    control[slot] = byte;
+    if (slot < GroupWidth - 1) {
+        control[slotCount + slot] = byte;
+    }
+}
+
+/**
+ * @brief Moves every value into a table with a new number of slots.
+ *
+ * @details Deleted slots are dropped along the way. If the MemoryManager cannot allocate the new slots, the
+ * table is left unchanged and the function returns false.
+ *
+ * @param newSlotCount The new number of slots, a power of two of at least 16.
+ * @return True if the table was rebuilt, false otherwise.
+ */
+template <typename T>
+inline bool FlatHashSet<T>::rehash(std::size_t newSlotCount) {
+    if (newSlotCount > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    T* newSlots = manager->allocateMemory(static_cast<int>(newSlotCount));
+    if (newSlots == nullptr) {
+        return false;
+    }
+
+    T* oldSlots = slots;
+    std::vector<std::int8_t> oldControl(newSlotCount + GroupWidth - 1, EmptyControl);
+    oldControl.swap(control);
+    std::size_t oldSlotCount = slotCount;
+
+    slots = newSlots;
+    slotCount = newSlotCount;
+    deletedCount = 0;
+    for (std::size_t slot = 0; slot < oldSlotCount; ++slot) {
+        if (oldControl[slot] >= 0) {
+            std::uint64_t hash = MemoryManager<T>::hashValue(oldSlots[slot]);
+            std::size_t target = findInsertSlot(hash);
+            slots[target] = oldSlots[slot];
+            setControl(target, static_cast<std::int8_t>(hash & 0x7F));
+        }
+    }
+
+    if (oldSlots != nullptr) {
+        manager->deallocateMemory(oldSlots);
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the end of the run of equal elements starting at an index, comparing 4 ints at a time.
+ *
+ * @param data A pointer to the memory block.
+ * @param begin The index where the run starts.
+ * @param size The size of the memory block.
+ * @return The index one past the last element equal to data[begin].
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::runEnd(const T* data, std::size_t begin, std::size_t size, std::true_type) {
+    std::size_t end = begin + 1;
+#ifdef PTRX_SSE2
+    __m128i value = _mm_set1_epi32(static_cast<int>(data[begin]));
+    while (end + 4 <= size) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end));
+        int equal = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, value)));
+        if (equal != 0xF) {
+            while (equal & 1) {
+                equal >>= 1;
+                ++end;
+            }
+            return end;
+        }
+        end += 4;
+    }
+#endif
+    while (end < size && data[end] == data[begin]) {
+        ++end;
+    }
+    return end;
+}
+
+/**
+ * @brief Finds the end of the run of equal elements starting at an index.
+ *
+ * @param data A pointer to the memory block.
+ * @param begin The index where the run starts.
+ * @param size The size of the memory block.
+ * @return The index one past the last element equal to data[begin].
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::runEnd(const T* data, std::size_t begin, std::size_t size, std::false_type) {
+    std::size_t end = begin + 1;
+    while (end < size && data[end] == data[begin]) {
+        ++end;
+    }
+    return end;
+}
+
+/**
+ * @brief Compresses a memory block into a self-describing frame: the compression header and its payload.
+ *
+ * @details This is the format written by compressMemory, before it is packed into a block of T, and each
+ * frame of a FrameCompressor stream.
+ *
+ * @param source A pointer to the memory block.
+ * @param count The number of elements, at least 1.
+ * @param format The compression format to use.
+ * @param frame Reference to a vector that receives exactly the frame's bytes.
+ * @return True if the frame was written, false if the count is out of range or the format does not support T.
+ */
+template <typename T>
+inline bool MemoryManager<T>::encodeFrame(const T* source, std::size_t count, CompressionFormat format, std::vector<unsigned char>& frame) {
+    std::uint64_t byteCount = static_cast<std::uint64_t>(count) * sizeof(T);
+    if (count == 0 || byteCount > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    int size = static_cast<int>(count);
+    std::size_t capacity = 0;
+    switch (format) {
+    case CompressionFormat::RunLength:
+        capacity = count * (sizeof(T) + 5);
+        break;
+    case CompressionFormat::DeltaBitPacked:
+        capacity = static_cast<std::size_t>(DeltaCodec::maxEncodedSize(size, sizeof(T)));
+        break;
+    case CompressionFormat::Lz:
+        capacity = static_cast<std::size_t>(LzCodec::maxEncodedSize(static_cast<int>(byteCount)));
+        break;
+    }
+
+    std::vector<unsigned char> bytes(CompressionHeaderSize + capacity);
+    unsigned char* payload = bytes.data() + CompressionHeaderSize;
+    typedef std::integral_constant<bool, std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)> IsDeltaCodable;
+    std::size_t payloadBytes = 0;
+    switch (format) {
+    case CompressionFormat::RunLength:
+        payloadBytes = encodeRunLength(source, count, payload);
+        break;
+    case CompressionFormat::DeltaBitPacked:
+        payloadBytes = static_cast<std::size_t>(capacity > 0 ? encodeDelta(source, size, payload, IsDeltaCodable()) : 0);
+        break;
+    case CompressionFormat::Lz:
+        payloadBytes = static_cast<std::size_t>(capacity > 0
+            ? LzCodec::encode(reinterpret_cast<const unsigned char*>(source), static_cast<int>(byteCount), payload) : 0);
+        break;
+    }
+
+    if (payloadBytes == 0) {
+        return false;
+    }
+
+    writeCompressionHeader(bytes.data(), static_cast<unsigned char>(format), static_cast<std::uint32_t>(count), static_cast<std::uint32_t>(payloadBytes));
+    frame.assign(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(CompressionHeaderSize + payloadBytes));
+    return true;
+}
+
+/**
+ * @brief Decompresses a frame written by encodeFrame.
+ *
+ * @param input A pointer to the frame.
+ * @param length The number of readable bytes, which may extend past the frame.
+ * @param output A pointer to room for count elements.
+ * @param count The number of elements the frame must hold.
+ * @return True if the frame is valid and holds exactly count elements, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decodeFrame(const unsigned char* input, std::size_t length, T* output, std::size_t count) {
+    unsigned char format = 0;
+    std::uint32_t frameCount = 0, payloadBytes = 0;
+    if (!readCompressionHeader(input, length, format, frameCount, payloadBytes) || frameCount != count) {
+        return false;
+    }
+
+    const unsigned char* payload = input + CompressionHeaderSize;
+    typedef std::integral_constant<bool, std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)> IsDeltaCodable;
+    switch (static_cast<CompressionFormat>(format)) {
+    case CompressionFormat::RunLength:
+        return decodeRunLength(payload, payloadBytes, output, count);
+    case CompressionFormat::DeltaBitPacked:
+        return count <= static_cast<std::size_t>(std::numeric_limits<int>::max())
+            && decodeDelta(payload, static_cast<int>(payloadBytes), output, static_cast<int>(count), IsDeltaCodable());
+    case CompressionFormat::Lz:
+        return static_cast<std::uint64_t>(count) * sizeof(T) <= static_cast<std::uint64_t>(std::numeric_limits<int>::max())
+            && LzCodec::decode(payload, static_cast<int>(payloadBytes), reinterpret_cast<unsigned char*>(output),
+                static_cast<int>(count * sizeof(T)));
+    }
+    return false;
+}
+
+
+/**
+ * @brief Walks a block produced by compressMemory as a sequence of segments, without decompressing it whole.
+ *
+ * @details Segments cover the original block in order:
+ * - A RunLength run is one constant segment: values points to the run's value and length is the run length.
+ * - A DeltaBitPacked block of 128 elements is one segment, unpacked only if prune does not skip it.
+ * - Lz data is decompressed into a temporary buffer, which forms a single segment. A header claiming more
+ *   elements than the payload can decode to, or a buffer that cannot be allocated, fails the walk.
+ *
+ * prune(minimum, maximum) is only consulted for segments whose bounds are known, runs and DeltaBitPacked
+ * blocks, and returns true to skip the segment. segment(position, length, values, constant) receives the
+ * position of the segment's first element and returns false to stop the walk.
+ *
+ * @param compressedData A pointer to a block produced by compressMemory.
+ * @param compressedSize The size of the compressed block.
+ * @param prune The predicate deciding whether a segment can be skipped from its bounds.
+ * @param segment The function called with every segment that is not skipped.
+ * @return True if the data is valid up to where the walk ended, false otherwise.
+ */
+template <typename T>
+template <typename Prune, typename Segment>
+inline bool MemoryManager<T>::scanCompressed(const T* compressedData, int compressedSize, Prune prune, Segment segment) {
+    if (compressedData == nullptr || compressedSize <= 0) {
+        return false;
+    }
+
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(compressedData);
+    std::size_t length = static_cast<std::size_t>(compressedSize) * sizeof(T);
+    unsigned char format = 0;
+    std::uint32_t count = 0, payloadBytes = 0;
+    if (!readCompressionHeader(input, length, format, count, payloadBytes)) {
+        return false;
+    }
+
+    const unsigned char* payload = input + CompressionHeaderSize;
+    typedef std::integral_constant<bool, std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)> IsDeltaCodable;
+    switch (static_cast<CompressionFormat>(format)) {
+    case CompressionFormat::RunLength: {
+        const unsigned char* position = payload;
+        const unsigned char* end = payload + payloadBytes;
+        std::size_t index = 0;
+        while (position < end) {
+            T value;
+            std::uint64_t runLength = 0;
+            if (static_cast<std::size_t>(end - position) < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, position, sizeof(T));
+            position += sizeof(T);
+            if (!readVarint(position, end, runLength) || runLength == 0 || runLength > count - index) {
+                return false;
+            }
+            if (!prune(value, value) && !segment(index, static_cast<std::size_t>(runLength), &value, true)) {
+                return true;
+            }
+            index += static_cast<std::size_t>(runLength);
+        }
+        return index == count;
+    }
+    case CompressionFormat::DeltaBitPacked:
+        return scanDeltaBlocks(payload, static_cast<int>(payloadBytes), count, prune, segment, IsDeltaCodable());
+    case CompressionFormat::Lz: {
+        // The count comes from the header, so it is checked against what the payload can decode to before
+        // the buffer is allocated.
+        if (static_cast<std::uint64_t>(count) * sizeof(T) > LzCodec::maxDecodedSize(static_cast<int>(payloadBytes))) {
+            return false;
+        }
+        std::unique_ptr<T[]> values(new (std::nothrow) T[count]);
+        if (values == nullptr || !decodeFrame(input, length, values.get(), count)) {
+            return false;
+        }
+        segment(0, count, values.get(), false);
+        return true;
+    }
+    }
+    return false;
+}
+
+/**
+ * @brief Walks the blocks of a DeltaCodec payload for scanCompressed.
+ *
+ * @details Blocks are skipped from the bounds stored in their headers, so only blocks that may hold a match
+ * are unpacked.
+ *
+ * @param input A pointer to the payload.
+ * @param length The length of the payload in bytes.
+ * @param count The number of elements the payload must hold.
+ * @param prune The predicate deciding whether a block can be skipped from its bounds.
+ * @param segment The function called with every block that is not skipped.
+ * @return True if the payload is valid up to where the walk ended, false otherwise.
+ */
+template <typename T>
+template <typename Prune, typename Segment>
+inline bool MemoryManager<T>::scanDeltaBlocks(const unsigned char* input, int length, std::size_t count, Prune prune, Segment segment, std::true_type) {
+    int blocks = DeltaCodec::blockCount(input, length);
+    if (blocks < 0 || static_cast<std::size_t>(DeltaCodec::encodedCount(input, length)) != count) {
+        return false;
+    }
+
+    T values[DeltaCodec::BlockSize];
+    for (int block = 0; block < blocks; ++block) {
+        T minimum, maximum;
+        if (!DeltaCodec::blockRange(input, length, block, minimum, maximum)) {
+            return false;
+        }
+        if (prune(minimum, maximum)) {
+            continue;
+        }
+
+        int valueCount = DeltaCodec::decodeBlock(input, length, block, values);
+        if (valueCount == 0) {
+            return false;
+        }
+        if (!segment(static_cast<std::size_t>(block) * DeltaCodec::BlockSize, static_cast<std::size_t>(valueCount), values, false)) {
+            return true;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rejects DeltaCodec payloads for element types it does not support.
+ *
+ * @return Always false.
+ */
+template <typename T>
+template <typename Prune, typename Segment>
+inline bool MemoryManager<T>::scanDeltaBlocks(const unsigned char*, int, std::size_t, Prune, Segment, std::false_type) {
+    return false;
+}
+
+
+/**
+ * @brief Writes the run-length payload of a memory block.
+ *
+ * @param source A pointer to the memory block.
+ * @param count The number of elements.
+ * @param output A pointer to at least count * (sizeof(T) + 5) bytes.
+ * @return The number of bytes written.
+ */
+template <typename T>
+inline std::size_t MemoryManager<T>::encodeRunLength(const T* source, std::size_t count, unsigned char* output) {
+    typedef std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4> IsInt32;
+    unsigned char* position = output;
+    for (std::size_t begin = 0; begin < count; ) {
+        std::size_t end = runEnd(source, begin, count, IsInt32());
+        std::memcpy(position, source + begin, sizeof(T));
+        position += sizeof(T);
+        writeVarint(position, end - begin);
+        begin = end;
+    }
+    return static_cast<std::size_t>(position - output);
+}
+
+/**
+ * @brief Decodes a run-length payload, writing every run with std::fill_n.
+ *
+ * @param input A pointer to the payload.
+ * @param length The length of the payload in bytes.
+ * @param output A pointer to room for count elements.
+ * @param count The number of elements the payload must decode to.
+ * @return True if the payload decodes to exactly count elements, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decodeRunLength(const unsigned char* input, std::size_t length, T* output, std::size_t count) {
+    const unsigned char* position = input;
+    const unsigned char* end = input + length;
+    std::size_t written = 0;
+    while (position < end) {
+        T value;
+        std::uint64_t runLength = 0;
+        if (static_cast<std::size_t>(end - position) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+        if (!readVarint(position, end, runLength) || runLength == 0 || runLength > count - written) {
+            return false;
+        }
+        std::fill_n(output + written, static_cast<std::size_t>(runLength), value);
+        written += static_cast<std::size_t>(runLength);
+    }
+    return written == count;
+}
+
+/**
+ * @brief Writes the DeltaCodec payload of a memory block of 32- or 64-bit integers.
+ *
+ * @param source A pointer to the memory block.
+ * @param count The number of elements.
+ * @param output A pointer to at least DeltaCodec::maxEncodedSize(count, sizeof(T)) bytes.
+ * @return The number of bytes written.
+ */
+template <typename T>
+inline int MemoryManager<T>::encodeDelta(const T* source, int count, unsigned char* output, std::true_type) {
+    return DeltaCodec::encode(source, count, output);
+}
+
+/**
+ * @brief Rejects DeltaCodec encoding for element types it does not support.
+ *
+ * @return Always 0.
+ */
+template <typename T>
+inline int MemoryManager<T>::encodeDelta(const T*, int, unsigned char*, std::false_type) {
+    return 0;
+}
+
+/**
+ * @brief Decodes a DeltaCodec payload of 32- or 64-bit integers.
+ *
+ * @param input A pointer to the payload.
+ * @param length The length of the payload in bytes.
+ * @param output A pointer to room for count elements.
+ * @param count The number of elements the payload must decode to.
+ * @return True if the payload decodes to exactly count elements, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decodeDelta(const unsigned char* input, int length, T* output, int count, std::true_type) {
+    return DeltaCodec::encodedCount(input, length) == count && DeltaCodec::decode(input, length, output);
+}
+
+/**
+ * @brief Rejects DeltaCodec decoding for element types it does not support.
+ *
+ * @return Always false.
+ */
+template <typename T>
+inline bool MemoryManager<T>::decodeDelta(const unsigned char*, int, T*, int, std::false_type) {
+    return false;
+}
+
+
+/**
+ * @brief Appends an unsigned integer as a LEB128 varint: 7 bits per byte, low bits first.
+ *
+ * @param output Reference to the write position, advanced past the varint.
+ * @param value The value to write.
+ */
+template <typename T>
+inline void MemoryManager<T>::writeVarint(unsigned char*& output, std::uint64_t value) {
+    while (value >= 0x80) {
+        *output++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *output++ = static_cast<unsigned char>(value);
+}
+
+/**
+ * @brief Reads a LEB128 varint.
+ *
+ * @param input Reference to the read position, advanced past the varint.
+ * @param end The end of the readable bytes.
+ * @param value Reference receiving the value.
+ * @return True if a complete varint of at most 64 bits was read, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::readVarint(const unsigned char*& input, const unsigned char* end, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && input < end; shift += 7) {
+        unsigned char byte = *input++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Writes the header shared by the compressed formats.
+ *
+ * @param output A pointer to CompressionHeaderSize bytes.
+ * @param format The format byte of the payload.
+ * @param count The number of elements encoded.
+ * @param payloadBytes The length of the payload following the header.
+ */
+template <typename T>
+inline void MemoryManager<T>::writeCompressionHeader(unsigned char* output, unsigned char format, std::uint32_t count, std::uint32_t payloadBytes) {
+    output[0] = 'P';
+    output[1] = 'X';
+    output[2] = 'C';
+    output[3] = 1;
+    output[4] = format;
+    output[5] = static_cast<unsigned char>(sizeof(T));
+    for (int i = 0; i < 4; ++i) {
+        output[6 + i] = static_cast<unsigned char>(count >> (8 * i));
+        output[10 + i] = static_cast<unsigned char>(payloadBytes >> (8 * i));
+    }
+}
+
+/**
+ * @brief Reads and validates the header shared by the compressed formats.
+ *
+ * @param input A pointer to the compressed bytes.
+ * @param length The number of readable bytes.
+ * @param format Reference receiving the format byte.
+ * @param count Reference receiving the number of encoded elements.
+ * @param payloadBytes Reference receiving the payload length.
+ * @return True if the header is valid for T and the payload fits in length, false otherwise.
+ */
+template <typename T>
+inline bool MemoryManager<T>::readCompressionHeader(const unsigned char* input, std::size_t length, unsigned char& format,
+    std::uint32_t& count, std::uint32_t& payloadBytes) {
+    if (length < CompressionHeaderSize || input[0] != 'P' || input[1] != 'X' || input[2] != 'C' || input[3] != 1
+        || input[5] != sizeof(T)) {
+        return false;
+    }
+
+    format = input[4];
+    count = 0;
+    payloadBytes = 0;
+    for (int i = 0; i < 4; ++i) {
+        count |= static_cast<std::uint32_t>(input[6 + i]) << (8 * i);
+        payloadBytes |= static_cast<std::uint32_t>(input[10 + i]) << (8 * i);
+    }
+    return payloadBytes <= length - CompressionHeaderSize;
+}
+
+/**
+ * @brief Copies compressed bytes into a newly allocated block of T.
+ *
+ * @details The last element is zero-padded when the byte count is not a multiple of sizeof(T).
+ *
+ * @param bytes A pointer to the compressed bytes.
+ * @param byteCount The number of compressed bytes.
+ * @param compressedSize Reference receiving the number of T elements of the block.
+ * @return A pointer to the block, or nullptr if the allocation failed.
+ */
+template <typename T>
+inline T* MemoryManager<T>::packCompressedBytes(const unsigned char* bytes, std::size_t byteCount, int& compressedSize) {
+    std::size_t elementCount = (byteCount + sizeof(T) - 1) / sizeof(T);
+    if (elementCount > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+#ifdef DEBUG_MODE
+        std::cerr << "Compressed data too large." << std::endl;
+#endif
+        compressedSize = 0;
+        return nullptr;
+    }
+
+    T* packed = allocateMemory(static_cast<int>(elementCount));
+    if (packed == nullptr) {
+        compressedSize = 0;
+        return nullptr;
+    }
+
+    unsigned char* output = reinterpret_cast<unsigned char*>(packed);
+    std::memcpy(output, bytes, byteCount);
+    std::memset(output + byteCount, 0, elementCount * sizeof(T) - byteCount);
+    compressedSize = static_cast<int>(elementCount);
+    return packed;
+}
+
+const int DeltaCodec::BlockSize;
+const int DeltaCodec::HeaderSize;
+
+/**
+ * @brief Returns the largest number of bytes encode can write.
+ *
+ * @details DeltaCodec compresses 32- and 64-bit integer buffers that are sorted or change slowly, such as IDs
+ * and timestamps. The values are cut into blocks of 128. Every block stores its first value, its minimum and
+ * maximum, then the zigzag-encoded differences between neighbours, bit-packed at the width of the largest one.
+ * The bounds let queries skip blocks that cannot hold a match without unpacking them. A table of block
+ * offsets after the header allows any block to be decoded on its own. Blocks of 32-bit values are packed in
+ * four interleaved lanes so that SSE2 can unpack, un-zigzag and prefix-sum four values per instruction.
+ *
+ * @param count The number of values to encode.
+ * @param elementSize The size of one value in bytes, 4 or 8.
+ * @return The size of the largest possible encoding, or 0 if the inputs are invalid.
+ */
+inline int DeltaCodec::maxEncodedSize(int count, int elementSize) {
+    if (count < 0 || (elementSize != 4 && elementSize != 8)) {
+        return 0;
+    }
+
+    std::uint64_t blocks = (static_cast<std::uint64_t>(count) + BlockSize - 1) / BlockSize;
+    std::uint64_t bytes = HeaderSize + blocks * (4 + 3 * elementSize + 1 + BlockSize * elementSize);
+    return bytes > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) ? 0 : static_cast<int>(bytes);
+}
+
+/**
+ * @brief Encodes a buffer of 32- or 64-bit integers.
+ *
+ * @details The header holds the magic bytes "PXD", a format version, the element size, a byte that is 1 for
+ * signed and 0 for unsigned values, which fixes the order of the block bounds, and the value count. Differences are taken modulo 2^32 or 2^64, so any sequence round-trips, and sequences with
+ * small steps in either direction pack tightly. If the inputs are invalid, the function prints an error
+ * message and returns 0.
+ *
+ * @param source A pointer to the values.
+ * @param count The number of values.
+ * @param destination A pointer to at least maxEncodedSize(count, sizeof(Integer)) bytes.
+ * @return The number of bytes written.
+ */
+template <typename Integer>
+inline int DeltaCodec::encode(const Integer* source, int count, unsigned char* destination) {
+    static_assert(std::is_integral<Integer>::value && (sizeof(Integer) == 4 || sizeof(Integer) == 8),
+        "DeltaCodec supports 32- and 64-bit integers.");
+    typedef typename std::conditional<sizeof(Integer) == 4, std::uint32_t, std::uint64_t>::type Word;
+
+    if ((source == nullptr && count > 0) || count < 0 || destination == nullptr || maxEncodedSize(count, sizeof(Integer)) == 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid DeltaCodec encode operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    int blocks = (count + BlockSize - 1) / BlockSize;
+    destination[0] = 'P';
+    destination[1] = 'X';
+    destination[2] = 'D';
+    destination[3] = 2;
+    destination[4] = static_cast<unsigned char>(sizeof(Integer));
+    destination[5] = std::is_signed<Integer>::value ? 1 : 0;
+    for (int i = 0; i < 4; ++i) {
+        destination[6 + i] = static_cast<unsigned char>(static_cast<std::uint32_t>(count) >> (8 * i));
+    }
+
+    unsigned char* offsets = destination + HeaderSize;
+    unsigned char* blockData = offsets + 4 * static_cast<std::size_t>(blocks);
+    unsigned char* output = blockData;
+    Word deltas[BlockSize];
+
+    for (int block = 0; block < blocks; ++block) {
+        std::uint32_t offset = static_cast<std::uint32_t>(output - blockData);
+        for (int i = 0; i < 4; ++i) {
+            offsets[4 * block + i] = static_cast<unsigned char>(offset >> (8 * i));
+        }
+
+        const Integer* values = source + static_cast<std::size_t>(block) * BlockSize;
+        int valueCount = std::min(BlockSize, count - block * BlockSize);
+        Integer minimum = values[0];
+        Integer maximum = values[0];
+        for (int i = 1; i < valueCount; ++i) {
+            minimum = std::min(minimum, values[i]);
+            maximum = std::max(maximum, values[i]);
+        }
+
+        Word previous = static_cast<Word>(values[0]);
+        Word combined = 0;
+        for (int i = 0; i < BlockSize; ++i) {
+            Word current = i < valueCount ? static_cast<Word>(values[i]) : previous;
+            Word delta = current - previous;
+            Word zigzag = (delta << 1) ^ (Word(0) - (delta >> (sizeof(Word) * 8 - 1)));
+            deltas[i] = zigzag;
+            combined |= zigzag;
+            previous = current;
+        }
+
+        int width = bitWidth(combined);
+        Word base = static_cast<Word>(values[0]);
+        std::memcpy(output, &base, sizeof(Word));
+        std::memcpy(output + sizeof(Word), &minimum, sizeof(Word));
+        std::memcpy(output + 2 * sizeof(Word), &maximum, sizeof(Word));
+        output[3 * sizeof(Word)] = static_cast<unsigned char>(width);
+        output += 3 * sizeof(Word) + 1;
+        packBlock(deltas, width, output);
+        output += BlockSize / 8 * width;
+    }
+
+    return static_cast<int>(output - destination);
+}
+
+/**
+ * @brief Decodes a whole buffer written by encode.
+ *
+ * @details If the buffer is not a valid encoding of values of this size, the function prints an error message
+ * and returns false.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @param destination A pointer to room for encodedCount(source, length) values.
+ * @return True if the buffer was decoded, false otherwise.
+ */
+template <typename Integer>
+inline bool DeltaCodec::decode(const unsigned char* source, int length, Integer* destination) {
+    static_assert(std::is_integral<Integer>::value && (sizeof(Integer) == 4 || sizeof(Integer) == 8),
+        "DeltaCodec supports 32- and 64-bit integers.");
+    typedef typename std::conditional<sizeof(Integer) == 4, std::uint32_t, std::uint64_t>::type Word;
+
+    int count = 0;
+    if (!readHeader(source, length, sizeof(Integer), count) || (destination == nullptr && count > 0)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid DeltaCodec decode operation." << std::endl;
+#endif
+        return false;
+    }
+
+    int blocks = (count + BlockSize - 1) / BlockSize;
+    for (int block = 0; block < blocks; ++block) {
+        const unsigned char* input = blockAt(source, length, sizeof(Integer), block);
+        if (input == nullptr) {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid DeltaCodec decode operation: Corrupt block." << std::endl;
+#endif
+            return false;
+        }
+
+        Word base;
+        std::memcpy(&base, input, sizeof(Word));
+        int width = input[3 * sizeof(Word)];
+        int valueCount = std::min(BlockSize, count - block * BlockSize);
+        Integer* output = destination + static_cast<std::size_t>(block) * BlockSize;
+
+        if (valueCount == BlockSize) {
+            unpackBlock(input + 3 * sizeof(Word) + 1, width, base, reinterpret_cast<Word*>(output));
+        }
+        else {
+            Word values[BlockSize];
+            unpackBlock(input + 3 * sizeof(Word) + 1, width, base, values);
+            std::memcpy(output, values, static_cast<std::size_t>(valueCount) * sizeof(Word));
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decodes a single block of a buffer written by encode.
+ *
+ * @details Block i holds values [128 * i, 128 * i + 128), the last one possibly fewer. Its position is read
+ * from the offset table, so no other block is touched. If the buffer or the block index is invalid, the
+ * function prints an error message and returns 0.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @param blockIndex The index of the block to decode.
+ * @param destination A pointer to room for 128 values.
+ * @return The number of values decoded.
+ */
+template <typename Integer>
+inline int DeltaCodec::decodeBlock(const unsigned char* source, int length, int blockIndex, Integer* destination) {
+    static_assert(std::is_integral<Integer>::value && (sizeof(Integer) == 4 || sizeof(Integer) == 8),
+        "DeltaCodec supports 32- and 64-bit integers.");
+    typedef typename std::conditional<sizeof(Integer) == 4, std::uint32_t, std::uint64_t>::type Word;
+
+    int count = 0;
+    const unsigned char* input = readHeader(source, length, sizeof(Integer), count) && destination != nullptr
+        ? blockAt(source, length, sizeof(Integer), blockIndex) : nullptr;
+    if (input == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid DeltaCodec decodeBlock operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    Word base;
+    std::memcpy(&base, input, sizeof(Word));
+    Word values[BlockSize];
+    unpackBlock(input + 3 * sizeof(Word) + 1, input[3 * sizeof(Word)], base, values);
+
+    int valueCount = std::min(BlockSize, count - blockIndex * BlockSize);
+    std::memcpy(destination, values, static_cast<std::size_t>(valueCount) * sizeof(Word));
+    return valueCount;
+}
+
+/**
+ * @brief Reads the minimum and maximum of a block of a buffer written by encode.
+ *
+ * @details Only the block's header is read. If the buffer or the block index is invalid, or the buffer was
+ * encoded from values of the other signedness, the function prints an error message and returns false.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @param blockIndex The index of the block.
+ * @param minimum Reference receiving the smallest value of the block.
+ * @param maximum Reference receiving the largest value of the block.
+ * @return True if the bounds were read, false otherwise.
+ */
+template <typename Integer>
+inline bool DeltaCodec::blockRange(const unsigned char* source, int length, int blockIndex, Integer& minimum, Integer& maximum) {
+    static_assert(std::is_integral<Integer>::value && (sizeof(Integer) == 4 || sizeof(Integer) == 8),
+        "DeltaCodec supports 32- and 64-bit integers.");
+
+    int count = 0;
+    const unsigned char* input = readHeader(source, length, sizeof(Integer), count) && source[5] == (std::is_signed<Integer>::value ? 1 : 0)
+        ? blockAt(source, length, sizeof(Integer), blockIndex) : nullptr;
+    if (input == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid DeltaCodec blockRange operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::memcpy(&minimum, input + sizeof(Integer), sizeof(Integer));
+    std::memcpy(&maximum, input + 2 * sizeof(Integer), sizeof(Integer));
+    return true;
+}
+
+/**
+ * @brief Returns the number of values in an encoded buffer.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @return The number of encoded values, or -1 if the header is invalid.
+ */
+inline int DeltaCodec::encodedCount(const unsigned char* source, int length) {
+    int count = 0;
+    if (source == nullptr || length < HeaderSize || !readHeader(source, length, source[4], count)) {
+        return -1;
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the number of blocks in an encoded buffer.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @return The number of blocks, or -1 if the header is invalid.
+ */
+inline int DeltaCodec::blockCount(const unsigned char* source, int length) {
+    int count = encodedCount(source, length);
+    return count < 0 ? -1 : (count + BlockSize - 1) / BlockSize;
+}
+
+/**
+ * @brief Validates the header of an encoded buffer.
+ *
+ * @param source A pointer to the encoded bytes.
+ * @param length The number of encoded bytes.
+ * @param elementSize The expected size of one value.
+ * @param count Reference receiving the number of encoded values.
+ * @return True if the header is valid and the offset table fits in the buffer, false otherwise.
+ */
+inline bool DeltaCodec::readHeader(const unsigned char* source, int length, int elementSize, int& count) {
+    if (source == nullptr || length < HeaderSize || source[0] != 'P' || source[1] != 'X' || source[2] != 'D'
+        || source[3] != 2 || source[4] != elementSize || source[5] > 1 || (elementSize != 4 && elementSize != 8)) {
+        return false;
+    }
+
+    std::uint32_t storedCount = 0;
+    for (int i = 0; i < 4; ++i) {
+        storedCount |= static_cast<std::uint32_t>(source[6 + i]) << (8 * i);
+    }
+    if (storedCount > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    count = static_cast<int>(storedCount);
+    std::uint64_t blocks = (storedCount + BlockSize - 1) / BlockSize;
+    return HeaderSize + 4 * blocks <= static_cast<std::uint64_t>(length);
+}
+
+/**
+ * @brief Locates a block of an encoded buffer through the offset table.
+ *
+ * @param source A pointer to the encoded bytes, whose header is valid.
+ * @param length The number of encoded bytes.
+ * @param elementSize The size of one value.
+ * @param blockIndex The index of the block.
+ * @return A pointer to the block, or nullptr if the index is out of range or the block is truncated.
+ */
+inline const unsigned char* DeltaCodec::blockAt(const unsigned char* source, int length, int elementSize, int blockIndex) {
+    int count = 0;
+    readHeader(source, length, elementSize, count);
+    int blocks = (count + BlockSize - 1) / BlockSize;
+    if (blockIndex < 0 || blockIndex >= blocks) {
+        return nullptr;
+    }
+
+    std::uint32_t offset = 0;
+    for (int i = 0; i < 4; ++i) {
+        offset |= static_cast<std::uint32_t>(source[HeaderSize + 4 * blockIndex + i]) << (8 * i);
+    }
+
+    std::uint64_t blockStart = HeaderSize + 4 * static_cast<std::uint64_t>(blocks) + offset;
+    if (blockStart + 3 * elementSize + 1 > static_cast<std::uint64_t>(length)) {
+        return nullptr;
+    }
+    int width = source[blockStart + 3 * elementSize];
+    if (width > elementSize * 8 || blockStart + 3 * elementSize + 1 + BlockSize / 8 * width > static_cast<std::uint64_t>(length)) {
+        return nullptr;
+    }
+    return source + blockStart;
+}
+
+/**
+ * @brief Returns the number of bits needed to store a value.
+ *
+ * @param value The value.
+ * @return The position of the highest set bit plus one, or 0 for 0.
+ */
+inline int DeltaCodec::bitWidth(std::uint64_t value) {
+    int width = 0;
+    while (value != 0) {
+        value >>= 1;
+        ++width;
+    }
+    return width;
+}
+
+/**
+ * @brief Packs 128 32-bit values at a bit width in four interleaved lanes.
+ *
+ * @details Value i belongs to lane i % 4. Each lane is a little-endian bit stream of its 32 values stored in
+ * every fourth 32-bit word, so the 16 * width bytes of output read as width vectors of four lanes.
+ *
+ * @param values A pointer to 128 values below 2^width.
+ * @param width The bit width, from 0 to 32.
+ * @param output A pointer to 16 * width bytes.
+ */
+inline void DeltaCodec::packBlock(const std::uint32_t* values, int width, unsigned char* output) {
+    if (width == 0) {
+        return;
+    }
+
+#ifdef PTRX_SSE2
+    __m128i* words = reinterpret_cast<__m128i*>(output);
+    __m128i accumulator = _mm_setzero_si128();
+    int filled = 0;
+    for (int i = 0; i < BlockSize / 4; ++i) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + 4 * i));
+        accumulator = _mm_or_si128(accumulator, _mm_sll_epi32(value, _mm_cvtsi32_si128(filled)));
+        filled += width;
+        if (filled >= 32) {
+            _mm_storeu_si128(words++, accumulator);
+            filled -= 32;
+            accumulator = filled > 0 ? _mm_srl_epi32(value, _mm_cvtsi32_si128(width - filled)) : _mm_setzero_si128();
+        }
+    }
+#else
+    for (int lane = 0; lane < 4; ++lane) {
+        std::uint64_t accumulator = 0;
+        int filled = 0;
+        int word = 0;
+        for (int i = 0; i < BlockSize / 4; ++i) {
+            accumulator |= static_cast<std::uint64_t>(values[4 * i + lane]) << filled;
+            filled += width;
+            if (filled >= 32) {
+                std::uint32_t bits = static_cast<std::uint32_t>(accumulator);
+                std::memcpy(output + 16 * word + 4 * lane, &bits, 4);
+                ++word;
+                accumulator >>= 32;
+                filled -= 32;
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Packs 128 64-bit values at a bit width into a little-endian bit stream.
+ *
+ * @param values A pointer to 128 values below 2^width.
+ * @param width The bit width, from 0 to 64.
+ * @param output A pointer to 16 * width bytes.
+ */
+inline void DeltaCodec::packBlock(const std::uint64_t* values, int width, unsigned char* output) {
+    std::uint64_t accumulator = 0;
+    int filled = 0;
+    for (int i = 0; i < BlockSize && width > 0; ++i) {
+        accumulator |= values[i] << filled;
+        if (filled + width >= 64) {
+            std::memcpy(output, &accumulator, 8);
+            output += 8;
+            int used = 64 - filled;
+            accumulator = used < 64 ? values[i] >> used : 0;
+            filled = width - used;
+        }
+        else {
+            filled += width;
+        }
+    }
+}
+
+/**
+ * @brief Unpacks a block of 32-bit differences and rebuilds the values.
+ *
+ * @details The SSE2 path extracts one vector of four lanes per step, undoes the zigzag encoding, and turns the
+ * differences into values with a four-wide prefix sum seeded by the last value of the previous step.
+ *
+ * @param input A pointer to the packed differences.
+ * @param width The bit width, from 0 to 32.
+ * @param base The first value of the block.
+ * @param output A pointer to room for 128 values.
+ */
+inline void DeltaCodec::unpackBlock(const unsigned char* input, int width, std::uint32_t base, std::uint32_t* output) {
+    if (width == 0) {
+        std::fill_n(output, BlockSize, base);
+        return;
+    }
+
+#ifdef PTRX_SSE2
+    const __m128i* words = reinterpret_cast<const __m128i*>(input);
+    __m128i mask = _mm_set1_epi32(width == 32 ? -1 : static_cast<int>((1u << width) - 1));
+    __m128i one = _mm_set1_epi32(1);
+    __m128i previous = _mm_set1_epi32(static_cast<int>(base));
+    __m128i word = _mm_loadu_si128(words++);
+    int consumed = 0;
+    for (int i = 0; i < BlockSize / 4; ++i) {
+        __m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128(consumed));
+        consumed += width;
+        if (consumed >= 32 && i + 1 < BlockSize / 4) {
+            consumed -= 32;
+            word = _mm_loadu_si128(words++);
+            if (consumed > 0) {
+                value = _mm_or_si128(value, _mm_sll_epi32(word, _mm_cvtsi32_si128(width - consumed)));
+            }
+        }
+        value = _mm_and_si128(value, mask);
+
+        __m128i delta = _mm_xor_si128(_mm_srli_epi32(value, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(value, one)));
+        delta = _mm_add_epi32(delta, _mm_slli_si128(delta, 4));
+        delta = _mm_add_epi32(delta, _mm_slli_si128(delta, 8));
+        previous = _mm_add_epi32(delta, _mm_shuffle_epi32(previous, _MM_SHUFFLE(3, 3, 3, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 4 * i), previous);
+    }
+#else
+    std::uint32_t mask = width == 32 ? 0xFFFFFFFFu : (1u << width) - 1;
+    for (int lane = 0; lane < 4; ++lane) {
+        std::uint64_t accumulator = 0;
+        int available = 0;
+        int word = 0;
+        for (int i = 0; i < BlockSize / 4; ++i) {
+            if (available < width) {
+                std::uint32_t bits;
+                std::memcpy(&bits, input + 16 * word + 4 * lane, 4);
+                ++word;
+                accumulator |= static_cast<std::uint64_t>(bits) << available;
+                available += 32;
+            }
+            output[4 * i + lane] = static_cast<std::uint32_t>(accumulator) & mask;
+            accumulator >>= width;
+            available -= width;
+        }
+    }
+
+    std::uint32_t previous = base;
+    for (int i = 0; i < BlockSize; ++i) {
+        std::uint32_t zigzag = output[i];
+        previous += (zigzag >> 1) ^ (0u - (zigzag & 1));
+        output[i] = previous;
+    }
+#endif
+}
+
+/**
+ * @brief Unpacks a block of 64-bit differences and rebuilds the values.
+ *
+ * @param input A pointer to the packed differences.
+ * @param width The bit width, from 0 to 64.
+ * @param base The first value of the block.
+ * @param output A pointer to room for 128 values.
+ */
+inline void DeltaCodec::unpackBlock(const unsigned char* input, int width, std::uint64_t base, std::uint64_t* output) {
+    std::uint64_t mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+    std::uint64_t previous = base;
+    std::uint64_t word = 0;
+    int available = 0;
+
+    for (int i = 0; i < BlockSize; ++i) {
+        std::uint64_t zigzag = 0;
+        if (width > 0) {
+            if (available >= width) {
+                zigzag = word & mask;
+                word = width < 64 ? word >> width : 0;
+                available -= width;
+            }
+            else {
+                std::uint64_t next;
+                std::memcpy(&next, input, 8);
+                input += 8;
+                zigzag = (word | (available > 0 ? next << available : next)) & mask;
+                int used = width - available;
+                word = used < 64 ? next >> used : 0;
+                available = 64 - used;
+            }
+        }
+        previous += (zigzag >> 1) ^ (std::uint64_t(0) - (zigzag & 1));
+        output[i] = previous;
+    }
+}
+
+const int LzCodec::MinMatch;
+const int LzCodec::HashBits;
+const int LzCodec::WindowSize;
+const int LzCodec::MaxAttempts;
+const int LzCodec::LastLiterals;
+const int LzCodec::MatchSearchLimit;
+
+/**
+ * @brief Returns the largest number of bytes encode can write.
+ *
+ * @details LzCodec is a byte-oriented LZ77 compressor writing the LZ4 block format: a stream of sequences, each
+ * a token byte holding the literal and match lengths, the literals, a 16-bit match offset, and length extension
+ * bytes where the token's nibbles overflow. Decoding is plain copying, which is what makes the format fast.
+ *
+ * @param length The number of bytes to encode.
+ * @return The size of the largest possible encoding, or 0 if the length is invalid.
+ */
+inline int LzCodec::maxEncodedSize(int length) {
+    if (length < 0) {
+        return 0;
+    }
+
+    std::uint64_t bound = static_cast<std::uint64_t>(length) + length / 255 + 16;
+    return bound > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) ? 0 : static_cast<int>(bound);
+}
+
+/**
+ * @brief Returns the largest number of bytes a buffer of encoded bytes can decode to.
+ *
+ * @details Every input byte yields at most 255 output bytes: a literal is copied once, a length extension byte
+ * adds at most 255 to a length, and a token with its 2-byte offset produces at most 14 literals and an 18-byte
+ * match. Callers use this to reject a claimed decoded size before allocating room for it.
+ *
+ * @param length The number of encoded bytes.
+ * @return The bound on the decoded size, or 0 if the length is invalid.
+ */
+inline std::uint64_t LzCodec::maxDecodedSize(int length) {
+    return length < 0 ? 0 : static_cast<std::uint64_t>(length) * 255;
+}
+
+/**
+ * @brief Compresses a byte buffer.
+ *
+ * @details Matches are found through a hash table of 4-byte sequences whose entries head chains linking every
+ * earlier position with the same hash inside the 64 KiB window. Up to 16 chain entries are compared and the
+ * longest match wins, which buys noticeably better ratios than a single-probe table at little cost. Positions
+ * covered by a match are added to the chains too. As the format requires, the last 5 bytes are always literals
+ * and no match starts within the last 12 bytes. If the inputs are invalid, the function prints an error message
+ * and returns 0.
+ *
+ * @param source A pointer to the bytes to compress.
+ * @param length The number of bytes.
+ * @param destination A pointer to at least maxEncodedSize(length) bytes.
+ * @return The number of bytes written.
+ */
+inline int LzCodec::encode(const unsigned char* source, int length, unsigned char* destination) {
+    if ((source == nullptr && length > 0) || length < 0 || destination == nullptr || maxEncodedSize(length) == 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid LzCodec encode operation." << std::endl;
+#endif
+        return 0;
+    }
+
+    unsigned char* output = destination;
+    int anchor = 0;
+
+    if (length > MatchSearchLimit) {
+        std::vector<int> head(std::size_t(1) << HashBits, -1);
+        std::vector<int> chain(WindowSize, -1);
+        int matchStartLimit = length - MatchSearchLimit;
+        int matchEndLimit = length - LastLiterals;
+
+        auto insert = [&](int position) {
+            std::uint32_t hash = hashSequence(read32(source + position));
+            chain[position & (WindowSize - 1)] = head[hash];
+            head[hash] = position;
+        };
+
+        int position = 0;
+        while (position < matchStartLimit) {
+            std::uint32_t sequence = read32(source + position);
+            int candidate = head[hashSequence(sequence)];
+            insert(position);
+
+            int bestLength = 0;
+            int bestOffset = 0;
+            for (int attempt = 0; attempt < MaxAttempts && candidate >= 0 && position - candidate < WindowSize; ++attempt) {
+                if (read32(source + candidate) == sequence) {
+                    int matchLength = MinMatch;
+                    while (position + matchLength < matchEndLimit && source[candidate + matchLength] == source[position + matchLength]) {
+                        ++matchLength;
+                    }
+                    if (matchLength > bestLength) {
+                        bestLength = matchLength;
+                        bestOffset = position - candidate;
+                    }
+                }
+
+                int next = chain[candidate & (WindowSize - 1)];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+
+            if (bestLength < MinMatch) {
+                ++position;
+                continue;
+            }
+
+            unsigned char* token = output++;
+            int literalLength = position - anchor;
+            *token = static_cast<unsigned char>(std::min(literalLength, 15) << 4);
+            if (literalLength >= 15) {
+                writeLength(output, literalLength - 15);
+            }
+            std::memcpy(output, source + anchor, static_cast<std::size_t>(literalLength));
+            output += literalLength;
+
+            *output++ = static_cast<unsigned char>(bestOffset);
+            *output++ = static_cast<unsigned char>(bestOffset >> 8);
+            int matchCode = bestLength - MinMatch;
+            *token |= static_cast<unsigned char>(std::min(matchCode, 15));
+            if (matchCode >= 15) {
+                writeLength(output, matchCode - 15);
+            }
+
+            int matchEnd = position + bestLength;
+            for (++position; position < matchEnd && position < matchStartLimit; ++position) {
+                insert(position);
+            }
+            position = matchEnd;
+            anchor = position;
+        }
+    }
+
+    int literalLength = length - anchor;
+    *output++ = static_cast<unsigned char>(std::min(literalLength, 15) << 4);
+    if (literalLength >= 15) {
+        writeLength(output, literalLength - 15);
+    }
+    std::memcpy(output, source + anchor, static_cast<std::size_t>(literalLength));
+    output += literalLength;
+
+    return static_cast<int>(output - destination);
+}
+
+/**
+ * @brief Decompresses a buffer written by encode.
+ *
+ * @details Sequences whose lengths fit in the token are decoded on a fast path while both buffers have room
+ * to spare: the literals are copied as one fixed 16-byte block and the match as three 8-byte blocks. Other
+ * matches are copied 8 bytes at a time, which may run up to 7 bytes past the match but
+ * never past the end of the output. A match less than 8 bytes back overlaps the bytes being written, so its
+ * first 8 bytes are copied singly; after that it repeats with a period of at least 8 and the 8-byte copies
+ * continue from a whole number of periods back. Only matches ending within 8 bytes of the output's end are
+ * copied byte by byte. Every length and offset is checked against both
+ * buffers, so corrupt input cannot read or write out of bounds. If the input is invalid or does not decode to
+ * exactly decodedLength bytes, the function prints an error message and returns false.
+ *
+ * @param source A pointer to the compressed bytes.
+ * @param length The number of compressed bytes.
+ * @param destination A pointer to decodedLength bytes.
+ * @param decodedLength The number of bytes the input decodes to.
+ * @return True if the buffer was decoded, false otherwise.
+ */
+inline bool LzCodec::decode(const unsigned char* source, int length, unsigned char* destination, int decodedLength) {
+    if (source == nullptr || length <= 0 || (destination == nullptr && decodedLength > 0) || decodedLength < 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid LzCodec decode operation." << std::endl;
+#endif
+        return false;
+    }
+
+    const unsigned char* input = source;
+    const unsigned char* inputEnd = source + length;
+    unsigned char* output = destination;
+    unsigned char* outputEnd = destination + decodedLength;
+    bool valid = false;
+    static const int Period[8] = { 0, 8, 8, 9, 8, 10, 12, 14 };
+
+    while (input < inputEnd) {
+        unsigned char token = *input++;
+        int literalLength = token >> 4;
+        int matchLength = token & 15;
+        int offset;
+
+        if (literalLength < 15 && matchLength < 15 && inputEnd - input >= 18 && outputEnd - output >= 48) {
+            std::memcpy(output, input, 16);
+            input += literalLength;
+            output += literalLength;
+            offset = input[0] | (input[1] << 8);
+            input += 2;
+            matchLength += MinMatch;
+            if (offset >= 8 && offset <= output - destination) {
+                std::memcpy(output, output - offset, 8);
+                std::memcpy(output + 8, output + 8 - offset, 8);
+                std::memcpy(output + 16, output + 16 - offset, 8);
+                output += matchLength;
+                continue;
+            }
+            if (offset > 0 && offset <= output - destination) {
+                const unsigned char* match = output - offset;
+                for (int i = 0; i < 8; ++i) {
+                    output[i] = match[i];
+                }
+                match = output + 8 - Period[offset];
+                std::memcpy(output + 8, match, 8);
+                std::memcpy(output + 16, match + 8, 8);
+                output += matchLength;
+                continue;
+            }
+        }
+        else {
+            if (literalLength == 15 && !readLength(input, inputEnd, literalLength)) {
+                break;
+            }
+            if (literalLength > inputEnd - input || literalLength > outputEnd - output) {
+                break;
+            }
+            std::memcpy(output, input, static_cast<std::size_t>(literalLength));
+            input += literalLength;
+            output += literalLength;
+
+            if (input == inputEnd) {
+                valid = output == outputEnd;
+                break;
+            }
+
+            if (inputEnd - input < 2) {
+                break;
+            }
+            offset = input[0] | (input[1] << 8);
+            input += 2;
+            if (matchLength == 15 && !readLength(input, inputEnd, matchLength)) {
+                break;
+            }
+            matchLength += MinMatch;
+        }
+
+        if (offset == 0 || offset > output - destination || matchLength > outputEnd - output) {
+            break;
+        }
+
+        const unsigned char* match = output - offset;
+        unsigned char* copyEnd = output + matchLength;
+        if (outputEnd - copyEnd >= 8) {
+            if (offset < 8) {
+                for (int i = 0; i < 8; ++i) {
+                    output[i] = match[i];
+                }
+                output += 8;
+                match = output - Period[offset];
+            }
+            while (output < copyEnd) {
+                std::memcpy(output, match, 8);
+                output += 8;
+                match += 8;
+            }
+            output = copyEnd;
+        }
+        else {
+            for (int i = 0; i < matchLength; ++i) {
+                output[i] = match[i];
+            }
+            output += matchLength;
+        }
+    }
+
+    if (!valid) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid LzCodec decode operation: Corrupt compressed data." << std::endl;
+#endif
+    }
+    return valid;
+}
+
+/**
+ * @brief Reads 4 bytes from an unaligned address.
+ *
+ * @param address The address to read.
+ * @return The bytes as a host-order integer.
+ */
+inline std::uint32_t LzCodec::read32(const unsigned char* address) {
+    std::uint32_t value;
+    std::memcpy(&value, address, 4);
+    return value;
+}
+
+/**
+ * @brief Hashes a 4-byte sequence to a hash table index.
+ *
+ * @param sequence The 4 bytes to hash.
+ * @return The top HashBits bits of the sequence times a large odd constant.
+ */
+inline std::uint32_t LzCodec::hashSequence(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+/**
+ * @brief Writes a length extension: 255 for every full 255, then the remainder.
+ *
+ * @param output Reference to the write position, advanced past the extension.
+ * @param length The length beyond the 15 held by the token nibble.
+ */
+inline void LzCodec::writeLength(unsigned char*& output, int length) {
+    while (length >= 255) {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<unsigned char>(length);
+}
+
+/**
+ * @brief Reads a length extension and adds it to a length.
+ *
+ * @param input Reference to the read position, advanced past the extension.
+ * @param end The end of the readable bytes.
+ * @param length Reference to the length, which holds 15 on entry.
+ * @return True if a complete extension was read without overflowing, false otherwise.
+ */
+inline bool LzCodec::readLength(const unsigned char*& input, const unsigned char* end, int& length) {
+    unsigned char byte;
+    do {
+        if (input == end || length > std::numeric_limits<int>::max() - 255) {
+            return false;
+        }
+        byte = *input++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Constructs a streaming compressor that cuts its input into independently compressed frames.
+ *
+ * @details Every frame holds frameSize elements, except that the last one may hold fewer, and is a complete
+ * compressMemory block: the 14-byte header followed by the payload, without padding to a multiple of sizeof(T).
+ * Frames can therefore be written out as they are produced and decoded in any order. An invalid frameSize is
+ * replaced by 65536.
+ *
+ * @param manager The manager whose thread pool encodes the frames.
+ * @param format The compression format of every frame.
+ * @param frameSize The number of elements per frame.
+ * @param policy The execution policy used to encode the frames of each push.
+ */
+template <typename T>
+inline FrameCompressor<T>::FrameCompressor(MemoryManager<T>& manager, CompressionFormat format, int frameSize, const ExecutionPolicy& policy)
+    : manager(&manager), format(format), frameSize(frameSize), policy(policy), finished(false) {
+    if (frameSize <= 0 || static_cast<std::uint64_t>(frameSize) * sizeof(T) > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameCompressor frame size." << std::endl;
+#endif
+        this->frameSize = 65536;
+    }
+}
+
+/**
+ * @brief Adds a chunk of elements to the stream.
+ *
+ * @details Whole frames are encoded directly from the chunk, in parallel under a parallel policy; only the
+ * elements that do not fill a frame are copied, to be completed by the next push or by finish. The encoded
+ * frames wait in the compressor until they are taken with nextFrame, so memory stays bounded by the
+ * compressed size of the frames not yet taken plus one frame of input. If the stream is finished, the inputs
+ * are invalid or a frame cannot be encoded in the chosen format, the function prints an error message and
+ * returns false.
+ *
+ * @param source A pointer to the elements to add.
+ * @param size The number of elements to add.
+ * @return True if the elements were added, false otherwise.
+ */
+template <typename T>
+inline bool FrameCompressor<T>::push(const T* source, int size) {
+    if (finished || size < 0 || (source == nullptr && size > 0)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameCompressor push operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t count = static_cast<std::size_t>(size);
+    std::size_t frame = static_cast<std::size_t>(frameSize);
+    std::size_t offset = 0;
+    if (!pending.empty()) {
+        offset = std::min(count, frame - pending.size());
+        pending.insert(pending.end(), source, source + offset);
+        if (pending.size() < frame) {
+            return true;
+        }
+        if (!encodeFrames(pending.data(), frame)) {
+            return false;
+        }
+        pending.clear();
+    }
+
+    std::size_t whole = (count - offset) / frame * frame;
+    if (whole > 0 && !encodeFrames(source + offset, whole)) {
+        return false;
+    }
+    offset += whole;
+
+    if (offset < count) {
+        pending.reserve(frame);
+        pending.insert(pending.end(), source + offset, source + count);
+    }
+    return true;
+}
+
+/**
+ * @brief Ends the stream, encoding the elements of a partly filled last frame.
+ *
+ * @details Calling finish again has no effect. If the last frame cannot be encoded, the function prints an
+ * error message and returns false.
+ *
+ * @return True if the stream was ended, false otherwise.
+ */
+template <typename T>
+inline bool FrameCompressor<T>::finish() {
+    if (finished) {
+        return true;
+    }
+
+    if (!pending.empty()) {
+        if (!encodeFrames(pending.data(), pending.size())) {
+            return false;
+        }
+        pending.clear();
+        pending.shrink_to_fit();
+    }
+
+    finished = true;
+    return true;
+}
+
+/**
+ * @brief Takes the next encoded frame, in stream order.
+ *
+ * @param frame Reference to a vector that receives the frame's bytes.
+ * @return True if a frame was taken, false if none is ready.
+ */
+template <typename T>
+inline bool FrameCompressor<T>::nextFrame(std::vector<unsigned char>& frame) {
+    if (ready.empty()) {
+        return false;
+    }
+
+    frame = std::move(ready.front());
+    ready.pop_front();
+    return true;
+}
+
+/**
+ * @brief Returns the number of encoded frames waiting to be taken.
+ *
+ * @return The number of ready frames.
+ */
+template <typename T>
+inline int FrameCompressor<T>::readyFrameCount() const {
+    return static_cast<int>(ready.size());
+}
+
+/**
+ * @brief Returns whether finish has been called.
+ *
+ * @return True if the stream is finished, false otherwise.
+ */
+template <typename T>
+inline bool FrameCompressor<T>::isFinished() const {
+    return finished;
+}
+
+/**
+ * @brief Encodes count elements as consecutive frames and queues them.
+ *
+ * @details Frames are handed to the manager's thread pool one at a time, so threads that finish early pick
+ * up the remaining frames.
+ *
+ * @param source A pointer to the elements.
+ * @param count The number of elements; every frame but the last holds frameSize of them.
+ * @return True if every frame was encoded, false otherwise.
+ */
+template <typename T>
+inline bool FrameCompressor<T>::encodeFrames(const T* source, std::size_t count) {
+    std::size_t frame = static_cast<std::size_t>(frameSize);
+    std::size_t frameCount = (count + frame - 1) / frame;
+    std::vector<std::vector<unsigned char>> frames(frameCount);
+    std::atomic<bool> encoded(true);
+
+    auto body = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            std::size_t first = i * frame;
+            if (!MemoryManager<T>::encodeFrame(source + first, std::min(frame, count - first), format, frames[i])) {
+                encoded = false;
+            }
+        }
+    };
+
+    int size = static_cast<int>(std::min<std::size_t>(count, static_cast<std::size_t>(std::numeric_limits<int>::max())));
+    unsigned int threads = manager->parallelThreadCount(size, policy);
+    if (threads <= 1 || frameCount <= 1) {
+        body(0, frameCount);
+    }
+    else {
+        manager->threadPool->parallelFor(frameCount, 1, threads, body);
+    }
+
+    if (!encoded) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameCompressor operation: Unsupported format." << std::endl;
+#endif
+        return false;
+    }
+
+    for (std::vector<unsigned char>& bytes : frames) {
+        ready.push_back(std::move(bytes));
+    }
+    return true;
+}
+
+/**
+ * @brief Constructs a decompressor with no stream open.
+ *
+ * @param manager The manager whose thread pool decodes the frames in decodeAll.
+ */
+template <typename T>
+inline FrameDecompressor<T>::FrameDecompressor(MemoryManager<T>& manager) : manager(&manager), data(nullptr) {
+}
+
+/**
+ * @brief Opens a stream of concatenated frames and indexes them.
+ *
+ * @details Only the frame headers are read, so opening is cheap; the bytes are not copied and must outlive the
+ * decompressor's use of them. If a header is invalid or a frame runs past the end of the data, the function
+ * prints an error message, leaves no stream open and returns false.
+ *
+ * @param data A pointer to the frames.
+ * @param length The number of bytes.
+ * @return True if the stream was opened, false otherwise.
+ */
+template <typename T>
+inline bool FrameDecompressor<T>::open(const unsigned char* data, std::size_t length) {
+    this->data = nullptr;
+    frameOffsets.assign(1, 0);
+    elementOffsets.assign(1, 0);
+    if (data == nullptr && length > 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameDecompressor open operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t offset = 0;
+    while (offset < length) {
+        unsigned char format = 0;
+        std::uint32_t count = 0, payloadBytes = 0;
+        if (!MemoryManager<T>::readCompressionHeader(data + offset, length - offset, format, count, payloadBytes) || count == 0) {
+#ifdef DEBUG_MODE
+            std::cerr << "Invalid FrameDecompressor open operation: Unrecognized frame." << std::endl;
+#endif
+            frameOffsets.assign(1, 0);
+            elementOffsets.assign(1, 0);
+            return false;
+        }
+
+        offset += MemoryManager<T>::CompressionHeaderSize + payloadBytes;
+        frameOffsets.push_back(offset);
+        elementOffsets.push_back(elementOffsets.back() + count);
+    }
+
+    this->data = data;
+    return true;
+}
+
+/**
+ * @brief Returns the number of frames of the open stream.
+ *
+ * @return The number of frames.
+ */
+template <typename T>
+inline int FrameDecompressor<T>::frameCount() const {
+    return static_cast<int>(frameOffsets.size() - 1);
+}
+
+/**
+ * @brief Returns the number of elements of a frame.
+ *
+ * @param index The index of the frame.
+ * @return The number of elements, or 0 if the index is out of range.
+ */
+template <typename T>
+inline int FrameDecompressor<T>::frameSize(int index) const {
+    if (index < 0 || index >= frameCount()) {
+        return 0;
+    }
+    return static_cast<int>(elementOffsets[index + 1] - elementOffsets[index]);
+}
+
+/**
+ * @brief Returns the number of elements of the whole stream.
+ *
+ * @return The total number of elements.
+ */
+template <typename T>
+inline std::size_t FrameDecompressor<T>::totalSize() const {
+    return elementOffsets.back();
+}
+
+/**
+ * @brief Decompresses a single frame.
+ *
+ * @details The frame is located through the index built by open, so frames can be read in any order. If the
+ * index is out of range or the frame is corrupt, the function prints an error message and returns false.
+ *
+ * @param index The index of the frame.
+ * @param destination A pointer to room for frameSize(index) elements.
+ * @return True if the frame was decoded, false otherwise.
+ */
+template <typename T>
+inline bool FrameDecompressor<T>::decodeFrame(int index, T* destination) const {
+    if (index < 0 || index >= frameCount() || destination == nullptr) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameDecompressor decodeFrame operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t begin = frameOffsets[index];
+    if (!MemoryManager<T>::decodeFrame(data + begin, frameOffsets[index + 1] - begin, destination,
+            elementOffsets[index + 1] - elementOffsets[index])) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameDecompressor decodeFrame operation: Corrupt frame." << std::endl;
+#endif
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decompresses the whole stream.
+ *
+ * @details Under a parallel policy the frames are decoded concurrently on the manager's thread pool, each
+ * straight into its place in destination. If any frame is corrupt, the function prints an error message and
+ * returns false; destination may then be partly written.
+ *
+ * @param destination A pointer to room for totalSize() elements.
+ * @param policy The execution policy to apply.
+ * @return True if every frame was decoded, false otherwise.
+ */
+template <typename T>
+inline bool FrameDecompressor<T>::decodeAll(T* destination, const ExecutionPolicy& policy) const {
+    if (destination == nullptr && totalSize() > 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameDecompressor decodeAll operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::size_t frames = frameOffsets.size() - 1;
+    std::atomic<bool> decoded(true);
+    auto body = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!MemoryManager<T>::decodeFrame(data + frameOffsets[i], frameOffsets[i + 1] - frameOffsets[i],
+                    destination + elementOffsets[i], elementOffsets[i + 1] - elementOffsets[i])) {
+                decoded = false;
+            }
+        }
+    };
+
+    int size = static_cast<int>(std::min<std::size_t>(totalSize(), static_cast<std::size_t>(std::numeric_limits<int>::max())));
+    unsigned int threads = manager->parallelThreadCount(size, policy);
+    if (threads <= 1 || frames <= 1) {
+        body(0, frames);
+    }
+    else {
+        manager->threadPool->parallelFor(frames, 1, threads, body);
+    }
+
+    if (!decoded) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid FrameDecompressor decodeAll operation: Corrupt frame." << std::endl;
+#endif
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the length of a frame from its header.
+ *
+ * @details A reader taking a stream from a file or socket can use this to find where each frame ends before
+ * the whole frame has arrived.
+ *
+ * @param header A pointer to the start of a frame.
+ * @param available The number of bytes of the frame available so far.
+ * @return The frame's length in bytes, or 0 if fewer than 14 bytes are available or the header is invalid.
+ */
+template <typename T>
+inline std::size_t FrameDecompressor<T>::frameLength(const unsigned char* header, std::size_t available) {
+    const std::size_t headerSize = MemoryManager<T>::CompressionHeaderSize;
+    unsigned char format = 0;
+    std::uint32_t count = 0, payloadBytes = 0;
+    if (header == nullptr || available < headerSize
+        || !MemoryManager<T>::readCompressionHeader(header, std::numeric_limits<std::size_t>::max(), format, count, payloadBytes)) {
+        return 0;
+    }
+    return headerSize + payloadBytes;
+}
+
+/**
+ * @brief Returns whether the processor and operating system support AVX2.
+ *
+ * @details The answer is computed once. Kernels using the extension are compiled with a target attribute, so
+ * the library does not need to be built with -mavx2 to use them.
+ *
+ * @return True if AVX2 instructions can be used, false otherwise.
+ */
+inline bool CpuFeatures::hasAvx2() {
+#if defined(PTRX_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#elif defined(PTRX_X86_DISPATCH)
+    static const bool supported = cpuidBit(1, 2, 27) && osSavesState(0x6) && cpuidBit(7, 1, 5);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns whether the processor and operating system support AVX-512 Foundation.
+ *
+ * @return True if AVX-512F instructions can be used, false otherwise.
+ */
+inline bool CpuFeatures::hasAvx512() {
+#if defined(PTRX_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+#elif defined(PTRX_X86_DISPATCH)
+    static const bool supported = cpuidBit(1, 2, 27) && osSavesState(0xE6) && cpuidBit(7, 1, 16);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns whether the processor supports the AES-NI instructions.
+ *
+ * @return True if AES-NI instructions can be used, false otherwise.
+ */
+inline bool CpuFeatures::hasAesNi() {
+#if defined(PTRX_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("aes");
+    return supported;
+#elif defined(PTRX_X86_DISPATCH)
+    static const bool supported = cpuidBit(1, 2, 25);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns whether the processor supports the PCLMULQDQ carry-less multiplication instruction.
+ *
+ * @return True if PCLMULQDQ can be used, false otherwise.
+ */
+inline bool CpuFeatures::hasPclmul() {
+#if defined(PTRX_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("pclmul");
+    return supported;
+#elif defined(PTRX_X86_DISPATCH)
+    static const bool supported = cpuidBit(1, 2, 1);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * @brief Tests a feature bit reported by the cpuid instruction.
+ *
+ * @details Only used with compilers that lack __builtin_cpu_supports.
+ *
+ * @param leaf The cpuid leaf, queried with subleaf 0.
+ * @param registerIndex The register holding the bit: 0 for EAX, 1 for EBX, 2 for ECX, 3 for EDX.
+ * @param bit The index of the bit.
+ * @return True if the bit is set, false otherwise.
+ */
+inline bool CpuFeatures::cpuidBit(unsigned int leaf, int registerIndex, int bit) {
+#if defined(_MSC_VER) && defined(PTRX_X86_DISPATCH)
+    int registers[4];
+    __cpuid(registers, 0);
+    if (static_cast<unsigned int>(registers[0]) < leaf) {
+        return false;
+    }
+    __cpuidex(registers, static_cast<int>(leaf), 0);
+    return (static_cast<unsigned int>(registers[registerIndex]) >> bit & 1) != 0;
+#else
+    (void)leaf;
+    (void)registerIndex;
+    (void)bit;
+    return false;
+#endif
+}
+
+/**
+ * @brief Tests whether the operating system saves a set of register states on context switches.
+ *
+ * @param mask The XCR0 bits that must all be set, 0x6 for the SSE and AVX state.
+ * @return True if every bit of mask is enabled, false otherwise.
+ */
+inline bool CpuFeatures::osSavesState(std::uint64_t mask) {
+#if defined(_MSC_VER) && defined(PTRX_X86_DISPATCH)
+    return (_xgetbv(0) & mask) == mask;
+#else
+    (void)mask;
+    return false;
+#endif
+}
+
+const int ChaCha20::KeySize;
+const int ChaCha20::NonceSize;
+const int ChaCha20::BlockSize;
+
+#define PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, a, b, c, d) \
+    a = ADD(a, b); d = ROTATE(XOR(d, a), 16); \
+    c = ADD(c, d); b = ROTATE(XOR(b, c), 12); \
+    a = ADD(a, b); d = ROTATE(XOR(d, a), 8); \
+    c = ADD(c, d); b = ROTATE(XOR(b, c), 7)
+
+#define PTRX_CHACHA_DOUBLE_ROUND(ADD, XOR, ROTATE, x) \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[0], x[4], x[8], x[12]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[1], x[5], x[9], x[13]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[2], x[6], x[10], x[14]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[3], x[7], x[11], x[15]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[0], x[5], x[10], x[15]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[1], x[6], x[11], x[12]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[2], x[7], x[8], x[13]); \
+    PTRX_CHACHA_QUARTER_ROUND(ADD, XOR, ROTATE, x[3], x[4], x[9], x[14])
+
+/**
+ * @brief Computes one 64-byte block of ChaCha20 keystream.
+ *
+ * @details This is the ChaCha20 block function of RFC 8439: 20 rounds over a state of four constant words,
+ * the 256-bit key, the 32-bit block counter and the 96-bit nonce, with the input state added to the result.
+ *
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter.
+ * @param output A pointer to 64 bytes receiving the keystream block.
+ */
+inline void ChaCha20::keystreamBlock(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, unsigned char* output) {
+    std::uint32_t state[16];
+    initializeState(key, nonce, counter, state);
+    std::memset(output, 0, BlockSize);
+    xorBlock(state, output, BlockSize);
+}
+
+/**
+ * @brief XORs a buffer in place with the ChaCha20 keystream, which both encrypts and decrypts.
+ *
+ * @details Keystream block i of the buffer uses block counter counter + i. Because the blocks are independent,
+ * whole groups of them are computed in SIMD lanes: 16 with AVX-512, 8 with AVX2 and 4 with SSE2, chosen at run
+ * time. Each lane holds one block, and the finished lanes are transposed back into byte order before the XOR.
+ * The tail that does not fill a group is handled one block at a time. If the inputs are invalid or the buffer
+ * would run the counter past 2^32 - 1, the function prints an error message and returns false.
+ *
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter of the first 64 bytes.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ * @return True if the buffer was processed, false otherwise.
+ */
+inline bool ChaCha20::xorKeystream(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, unsigned char* data, std::size_t length) {
+    std::uint64_t blocks = (static_cast<std::uint64_t>(length) + BlockSize - 1) / BlockSize;
+    if (key == nullptr || nonce == nullptr || (data == nullptr && length > 0) || counter + blocks > (std::uint64_t(1) << 32)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid ChaCha20 xorKeystream operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::uint32_t state[16];
+    initializeState(key, nonce, counter, state);
+    std::size_t offset = 0;
+
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx512()) {
+        for (; length - offset >= 16 * BlockSize; offset += 16 * BlockSize) {
+            xorBlocks16(state, data + offset);
+            state[12] += 16;
+        }
+    }
+    if (CpuFeatures::hasAvx2()) {
+        for (; length - offset >= 8 * BlockSize; offset += 8 * BlockSize) {
+            xorBlocks8(state, data + offset);
+            state[12] += 8;
+        }
+    }
+#endif
+#ifdef PTRX_SSE2
+    for (; length - offset >= 4 * BlockSize; offset += 4 * BlockSize) {
+        xorBlocks4(state, data + offset);
+        state[12] += 4;
+    }
+#endif
+
+    for (; offset < length; offset += BlockSize) {
+        xorBlock(state, data + offset, std::min<std::size_t>(BlockSize, length - offset));
+        ++state[12];
+    }
+    return true;
+}
+
+/**
+ * @brief Sets up the 16-word ChaCha20 input state.
+ *
+ * @param key A pointer to the 32-byte key.
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param counter The block counter.
+ * @param state A pointer to 16 words receiving the state.
+ */
+inline void ChaCha20::initializeState(const unsigned char* key, const unsigned char* nonce, std::uint32_t counter, std::uint32_t* state) {
+    auto load = [](const unsigned char* bytes) {
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8
+            | static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    };
+
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) {
+        state[4 + i] = load(key + 4 * i);
+    }
+    state[12] = counter;
+    for (int i = 0; i < 3; ++i) {
+        state[13 + i] = load(nonce + 4 * i);
+    }
+}
+
+/**
+ * @brief Rotates a 32-bit word left.
+ *
+ * @param value The word.
+ * @param shift The rotation, from 1 to 31.
+ * @return The rotated word.
+ */
+inline std::uint32_t ChaCha20::rotateLeft(std::uint32_t value, int shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+/**
+ * @brief XORs up to one block of data with the keystream block of a state.
+ *
+ * @param state A pointer to the 16-word input state.
+ * @param data A pointer to the data.
+ * @param length The number of bytes, at most 64.
+ */
+inline void ChaCha20::xorBlock(const std::uint32_t* state, unsigned char* data, std::size_t length) {
+    auto add = [](std::uint32_t a, std::uint32_t b) { return a + b; };
+    auto exclusiveOr = [](std::uint32_t a, std::uint32_t b) { return a ^ b; };
+    auto rotate = [](std::uint32_t value, int shift) { return rotateLeft(value, shift); };
+
+    std::uint32_t x[16];
+    std::memcpy(x, state, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        PTRX_CHACHA_DOUBLE_ROUND(add, exclusiveOr, rotate, x);
+    }
+
+    unsigned char keystream[BlockSize];
+    for (int i = 0; i < 16; ++i) {
+        std::uint32_t word = x[i] + state[i];
+        for (int j = 0; j < 4; ++j) {
+            keystream[4 * i + j] = static_cast<unsigned char>(word >> (8 * j));
+        }
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        data[i] ^= keystream[i];
+    }
+}
+
+#ifdef PTRX_SSE2
+#define PTRX_ROTATE128(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+
+/**
+ * @brief XORs 4 blocks of data with keystream computed in the four lanes of SSE2 registers.
+ *
+ * @details Register i holds word i of all four blocks. After the rounds, each group of four words is a 4x4
+ * matrix of 32-bit values that unpack instructions transpose into 16 contiguous bytes per block.
+ *
+ * @param state A pointer to the 16-word input state of the first block.
+ * @param data A pointer to 256 bytes of data.
+ */
+inline void ChaCha20::xorBlocks4(const std::uint32_t* state, unsigned char* data) {
+    __m128i input[16], x[16];
+    for (int i = 0; i < 16; ++i) {
+        input[i] = _mm_set1_epi32(static_cast<int>(state[i]));
+    }
+    input[12] = _mm_add_epi32(input[12], _mm_set_epi32(3, 2, 1, 0));
+    for (int i = 0; i < 16; ++i) {
+        x[i] = input[i];
+    }
+
+    for (int round = 0; round < 10; ++round) {
+        PTRX_CHACHA_DOUBLE_ROUND(_mm_add_epi32, _mm_xor_si128, PTRX_ROTATE128, x);
+    }
+
+    for (int group = 0; group < 4; ++group) {
+        __m128i a = _mm_add_epi32(x[4 * group], input[4 * group]);
+        __m128i b = _mm_add_epi32(x[4 * group + 1], input[4 * group + 1]);
+        __m128i c = _mm_add_epi32(x[4 * group + 2], input[4 * group + 2]);
+        __m128i d = _mm_add_epi32(x[4 * group + 3], input[4 * group + 3]);
+        __m128i ab0 = _mm_unpacklo_epi32(a, b);
+        __m128i cd0 = _mm_unpacklo_epi32(c, d);
+        __m128i ab1 = _mm_unpackhi_epi32(a, b);
+        __m128i cd1 = _mm_unpackhi_epi32(c, d);
+        __m128i rows[4] = { _mm_unpacklo_epi64(ab0, cd0), _mm_unpackhi_epi64(ab0, cd0), _mm_unpacklo_epi64(ab1, cd1), _mm_unpackhi_epi64(ab1, cd1) };
+        for (int block = 0; block < 4; ++block) {
+            __m128i* address = reinterpret_cast<__m128i*>(data + block * BlockSize + 16 * group);
+            _mm_storeu_si128(address, _mm_xor_si128(_mm_loadu_si128(address), rows[block]));
+        }
+    }
+}
+
+#undef PTRX_ROTATE128
+#endif
+
+#ifdef PTRX_X86_DISPATCH
+#define PTRX_ROTATE256(v, n) ((n) == 16 ? _mm256_shuffle_epi8(v, rotate16) : (n) == 8 ? _mm256_shuffle_epi8(v, rotate8) \
+    : _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - (n))))
+
+/**
+ * @brief XORs 8 blocks of data with keystream computed in the eight lanes of AVX2 registers.
+ *
+ * @details The rotations by 16 and 8 bits are byte shuffles. The transpose works within each 128-bit half as
+ * in xorBlocks4, leaving blocks 0 to 3 in the low halves and blocks 4 to 7 in the high halves; pairs of groups
+ * are then recombined across halves into 32 contiguous bytes per block.
+ *
+ * @param state A pointer to the 16-word input state of the first block.
+ * @param data A pointer to 512 bytes of data.
+ */
+PTRX_TARGET("avx2") inline void ChaCha20::xorBlocks8(const std::uint32_t* state, unsigned char* data) {
+    const __m256i rotate16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+        2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rotate8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+        3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+
+    __m256i input[16], x[16];
+    for (int i = 0; i < 16; ++i) {
+        input[i] = _mm256_set1_epi32(static_cast<int>(state[i]));
+    }
+    input[12] = _mm256_add_epi32(input[12], _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    for (int i = 0; i < 16; ++i) {
+        x[i] = input[i];
+    }
+
+    for (int round = 0; round < 10; ++round) {
+        PTRX_CHACHA_DOUBLE_ROUND(_mm256_add_epi32, _mm256_xor_si256, PTRX_ROTATE256, x);
+    }
+
+    __m256i rows[4][4];
+    for (int group = 0; group < 4; ++group) {
+        __m256i a = _mm256_add_epi32(x[4 * group], input[4 * group]);
+        __m256i b = _mm256_add_epi32(x[4 * group + 1], input[4 * group + 1]);
+        __m256i c = _mm256_add_epi32(x[4 * group + 2], input[4 * group + 2]);
+        __m256i d = _mm256_add_epi32(x[4 * group + 3], input[4 * group + 3]);
+        __m256i ab0 = _mm256_unpacklo_epi32(a, b);
+        __m256i cd0 = _mm256_unpacklo_epi32(c, d);
+        __m256i ab1 = _mm256_unpackhi_epi32(a, b);
+        __m256i cd1 = _mm256_unpackhi_epi32(c, d);
+        rows[group][0] = _mm256_unpacklo_epi64(ab0, cd0);
+        rows[group][1] = _mm256_unpackhi_epi64(ab0, cd0);
+        rows[group][2] = _mm256_unpacklo_epi64(ab1, cd1);
+        rows[group][3] = _mm256_unpackhi_epi64(ab1, cd1);
+    }
+
+    for (int block = 0; block < 4; ++block) {
+        for (int half = 0; half < 2; ++half) {
+            __m256i low = _mm256_permute2x128_si256(rows[2 * half][block], rows[2 * half + 1][block], 0x20);
+            __m256i high = _mm256_permute2x128_si256(rows[2 * half][block], rows[2 * half + 1][block], 0x31);
+            __m256i* lowAddress = reinterpret_cast<__m256i*>(data + block * BlockSize + 32 * half);
+            __m256i* highAddress = reinterpret_cast<__m256i*>(data + (block + 4) * BlockSize + 32 * half);
+            _mm256_storeu_si256(lowAddress, _mm256_xor_si256(_mm256_loadu_si256(lowAddress), low));
+            _mm256_storeu_si256(highAddress, _mm256_xor_si256(_mm256_loadu_si256(highAddress), high));
+        }
+    }
+}
+
+#undef PTRX_ROTATE256
+#define PTRX_ROTATE512(v, n) _mm512_rol_epi32(v, n)
+
+// GCC 12 reports the undefined source register of several AVX-512 intrinsics as an uninitialized read.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+/**
+ * @brief XORs 16 blocks of data with keystream computed in the sixteen lanes of AVX-512 registers.
+ *
+ * @details Rotations are single instructions. After the in-lane transpose of xorBlocks4, 128-bit lane k of the
+ * result for block b belongs to block b + 4k, and a 4x4 shuffle of 128-bit lanes assembles each block's 64
+ * bytes in one register.
+ *
+ * @param state A pointer to the 16-word input state of the first block.
+ * @param data A pointer to 1024 bytes of data.
+ */
+PTRX_TARGET("avx512f") inline void ChaCha20::xorBlocks16(const std::uint32_t* state, unsigned char* data) {
+    __m512i input[16], x[16];
+    for (int i = 0; i < 16; ++i) {
+        input[i] = _mm512_set1_epi32(static_cast<int>(state[i]));
+    }
+    input[12] = _mm512_add_epi32(input[12], _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    for (int i = 0; i < 16; ++i) {
+        x[i] = input[i];
+    }
+
+    for (int round = 0; round < 10; ++round) {
+        PTRX_CHACHA_DOUBLE_ROUND(_mm512_add_epi32, _mm512_xor_si512, PTRX_ROTATE512, x);
+    }
+
+    __m512i rows[4][4];
+    for (int group = 0; group < 4; ++group) {
+        __m512i a = _mm512_add_epi32(x[4 * group], input[4 * group]);
+        __m512i b = _mm512_add_epi32(x[4 * group + 1], input[4 * group + 1]);
+        __m512i c = _mm512_add_epi32(x[4 * group + 2], input[4 * group + 2]);
+        __m512i d = _mm512_add_epi32(x[4 * group + 3], input[4 * group + 3]);
+        __m512i ab0 = _mm512_unpacklo_epi32(a, b);
+        __m512i cd0 = _mm512_unpacklo_epi32(c, d);
+        __m512i ab1 = _mm512_unpackhi_epi32(a, b);
+        __m512i cd1 = _mm512_unpackhi_epi32(c, d);
+        rows[group][0] = _mm512_unpacklo_epi64(ab0, cd0);
+        rows[group][1] = _mm512_unpackhi_epi64(ab0, cd0);
+        rows[group][2] = _mm512_unpacklo_epi64(ab1, cd1);
+        rows[group][3] = _mm512_unpackhi_epi64(ab1, cd1);
+    }
+
+    for (int block = 0; block < 4; ++block) {
+        __m512i t0 = _mm512_shuffle_i32x4(rows[0][block], rows[1][block], 0x44);
+        __m512i t1 = _mm512_shuffle_i32x4(rows[0][block], rows[1][block], 0xEE);
+        __m512i t2 = _mm512_shuffle_i32x4(rows[2][block], rows[3][block], 0x44);
+        __m512i t3 = _mm512_shuffle_i32x4(rows[2][block], rows[3][block], 0xEE);
+        __m512i blocks[4] = { _mm512_shuffle_i32x4(t0, t2, 0x88), _mm512_shuffle_i32x4(t0, t2, 0xDD),
+            _mm512_shuffle_i32x4(t1, t3, 0x88), _mm512_shuffle_i32x4(t1, t3, 0xDD) };
+        for (int lane = 0; lane < 4; ++lane) {
+            unsigned char* address = data + (block + 4 * lane) * BlockSize;
+            _mm512_storeu_si512(address, _mm512_xor_si512(_mm512_loadu_si512(address), blocks[lane]));
+        }
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#undef PTRX_ROTATE512
+#else
+inline void ChaCha20::xorBlocks8(const std::uint32_t*, unsigned char*) {
+}
+
+inline void ChaCha20::xorBlocks16(const std::uint32_t*, unsigned char*) {
+}
+#endif
+
+#ifndef PTRX_SSE2
+inline void ChaCha20::xorBlocks4(const std::uint32_t*, unsigned char*) {
+}
+#endif
+
+#undef PTRX_CHACHA_DOUBLE_ROUND
+#undef PTRX_CHACHA_QUARTER_ROUND
+
+const int AesKey::BlockSize;
+const int AesKey::NonceSize;
+const int AesKey::TagSize;
+
+/**
+ * @brief Constructs an empty AES key; setKey must be called before it can be used.
+ */
+inline AesKey::AesKey() : roundKeys(), hashPowers(), rounds(0), keySize(0) {}
+
+/**
+ * @brief Constructs an AES key and expands its key schedule.
+ *
+ * @param key A pointer to the key bytes.
+ * @param keySize The key length in bytes, 16 for AES-128 or 32 for AES-256.
+ */
+inline AesKey::AesKey(const unsigned char* key, int keySize) : roundKeys(), hashPowers(), rounds(0), keySize(0) {
+    setKey(key, keySize);
+}
+
+/**
+ * @brief Destroys the key, overwriting the expanded key material.
+ */
+inline AesKey::~AesKey() {
+    volatile unsigned char* keys = roundKeys;
+    for (std::size_t i = 0; i < sizeof(roundKeys); ++i) {
+        keys[i] = 0;
+    }
+    volatile unsigned char* powers = hashPowers;
+    for (std::size_t i = 0; i < sizeof(hashPowers); ++i) {
+        powers[i] = 0;
+    }
+}
+
+/**
+ * @brief Expands a key into the round keys and the GCM hash key powers.
+ *
+ * @details The schedule is the key expansion of FIPS-197 and is computed once, so the same AesKey can encrypt
+ * any number of buffers without expanding the key again. The hash key H = AES(K, 0) and its powers H^2 to H^8,
+ * which let GHASH fold eight blocks per reduction, are computed here too. The S-box is evaluated arithmetically
+ * rather than looked up, so the expansion takes the same time for every key. If the inputs are invalid, the
+ * function prints an error message, leaves the key unusable and returns false.
+ *
+ * @param key A pointer to the key bytes.
+ * @param keySize The key length in bytes, 16 for AES-128 or 32 for AES-256.
+ * @return True if the key was expanded, false otherwise.
+ */
+inline bool AesKey::setKey(const unsigned char* key, int keySize) {
+    this->rounds = 0;
+    this->keySize = 0;
+    if (key == nullptr || (keySize != 16 && keySize != 32)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid AesKey setKey operation." << std::endl;
+#endif
+        return false;
+    }
+
+    int keyWords = keySize / 4;
+    int roundCount = keyWords + 6;
+    int totalWords = 4 * (roundCount + 1);
+    unsigned char roundConstant = 1;
+    std::memcpy(roundKeys, key, static_cast<std::size_t>(keySize));
+    for (int i = keyWords; i < totalWords; ++i) {
+        unsigned char word[4];
+        std::memcpy(word, roundKeys + 4 * (i - 1), 4);
+        if (i % keyWords == 0 || (keyWords > 6 && i % keyWords == 4)) {
+            if (i % keyWords == 0) {
+                unsigned char first = word[0];
+                word[0] = word[1];
+                word[1] = word[2];
+                word[2] = word[3];
+                word[3] = first;
+            }
+            substituteBytes(word, 4);
+            if (i % keyWords == 0) {
+                word[0] ^= roundConstant;
+                roundConstant = doubleByte(roundConstant);
+            }
+        }
+        for (int j = 0; j < 4; ++j) {
+            roundKeys[4 * i + j] = static_cast<unsigned char>(roundKeys[4 * (i - keyWords) + j] ^ word[j]);
+        }
+    }
+    this->rounds = roundCount;
+    this->keySize = keySize;
+
+    unsigned char hashKey[BlockSize] = {};
+    encryptBlocksSoftware(roundKeys, rounds, hashKey, 1);
+    std::uint64_t hashHigh = loadBigEndian64(hashKey);
+    std::uint64_t hashLow = loadBigEndian64(hashKey + 8);
+    std::uint64_t powerHigh = hashHigh;
+    std::uint64_t powerLow = hashLow;
+    for (int power = 0; power < 8; ++power) {
+        storeBigEndian64(hashPowers + 16 * power, powerHigh);
+        storeBigEndian64(hashPowers + 16 * power + 8, powerLow);
+        multiplyHash(powerHigh, powerLow, hashHigh, hashLow);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether the key schedule has been expanded.
+ *
+ * @return True if the key can be used, false otherwise.
+ */
+inline bool AesKey::isValid() const {
+    return rounds != 0;
+}
+
+/**
+ * @brief Returns the key length in bytes.
+ *
+ * @return 16 for AES-128, 32 for AES-256, or 0 if no key has been set.
+ */
+inline int AesKey::getKeySize() const {
+    return keySize;
+}
+
+/**
+ * @brief Encrypts a single 16-byte block.
+ *
+ * @details The input and output may point to the same block. The key must be valid.
+ *
+ * @param input A pointer to the 16-byte plaintext block.
+ * @param output A pointer to 16 bytes receiving the ciphertext block.
+ */
+inline void AesKey::encryptBlock(const unsigned char* input, unsigned char* output) const {
+    if (useHardware()) {
+        encryptBlockHardware(roundKeys, rounds, input, output);
+    }
+    else {
+        std::memmove(output, input, BlockSize);
+        encryptBlocksSoftware(roundKeys, rounds, output, 1);
+    }
+}
+
+/**
+ * @brief XORs a buffer in place with the AES-CTR keystream, which both encrypts and decrypts.
+ *
+ * @details Block i of the buffer is XORed with the encryption of counterBlock + blockOffset + i, the counter
+ * block being read as a big-endian 128-bit integer. blockOffset lets a buffer be processed in independent
+ * chunks. With AES-NI eight counter blocks go through the rounds together, which keeps the AES units busy;
+ * otherwise a table-free software implementation is used whose timing does not depend on the key or data. If the
+ * inputs are invalid, the function prints an error message and returns false.
+ *
+ * @param counterBlock A pointer to the 16-byte initial counter block.
+ * @param blockOffset The number of blocks the counter is advanced by before the first block.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ * @return True if the buffer was processed, false otherwise.
+ */
+inline bool AesKey::ctrXor(const unsigned char* counterBlock, std::uint64_t blockOffset, unsigned char* data, std::size_t length) const {
+    if (!isValid() || counterBlock == nullptr || (data == nullptr && length > 0)) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid AesKey ctrXor operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::uint64_t counterHigh = loadBigEndian64(counterBlock);
+    std::uint64_t counterLow = loadBigEndian64(counterBlock + 8) + blockOffset;
+    counterHigh += counterLow < blockOffset;
+    ctrBlocks(counterHigh, counterLow, data, length);
+    return true;
+}
+
+/**
+ * @brief Encrypts a buffer in place with AES-GCM and computes its authentication tag.
+ *
+ * @details This is GCM of NIST SP 800-38D with a 96-bit nonce and a 128-bit tag. The buffer is encrypted and
+ * hashed in 4 KiB slices, so each slice is still in cache when GHASH reads it back. If the inputs are invalid or
+ * the buffer exceeds the GCM limit of 2^36 - 32 bytes, the function prints an error message and returns false
+ * without changing the buffer.
+ *
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param aad A pointer to the additional authenticated data, or nullptr if aadLength is 0.
+ * @param aadLength The length of the additional data in bytes.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ * @param tag A pointer to 16 bytes receiving the authentication tag.
+ * @return True if the buffer was encrypted, false otherwise.
+ */
+inline bool AesKey::gcmEncrypt(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data, std::size_t length,
+    unsigned char* tag) const {
+    if (!isValid() || nonce == nullptr || (aad == nullptr && aadLength > 0) || (data == nullptr && length > 0) || tag == nullptr
+        || static_cast<std::uint64_t>(length) > (std::uint64_t(1) << 36) - 32) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid AesKey gcmEncrypt operation." << std::endl;
+#endif
+        return false;
+    }
+
+    gcmAuthenticate(nonce, aad, aadLength, data, length, true, tag);
+    return true;
+}
+
+/**
+ * @brief Verifies and decrypts a buffer encrypted with AES-GCM.
+ *
+ * @details The expected tag is computed over the ciphertext first and compared in constant time; only if it
+ * matches is the buffer decrypted. On a mismatch the buffer is left unchanged and the function prints an error
+ * message and returns false, as it does for invalid inputs.
+ *
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param aad A pointer to the additional authenticated data, or nullptr if aadLength is 0.
+ * @param aadLength The length of the additional data in bytes.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ * @param tag A pointer to the 16-byte authentication tag.
+ * @return True if the buffer was authenticated and decrypted, false otherwise.
+ */
+inline bool AesKey::gcmDecrypt(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data, std::size_t length,
+    const unsigned char* tag) const {
+    if (!isValid() || nonce == nullptr || (aad == nullptr && aadLength > 0) || (data == nullptr && length > 0) || tag == nullptr
+        || static_cast<std::uint64_t>(length) > (std::uint64_t(1) << 36) - 32) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid AesKey gcmDecrypt operation." << std::endl;
+#endif
+        return false;
+    }
+
+    unsigned char expected[TagSize];
+    gcmAuthenticate(nonce, aad, aadLength, data, length, false, expected);
+    unsigned char difference = 0;
+    for (int i = 0; i < TagSize; ++i) {
+        difference = static_cast<unsigned char>(difference | (expected[i] ^ tag[i]));
+    }
+    if (difference != 0) {
+#ifdef DEBUG_MODE
+        std::cerr << "Invalid AesKey gcmDecrypt operation." << std::endl;
+#endif
+        return false;
+    }
+
+    std::uint64_t counterHigh = loadBigEndian64(nonce);
+    std::uint64_t counterLow = (loadBigEndian64(nonce + 4) << 32) | 2;
+    ctrBlocks(counterHigh, counterLow, data, length);
+    return true;
+}
+
+/**
+ * @brief Computes a GCM tag, optionally encrypting the buffer as it is hashed.
+ *
+ * @details The pre-counter block is the nonce followed by the 32-bit value 1; encryption starts at the next
+ * counter. The GCM length limit keeps the low 32 bits of the counter from wrapping, so the 128-bit increment of
+ * ctrBlocks matches the 32-bit increment of the standard.
+ *
+ * @param nonce A pointer to the 12-byte nonce.
+ * @param aad A pointer to the additional authenticated data.
+ * @param aadLength The length of the additional data in bytes.
+ * @param data A pointer to the buffer, which is the ciphertext when encrypt is false.
+ * @param length The number of bytes.
+ * @param encrypt Whether to encrypt each slice before it is hashed.
+ * @param tag A pointer to 16 bytes receiving the tag.
+ */
+inline void AesKey::gcmAuthenticate(const unsigned char* nonce, const unsigned char* aad, std::size_t aadLength, unsigned char* data,
+    std::size_t length, bool encrypt, unsigned char* tag) const {
+    const std::size_t sliceBytes = 4096;
+
+    std::uint64_t counterHigh = loadBigEndian64(nonce);
+    std::uint64_t counterLow = (loadBigEndian64(nonce + 4) << 32) | 2;
+    unsigned char state[BlockSize] = {};
+    ghashUpdate(state, aad, aadLength);
+    for (std::size_t offset = 0; offset < length; offset += sliceBytes) {
+        std::size_t slice = std::min(sliceBytes, length - offset);
+        if (encrypt) {
+            ctrBlocks(counterHigh, counterLow, data + offset, slice);
+        }
+        ghashUpdate(state, data + offset, slice);
+    }
+
+    unsigned char lengths[BlockSize];
+    storeBigEndian64(lengths, static_cast<std::uint64_t>(aadLength) * 8);
+    storeBigEndian64(lengths + 8, static_cast<std::uint64_t>(length) * 8);
+    ghashUpdate(state, lengths, BlockSize);
+
+    unsigned char preCounter[BlockSize];
+    std::memcpy(preCounter, nonce, NonceSize);
+    preCounter[12] = 0;
+    preCounter[13] = 0;
+    preCounter[14] = 0;
+    preCounter[15] = 1;
+    encryptBlock(preCounter, tag);
+    for (int i = 0; i < TagSize; ++i) {
+        tag[i] = static_cast<unsigned char>(tag[i] ^ state[i]);
+    }
+}
+
+/**
+ * @brief Returns whether the AES-NI and PCLMULQDQ kernels can be used on this processor.
+ *
+ * @return True if both instruction sets are available, false otherwise.
+ */
+inline bool AesKey::useHardware() {
+#if defined(PTRX_X86_DISPATCH) && defined(PTRX_SSE2)
+    return CpuFeatures::hasAesNi() && CpuFeatures::hasPclmul();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Reads a big-endian 64-bit integer.
+ *
+ * @param bytes A pointer to 8 bytes.
+ * @return The integer value.
+ */
+inline std::uint64_t AesKey::loadBigEndian64(const unsigned char* bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = value << 8 | bytes[i];
+    }
+    return value;
+}
+
+/**
+ * @brief Writes a 64-bit integer in big-endian byte order.
+ *
+ * @param bytes A pointer to 8 bytes receiving the value.
+ * @param value The integer value.
+ */
+inline void AesKey::storeBigEndian64(unsigned char* bytes, std::uint64_t value) {
+    for (int i = 7; i >= 0; --i) {
+        bytes[i] = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief Reverses the byte order of a 64-bit integer.
+ *
+ * @param value The integer value.
+ * @return The value with its bytes reversed.
+ */
+inline std::uint64_t AesKey::byteSwap64(std::uint64_t value) {
+    value = (value & 0x00FF00FF00FF00FFULL) << 8 | (value >> 8 & 0x00FF00FF00FF00FFULL);
+    value = (value & 0x0000FFFF0000FFFFULL) << 16 | (value >> 16 & 0x0000FFFF0000FFFFULL);
+    return value << 32 | value >> 32;
+}
+
+/**
+ * @brief Transposes the 8x8 bit matrix formed by the bytes of a 64-bit word.
+ *
+ * @details Bit j of byte i moves to bit i of byte j, so eight bytes become eight bit planes and back again;
+ * the transform is its own inverse.
+ *
+ * @param value The eight bytes.
+ * @return The transposed bytes.
+ */
+inline std::uint64_t AesKey::transposeBits(std::uint64_t value) {
+    std::uint64_t swap = (value ^ value >> 7) & 0x00AA00AA00AA00AAULL;
+    value ^= swap ^ swap << 7;
+    swap = (value ^ value >> 14) & 0x0000CCCC0000CCCCULL;
+    value ^= swap ^ swap << 14;
+    swap = (value ^ value >> 28) & 0x00000000F0F0F0F0ULL;
+    return value ^ swap ^ swap << 28;
+}
+
+/**
+ * @brief Applies the AES S-box to 64 bytes held as bit planes.
+ *
+ * @details planes[i] holds bit i of each byte. The circuit is the 113-gate S-box of Boyar and Peralta: a linear
+ * layer, an inversion in GF(2^8) built from 32 AND gates and a second linear layer that also applies the affine
+ * map. It uses only bitwise logic, so unlike a lookup table it leaks nothing through cache timing.
+ *
+ * @param planes A pointer to the eight bit planes, replaced by those of the substituted bytes.
+ */
+inline void AesKey::substituteBitPlanes(std::uint64_t* planes) {
+    std::uint64_t x0 = planes[7], x1 = planes[6], x2 = planes[5], x3 = planes[4];
+    std::uint64_t x4 = planes[3], x5 = planes[2], x6 = planes[1], x7 = planes[0];
+
+    std::uint64_t y14 = x3 ^ x5, y13 = x0 ^ x6, y9 = x0 ^ x3, y8 = x0 ^ x5;
+    std::uint64_t t0 = x1 ^ x2, y1 = t0 ^ x7, y4 = y1 ^ x3, y12 = y13 ^ y14;
+    std::uint64_t y2 = y1 ^ x0, y5 = y1 ^ x6, y3 = y5 ^ y8, t1 = x4 ^ y12;
+    std::uint64_t y15 = t1 ^ x5, y20 = t1 ^ x1, y6 = y15 ^ x7, y10 = y15 ^ t0;
+    std::uint64_t y11 = y20 ^ y9, y7 = x7 ^ y11, y17 = y10 ^ y11, y19 = y10 ^ y8;
+    std::uint64_t y16 = t0 ^ y11, y21 = y13 ^ y16, y18 = x0 ^ y16;
+
+    std::uint64_t t2 = y12 & y15, t3 = y3 & y6, t4 = t3 ^ t2, t5 = y4 & x7;
+    std::uint64_t t6 = t5 ^ t2, t7 = y13 & y16, t8 = y5 & y1, t9 = t8 ^ t7;
+    std::uint64_t t10 = y2 & y7, t11 = t10 ^ t7, t12 = y9 & y11, t13 = y14 & y17;
+    std::uint64_t t14 = t13 ^ t12, t15 = y8 & y10, t16 = t15 ^ t12, t17 = t4 ^ t14;
+    std::uint64_t t18 = t6 ^ t16, t19 = t9 ^ t14, t20 = t11 ^ t16, t21 = t17 ^ y20;
+    std::uint64_t t22 = t18 ^ y19, t23 = t19 ^ y21, t24 = t20 ^ y18;
+
+    std::uint64_t t25 = t21 ^ t22, t26 = t21 & t23, t27 = t24 ^ t26, t28 = t25 & t27;
+    std::uint64_t t29 = t28 ^ t22, t30 = t23 ^ t24, t31 = t22 ^ t26, t32 = t31 & t30;
+    std::uint64_t t33 = t32 ^ t24, t34 = t23 ^ t33, t35 = t27 ^ t33, t36 = t24 & t35;
+    std::uint64_t t37 = t36 ^ t34, t38 = t27 ^ t36, t39 = t29 & t38, t40 = t25 ^ t39;
+
+    std::uint64_t t41 = t40 ^ t37, t42 = t29 ^ t33, t43 = t29 ^ t40, t44 = t33 ^ t37, t45 = t42 ^ t41;
+    std::uint64_t z0 = t44 & y15, z1 = t37 & y6, z2 = t33 & x7, z3 = t43 & y16, z4 = t40 & y1, z5 = t29 & y7;
+    std::uint64_t z6 = t42 & y11, z7 = t45 & y17, z8 = t41 & y10, z9 = t44 & y12, z10 = t37 & y3, z11 = t33 & y4;
+    std::uint64_t z12 = t43 & y13, z13 = t40 & y5, z14 = t29 & y2, z15 = t42 & y9, z16 = t45 & y14, z17 = t41 & y8;
+
+    std::uint64_t t46 = z15 ^ z16, t47 = z10 ^ z11, t48 = z5 ^ z13, t49 = z9 ^ z10;
+    std::uint64_t t50 = z2 ^ z12, t51 = z2 ^ z5, t52 = z7 ^ z8, t53 = z0 ^ z3;
+    std::uint64_t t54 = z6 ^ z7, t55 = z16 ^ z17, t56 = z12 ^ t48, t57 = t50 ^ t53;
+    std::uint64_t t58 = z4 ^ t46, t59 = z3 ^ t54, t60 = t46 ^ t57, t61 = z14 ^ t57;
+    std::uint64_t t62 = t52 ^ t58, t63 = t49 ^ t58, t64 = z4 ^ t59, t65 = t61 ^ t62;
+    std::uint64_t t66 = z1 ^ t63, t67 = t64 ^ t65;
+    std::uint64_t s3 = t53 ^ t66;
+
+    planes[7] = t59 ^ t63;
+    planes[6] = t64 ^ ~s3;
+    planes[5] = t55 ^ ~t67;
+    planes[4] = s3;
+    planes[3] = t51 ^ t66;
+    planes[2] = t47 ^ t65;
+    planes[1] = t56 ^ ~t62;
+    planes[0] = t48 ^ ~t60;
+}
+
+/**
+ * @brief Applies the AES S-box to up to 64 bytes without table lookups.
+ *
+ * @details Each group of eight bytes is transposed into bit planes, all groups go through the bitsliced S-box
+ * together, and the planes are transposed back.
+ *
+ * @param bytes A pointer to the bytes, substituted in place.
+ * @param length The number of bytes, at most 64.
+ */
+inline void AesKey::substituteBytes(unsigned char* bytes, int length) {
+    int words = (length + 7) / 8;
+    std::uint64_t planes[8] = {};
+    for (int word = 0; word < words; ++word) {
+        std::uint64_t value = 0;
+        std::memcpy(&value, bytes + 8 * word, static_cast<std::size_t>(std::min(8, length - 8 * word)));
+        value = transposeBits(value);
+        for (int bit = 0; bit < 8; ++bit) {
+            planes[bit] |= (value >> (8 * bit) & 0xFF) << (8 * word);
+        }
+    }
+
+    substituteBitPlanes(planes);
+
+    for (int word = 0; word < words; ++word) {
+        std::uint64_t value = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            value |= (planes[bit] >> (8 * word) & 0xFF) << (8 * bit);
+        }
+        value = transposeBits(value);
+        std::memcpy(bytes + 8 * word, &value, static_cast<std::size_t>(std::min(8, length - 8 * word)));
+    }
+}
+
+/**
+ * @brief Multiplies a GF(2^8) element by x without branching.
+ *
+ * @param value The element.
+ * @return The element multiplied by x modulo the AES polynomial.
+ */
+inline unsigned char AesKey::doubleByte(unsigned char value) {
+    return static_cast<unsigned char>(value << 1 ^ (0x1B & (0 - (value >> 7))));
+}
+
+/**
+ * @brief Encrypts up to four blocks in place with the portable constant-time implementation.
+ *
+ * @details The state is kept in the column-major byte order of FIPS-197. SubBytes of all blocks shares one pass
+ * of the bitsliced S-box, ShiftRows is a fixed permutation and MixColumns uses branch-free doubling, so no step
+ * depends on secret values through memory addresses or branches.
+ *
+ * @param roundKeys A pointer to the expanded round keys.
+ * @param rounds The number of rounds, 10 or 14.
+ * @param blocks A pointer to count consecutive 16-byte blocks, encrypted in place.
+ * @param count The number of blocks, from 1 to 4.
+ */
+inline void AesKey::encryptBlocksSoftware(const unsigned char* roundKeys, int rounds, unsigned char* blocks, int count) {
+    for (int block = 0; block < count; ++block) {
+        for (int i = 0; i < 16; ++i) {
+            blocks[16 * block + i] = static_cast<unsigned char>(blocks[16 * block + i] ^ roundKeys[i]);
+        }
+    }
+
+    for (int round = 1; round <= rounds; ++round) {
+        substituteBytes(blocks, 16 * count);
+        for (int block = 0; block < count; ++block) {
+            unsigned char* state = blocks + 16 * block;
+            unsigned char substituted[16];
+            std::memcpy(substituted, state, 16);
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 4; ++row) {
+                    state[4 * column + row] = substituted[4 * ((column + row) & 3) + row];
+                }
+            }
+
+            if (round != rounds) {
+                for (int column = 0; column < 4; ++column) {
+                    unsigned char* c = state + 4 * column;
+                    unsigned char all = static_cast<unsigned char>(c[0] ^ c[1] ^ c[2] ^ c[3]);
+                    unsigned char first = c[0];
+                    c[0] = static_cast<unsigned char>(c[0] ^ all ^ doubleByte(static_cast<unsigned char>(c[0] ^ c[1])));
+                    c[1] = static_cast<unsigned char>(c[1] ^ all ^ doubleByte(static_cast<unsigned char>(c[1] ^ c[2])));
+                    c[2] = static_cast<unsigned char>(c[2] ^ all ^ doubleByte(static_cast<unsigned char>(c[2] ^ c[3])));
+                    c[3] = static_cast<unsigned char>(c[3] ^ all ^ doubleByte(static_cast<unsigned char>(c[3] ^ first)));
+                }
+            }
+
+            for (int i = 0; i < 16; ++i) {
+                state[i] = static_cast<unsigned char>(state[i] ^ roundKeys[16 * round + i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Multiplies a GHASH value by the hash key in GF(2^128) without branching.
+ *
+ * @details Elements use the bit order of the GCM specification, with the first bit in the most significant
+ * position of high. Every one of the 128 steps runs the same instructions, selecting with masks, so the time
+ * does not depend on the key or data.
+ *
+ * @param high The upper 64 bits of the value, replaced by the product.
+ * @param low The lower 64 bits of the value, replaced by the product.
+ * @param hashHigh The upper 64 bits of the multiplier.
+ * @param hashLow The lower 64 bits of the multiplier.
+ */
+inline void AesKey::multiplyHash(std::uint64_t& high, std::uint64_t& low, std::uint64_t hashHigh, std::uint64_t hashLow) {
+    std::uint64_t productHigh = 0;
+    std::uint64_t productLow = 0;
+    std::uint64_t multiplierHigh = hashHigh;
+    std::uint64_t multiplierLow = hashLow;
+    for (int bit = 0; bit < 128; ++bit) {
+        std::uint64_t word = bit < 64 ? high : low;
+        std::uint64_t mask = 0 - (word >> (63 - (bit & 63)) & 1);
+        productHigh ^= multiplierHigh & mask;
+        productLow ^= multiplierLow & mask;
+        std::uint64_t carry = 0 - (multiplierLow & 1);
+        multiplierLow = multiplierLow >> 1 | multiplierHigh << 63;
+        multiplierHigh = multiplierHigh >> 1 ^ (0xE100000000000000ULL & carry);
+    }
+    high = productHigh;
+    low = productLow;
+}
+
+/**
+ * @brief Encrypts counter blocks into the keystream and XORs it into a buffer.
+ *
+ * @param counterHigh The upper 64 bits of the counter, advanced past the blocks used.
+ * @param counterLow The lower 64 bits of the counter, advanced past the blocks used.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ */
+inline void AesKey::ctrBlocks(std::uint64_t& counterHigh, std::uint64_t& counterLow, unsigned char* data, std::size_t length) const {
+    if (useHardware()) {
+        ctrBlocksHardware(roundKeys, rounds, counterHigh, counterLow, data, length);
+        return;
+    }
+
+    for (std::size_t offset = 0; offset < length; offset += 4 * BlockSize) {
+        unsigned char keystream[4 * BlockSize];
+        std::size_t bytes = std::min<std::size_t>(4 * BlockSize, length - offset);
+        int count = static_cast<int>((bytes + BlockSize - 1) / BlockSize);
+        for (int block = 0; block < count; ++block) {
+            storeBigEndian64(keystream + BlockSize * block, counterHigh);
+            storeBigEndian64(keystream + BlockSize * block + 8, counterLow);
+            counterHigh += ++counterLow == 0;
+        }
+        encryptBlocksSoftware(roundKeys, rounds, keystream, count);
+        for (std::size_t i = 0; i < bytes; ++i) {
+            data[offset + i] = static_cast<unsigned char>(data[offset + i] ^ keystream[i]);
+        }
+    }
+}
+
+/**
+ * @brief Absorbs data into a GHASH state, zero-padding a final partial block.
+ *
+ * @param state A pointer to the 16-byte GHASH state in GCM byte order.
+ * @param data A pointer to the data.
+ * @param length The number of bytes.
+ */
+inline void AesKey::ghashUpdate(unsigned char* state, const unsigned char* data, std::size_t length) const {
+    if (length == 0) {
+        return;
+    }
+    if (useHardware()) {
+        ghashHardware(hashPowers, state, data, length);
+        return;
+    }
+
+    std::uint64_t high = loadBigEndian64(state);
+    std::uint64_t low = loadBigEndian64(state + 8);
+    std::uint64_t hashHigh = loadBigEndian64(hashPowers);
+    std::uint64_t hashLow = loadBigEndian64(hashPowers + 8);
+    for (std::size_t offset = 0; offset < length; offset += BlockSize) {
+        unsigned char block[BlockSize] = {};
+        std::memcpy(block, data + offset, std::min<std::size_t>(BlockSize, length - offset));
+        high ^= loadBigEndian64(block);
+        low ^= loadBigEndian64(block + 8);
+        multiplyHash(high, low, hashHigh, hashLow);
+    }
+    storeBigEndian64(state, high);
+    storeBigEndian64(state + 8, low);
+}
+
+#if defined(PTRX_X86_DISPATCH) && defined(PTRX_SSE2)
+// Carry-less product of two byte-reflected GHASH operands, accumulated unreduced into low:high.
+#define PTRX_GHASH_MULTIPLY(a, b, low, high) \
+    do { \
+        __m128i middle_ = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01)); \
+        low = _mm_xor_si128(low, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(middle_, 8))); \
+        high = _mm_xor_si128(high, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(middle_, 8))); \
+    } while (0)
+
+// Shifts the 256-bit product left by one bit for the reflected bit order and reduces it modulo the GCM polynomial.
+#define PTRX_GHASH_REDUCE(low, high, result) \
+    do { \
+        __m128i lowCarry_ = _mm_srli_epi32(low, 31); \
+        __m128i highCarry_ = _mm_srli_epi32(high, 31); \
+        __m128i shiftedLow_ = _mm_or_si128(_mm_slli_epi32(low, 1), _mm_slli_si128(lowCarry_, 4)); \
+        __m128i shiftedHigh_ = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(high, 1), _mm_slli_si128(highCarry_, 4)), \
+            _mm_srli_si128(lowCarry_, 12)); \
+        __m128i fold_ = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(shiftedLow_, 31), _mm_slli_epi32(shiftedLow_, 30)), \
+            _mm_slli_epi32(shiftedLow_, 25)); \
+        __m128i spill_ = _mm_srli_si128(fold_, 4); \
+        shiftedLow_ = _mm_xor_si128(shiftedLow_, _mm_slli_si128(fold_, 12)); \
+        __m128i folded_ = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(shiftedLow_, 1), _mm_srli_epi32(shiftedLow_, 2)), \
+            _mm_xor_si128(_mm_srli_epi32(shiftedLow_, 7), spill_)); \
+        result = _mm_xor_si128(shiftedHigh_, _mm_xor_si128(shiftedLow_, folded_)); \
+    } while (0)
+
+/**
+ * @brief Encrypts one block with the AES-NI instructions.
+ *
+ * @param roundKeys A pointer to the expanded round keys.
+ * @param rounds The number of rounds, 10 or 14.
+ * @param input A pointer to the 16-byte plaintext block.
+ * @param output A pointer to 16 bytes receiving the ciphertext block.
+ */
+PTRX_TARGET("aes,sse2")
+inline void AesKey::encryptBlockHardware(const unsigned char* roundKeys, int rounds, const unsigned char* input, unsigned char* output) {
+    const __m128i* keys = reinterpret_cast<const __m128i*>(roundKeys);
+    __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), _mm_loadu_si128(keys));
+    for (int round = 1; round < rounds; ++round) {
+        block = _mm_aesenc_si128(block, _mm_loadu_si128(keys + round));
+    }
+    block = _mm_aesenclast_si128(block, _mm_loadu_si128(keys + rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), block);
+}
+
+/**
+ * @brief XORs a buffer with the AES-CTR keystream using the AES-NI instructions.
+ *
+ * @details Eight counter blocks are encrypted per iteration. AESENC has a latency of several cycles but can start
+ * every cycle, so interleaving eight independent blocks hides the latency that a block-at-a-time loop would
+ * expose. Remaining whole blocks are processed singly and a final partial block through a temporary keystream.
+ *
+ * @param roundKeys A pointer to the expanded round keys.
+ * @param rounds The number of rounds, 10 or 14.
+ * @param counterHigh The upper 64 bits of the counter, advanced past the blocks used.
+ * @param counterLow The lower 64 bits of the counter, advanced past the blocks used.
+ * @param data A pointer to the buffer.
+ * @param length The number of bytes.
+ */
+PTRX_TARGET("aes,sse2")
+inline void AesKey::ctrBlocksHardware(const unsigned char* roundKeys, int rounds, std::uint64_t& counterHigh, std::uint64_t& counterLow,
+    unsigned char* data, std::size_t length) {
+    __m128i keys[15];
+    for (int round = 0; round <= rounds; ++round) {
+        keys[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundKeys) + round);
+    }
+
+#define PTRX_AES_COUNTER_BLOCK(block) \
+    block = _mm_xor_si128(_mm_set_epi64x(static_cast<long long>(byteSwap64(counterLow)), \
+        static_cast<long long>(byteSwap64(counterHigh))), keys[0]); \
+    counterHigh += ++counterLow == 0
+#define PTRX_AES_EIGHT(INSTRUCTION, key) \
+    b0 = INSTRUCTION(b0, key); b1 = INSTRUCTION(b1, key); b2 = INSTRUCTION(b2, key); b3 = INSTRUCTION(b3, key); \
+    b4 = INSTRUCTION(b4, key); b5 = INSTRUCTION(b5, key); b6 = INSTRUCTION(b6, key); b7 = INSTRUCTION(b7, key)
+#define PTRX_AES_XOR_STORE(lane, block) \
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + offset) + lane, \
+        _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset) + lane), block))
+
+    std::size_t offset = 0;
+    for (; length - offset >= 8 * BlockSize; offset += 8 * BlockSize) {
+        __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+        PTRX_AES_COUNTER_BLOCK(b0);
+        PTRX_AES_COUNTER_BLOCK(b1);
+        PTRX_AES_COUNTER_BLOCK(b2);
+        PTRX_AES_COUNTER_BLOCK(b3);
+        PTRX_AES_COUNTER_BLOCK(b4);
+        PTRX_AES_COUNTER_BLOCK(b5);
+        PTRX_AES_COUNTER_BLOCK(b6);
+        PTRX_AES_COUNTER_BLOCK(b7);
+        for (int round = 1; round < rounds; ++round) {
+            PTRX_AES_EIGHT(_mm_aesenc_si128, keys[round]);
+        }
+        PTRX_AES_EIGHT(_mm_aesenclast_si128, keys[rounds]);
+        PTRX_AES_XOR_STORE(0, b0);
+        PTRX_AES_XOR_STORE(1, b1);
+        PTRX_AES_XOR_STORE(2, b2);
+        PTRX_AES_XOR_STORE(3, b3);
+        PTRX_AES_XOR_STORE(4, b4);
+        PTRX_AES_XOR_STORE(5, b5);
+        PTRX_AES_XOR_STORE(6, b6);
+        PTRX_AES_XOR_STORE(7, b7);
+    }
+
+    for (; offset < length; offset += BlockSize) {
+        __m128i block;
+        PTRX_AES_COUNTER_BLOCK(block);
+        for (int round = 1; round < rounds; ++round) {
+            block = _mm_aesenc_si128(block, keys[round]);
+        }
+        block = _mm_aesenclast_si128(block, keys[rounds]);
+        if (length - offset >= static_cast<std::size_t>(BlockSize)) {
+            __m128i* address = reinterpret_cast<__m128i*>(data + offset);
+            _mm_storeu_si128(address, _mm_xor_si128(_mm_loadu_si128(address), block));
+        }
+        else {
+            unsigned char keystream[BlockSize];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keystream), block);
+            for (std::size_t i = 0; i < length - offset; ++i) {
+                data[offset + i] = static_cast<unsigned char>(data[offset + i] ^ keystream[i]);
+            }
+        }
+    }
+}
+
+#undef PTRX_AES_XOR_STORE
+#undef PTRX_AES_EIGHT
+#undef PTRX_AES_COUNTER_BLOCK
+
+/**
+ * @brief Absorbs data into a GHASH state using carry-less multiplication.
+ *
+ * @details Operands are byte-reversed so PCLMULQDQ sees the reflected bit order of GCM. Eight blocks are folded
+ * per reduction as (Y + X1) * H^8 + X2 * H^7 + ... + X8 * H: the eight unreduced products are summed and reduced
+ * once, and the multiplications are independent, so they overlap in the pipeline.
+ *
+ * @param hashPowers A pointer to H^1 to H^8, 16 bytes each in GCM byte order.
+ * @param state A pointer to the 16-byte GHASH state in GCM byte order.
+ * @param data A pointer to the data.
+ * @param length The number of bytes.
+ */
+PTRX_TARGET("pclmul,ssse3")
+inline void AesKey::ghashHardware(const unsigned char* hashPowers, unsigned char* state, const unsigned char* data, std::size_t length) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i powers[8];
+    for (int power = 0; power < 8; ++power) {
+        powers[power] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hashPowers) + power), reverse);
+    }
+    __m128i hash = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), reverse);
+
+    std::size_t offset = 0;
+    for (; length - offset >= 8 * BlockSize; offset += 8 * BlockSize) {
+        __m128i low = _mm_setzero_si128();
+        __m128i high = _mm_setzero_si128();
+        for (int lane = 0; lane < 8; ++lane) {
+            __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset) + lane), reverse);
+            if (lane == 0) {
+                block = _mm_xor_si128(block, hash);
+            }
+            PTRX_GHASH_MULTIPLY(block, powers[7 - lane], low, high);
+        }
+        PTRX_GHASH_REDUCE(low, high, hash);
+    }
+
+    for (; offset < length; offset += BlockSize) {
+        unsigned char padded[BlockSize] = {};
+        std::memcpy(padded, data + offset, std::min<std::size_t>(BlockSize, length - offset));
+        __m128i block = _mm_xor_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(padded)), reverse), hash);
+        __m128i low = _mm_setzero_si128();
+        __m128i high = _mm_setzero_si128();
+        PTRX_GHASH_MULTIPLY(block, powers[0], low, high);
+        PTRX_GHASH_REDUCE(low, high, hash);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi8(hash, reverse));
+}
+
+#undef PTRX_GHASH_REDUCE
+#undef PTRX_GHASH_MULTIPLY
+#else
+inline void AesKey::encryptBlockHardware(const unsigned char*, int, const unsigned char*, unsigned char*) {
+}
+
+inline void AesKey::ctrBlocksHardware(const unsigned char*, int, std::uint64_t&, std::uint64_t&, unsigned char*, std::size_t) {
+}
+
+inline void AesKey::ghashHardware(const unsigned char*, unsigned char*, const unsigned char*, std::size_t) {
+}
+#endif
+
+/**
+ * @brief Constructs a xoshiro256++ generator from a 64-bit seed.
+ *
+ * @param seed The seed; equal seeds give equal sequences.
+ */
+inline RandomEngine::RandomEngine(std::uint64_t seed) : state() {
+    this->seed(seed);
+}
+
+/**
+ * @brief Reseeds the generator.
+ *
+ * @details The 256-bit state is filled from four splitmix64 outputs of the seed, which spreads nearby seeds
+ * over unrelated states and can never produce the all-zero state xoshiro must avoid.
+ *
+ * @param seed The seed; equal seeds give equal sequences.
+ */
+inline void RandomEngine::seed(std::uint64_t seed) {
+    for (int i = 0; i < 4; ++i) {
+        state[i] = splitMix64(seed);
+    }
+}
+
+/**
+ * @brief Returns the next 64 random bits.
+ *
+ * @details This is xoshiro256++ by Blackman and Vigna: a few shifts, rotations and XORs per output with a
+ * period of 2^256 - 1. The engine meets the UniformRandomBitGenerator requirements, so it can be passed to
+ * the standard library algorithms and distributions.
+ *
+ * @return A uniformly distributed 64-bit value.
+ */
+inline RandomEngine::result_type RandomEngine::operator()() {
+    std::uint64_t result = rotateLeft(state[0] + state[3], 23) + state[0];
+    std::uint64_t shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+/**
+ * @brief Returns a uniformly distributed value in [0, bound).
+ *
+ * @details This is Lemire's multiply-and-shift method. The upper 32 bits of a draw are multiplied by bound and
+ * the high half of the product is the result. The rare draws whose low half falls below 2^32 mod bound are
+ * rejected, which removes the bias of plain modulo reduction; the division computing that threshold only runs
+ * when a draw is near the rejection zone.
+ *
+ * @param bound The exclusive upper limit; 0 yields 0.
+ * @return The random value.
+ */
+inline std::uint32_t RandomEngine::nextBounded(std::uint32_t bound) {
+    std::uint64_t product = ((*this)() >> 32) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < bound) {
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = ((*this)() >> 32) * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+/**
+ * @brief Returns a uniformly distributed value in the closed interval [low, high].
+ *
+ * @param low The smallest value that can be returned.
+ * @param high The largest value that can be returned; must not be less than low.
+ * @return The random value, or low if high is less than low.
+ */
+inline int RandomEngine::nextInRange(int low, int high) {
+    if (high <= low) {
+        return low;
+    }
+    std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+    std::uint32_t offset = range > 0xFFFFFFFFULL ? static_cast<std::uint32_t>((*this)() >> 32)
+        : nextBounded(static_cast<std::uint32_t>(range));
+    return static_cast<int>(static_cast<std::uint32_t>(low) + offset);
+}
+
+/**
+ * @brief Advances the generator by 2^128 outputs.
+ *
+ * @details Copies of one engine that are jumped 0, 1, 2, ... times produce non-overlapping sequences, which
+ * gives each thread of a parallel computation its own reproducible stream.
+ */
+inline void RandomEngine::jump() {
+    static const std::uint64_t polynomial[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    std::uint64_t jumped[4] = {};
+    for (int word = 0; word < 4; ++word) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (polynomial[word] >> bit & 1) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    std::memcpy(state, jumped, sizeof(state));
+}
+
+/**
+ * @brief Returns the calling thread's generator, seeded from std::random_device on first use.
+ *
+ * @details The engine is created once per thread, so callers that only need unpredictable values avoid the
+ * cost of opening the entropy source and setting up a fresh generator on every call.
+ *
+ * @return A reference to the thread's engine.
+ */
+inline RandomEngine& RandomEngine::threadLocal() {
+    static thread_local RandomEngine engine([]() {
+        std::random_device device;
+        return static_cast<std::uint64_t>(device()) << 32 ^ device();
+    }());
+    return engine;
+}
+
+/**
+ * @brief Advances a splitmix64 state and returns its next output.
+ *
+ * @param state The 64-bit state, incremented by the golden-ratio constant.
+ * @return The mixed output.
+ */
+inline std::uint64_t RandomEngine::splitMix64(std::uint64_t& state) {
+    std::uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+    value = (value ^ value >> 30) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ value >> 27) * 0x94D049BB133111EBULL;
+    return value ^ value >> 31;
+}
+
+/**
+ * @brief Rotates a 64-bit value left.
+ *
+ * @param value The value.
+ * @param shift The rotation, between 1 and 63.
+ * @return The rotated value.
+ */
+inline std::uint64_t RandomEngine::rotateLeft(std::uint64_t value, int shift) {
+    return value << shift | value >> (64 - shift);
+}
+
+/**
+ * @brief Constructs a counter-based Philox4x32-10 generator.
+ *
+ * @param seed The 64-bit key selecting the stream.
+ */
+inline PhiloxEngine::PhiloxEngine(std::uint64_t seed) {
+    key[0] = static_cast<std::uint32_t>(seed);
+    key[1] = static_cast<std::uint32_t>(seed >> 32);
+}
+
+/**
+ * @brief Computes the four words of one block of the stream.
+ *
+ * @details Philox4x32-10 of Salmon et al. encrypts the 128-bit counter under the key with ten rounds of
+ * multiply-and-XOR. The counter occupies the first two words, so block i is a pure function of the key and i
+ * and any block can be produced without computing the ones before it.
+ *
+ * @param counter The block index.
+ * @param output A pointer to 4 words receiving the block.
+ */
+inline void PhiloxEngine::generateBlock(std::uint64_t counter, std::uint32_t* output) const {
+    generateBlock(key[0], key[1], counter, output);
+}
+
+/**
+ * @brief Writes a range of words of the stream.
+ *
+ * @details Word w of the stream is word w % 4 of block w / 4, so destination receives the same values
+ * whichever way a range is split between calls or threads. Whole blocks are generated 8 at a time with AVX2
+ * or 4 at a time with SSE2, one block per SIMD lane, and the partial blocks at either end one at a time.
+ *
+ * @param firstWord The index of the first word to write.
+ * @param destination A pointer to count words receiving the values.
+ * @param count The number of words.
+ */
+inline void PhiloxEngine::fill(std::uint64_t firstWord, std::uint32_t* destination, std::size_t count) const {
+    std::uint32_t block[4];
+    std::size_t written = 0;
+    std::uint64_t counter = firstWord / 4;
+    if (firstWord % 4 != 0 && count > 0) {
+        generateBlock(counter++, block);
+        for (std::size_t word = firstWord % 4; word < 4 && written < count; ++word) {
+            destination[written++] = block[word];
+        }
+    }
+
+#ifdef PTRX_X86_DISPATCH
+    if (CpuFeatures::hasAvx2()) {
+        for (; count - written >= 32; written += 32, counter += 8) {
+            generateBlocks8(key[0], key[1], counter, destination + written);
+        }
+    }
+#endif
+#ifdef PTRX_SSE2
+    for (; count - written >= 16; written += 16, counter += 4) {
+        generateBlocks4(key[0], key[1], counter, destination + written);
+    }
+#endif
+
+    for (; written < count; ++counter) {
+        generateBlock(counter, block);
+        for (int word = 0; word < 4 && written < count; ++word) {
+            destination[written++] = block[word];
+        }
+    }
+}
+
+/**
+ * @brief Writes a range of values uniformly distributed in [0, bound).
+ *
+ * @details Word w of the stream is reduced with Lemire's multiply-and-shift method. The few words that would
+ * bias the result are replaced by candidates from a second stream whose counters are derived from w alone, so
+ * value w still depends only on the key and its position.
+ *
+ * @param firstWord The index of the first value to write.
+ * @param bound The exclusive upper limit, greater than 0.
+ * @param destination A pointer to count words receiving the values.
+ * @param count The number of values.
+ */
+inline void PhiloxEngine::fillBounded(std::uint64_t firstWord, std::uint32_t bound, std::uint32_t* destination, std::size_t count) const {
+    fill(firstWord, destination, count);
+    if (bound == 0) {
+        return;
+    }
+
+    std::uint32_t threshold = (0u - bound) % bound;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t product = static_cast<std::uint64_t>(destination[i]) * bound;
+        for (std::uint64_t attempt = 0; static_cast<std::uint32_t>(product) < threshold; ++attempt) {
+            std::uint32_t candidates[4];
+            generateBlock(~key[0], key[1], ((firstWord + i) << 6) + attempt / 4, candidates);
+            product = static_cast<std::uint64_t>(candidates[attempt % 4]) * bound;
+        }
+        destination[i] = static_cast<std::uint32_t>(product >> 32);
+    }
+}
+
+/**
+ * @brief Computes one Philox4x32-10 block with a scalar loop.
+ *
+ * @param key0 The low key word.
+ * @param key1 The high key word.
+ * @param counter The block index.
+ * @param output A pointer to 4 words receiving the block.
+ */
+inline void PhiloxEngine::generateBlock(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output) {
+    std::uint32_t x0 = static_cast<std::uint32_t>(counter);
+    std::uint32_t x1 = static_cast<std::uint32_t>(counter >> 32);
+    std::uint32_t x2 = 0;
+    std::uint32_t x3 = 0;
+    for (int round = 0; round < 10; ++round) {
+        std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53u) * x0;
+        std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * x2;
+        x0 = static_cast<std::uint32_t>(product1 >> 32) ^ x1 ^ key0;
+        x2 = static_cast<std::uint32_t>(product0 >> 32) ^ x3 ^ key1;
+        x1 = static_cast<std::uint32_t>(product1);
+        x3 = static_cast<std::uint32_t>(product0);
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+    output[0] = x0;
+    output[1] = x1;
+    output[2] = x2;
+    output[3] = x3;
+}
+
+#ifdef PTRX_SSE2
+/**
+ * @brief Computes four consecutive Philox4x32-10 blocks with SSE2.
+ *
+ * @details Lane i of each register holds one word of block counter + i. PMULUDQ multiplies the even lanes,
+ * so the odd lanes are shifted down for a second multiply and the low and high halves of the products are
+ * recombined with masks. The finished words are transposed so each block is stored contiguously.
+ *
+ * @param key0 The low key word.
+ * @param key1 The high key word.
+ * @param counter The index of the first block.
+ * @param output A pointer to 16 words receiving the blocks.
+ */
+inline void PhiloxEngine::generateBlocks4(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output) {
+    const __m128i lowMask = _mm_set1_epi64x(0xFFFFFFFFLL);
+    const __m128i multiplier0 = _mm_set1_epi32(static_cast<int>(0xD2511F53u));
+    const __m128i multiplier1 = _mm_set1_epi32(static_cast<int>(0xCD9E8D57u));
+    __m128i x0 = _mm_set_epi32(static_cast<int>(counter + 3), static_cast<int>(counter + 2), static_cast<int>(counter + 1),
+        static_cast<int>(counter));
+    __m128i x1 = _mm_set_epi32(static_cast<int>((counter + 3) >> 32), static_cast<int>((counter + 2) >> 32),
+        static_cast<int>((counter + 1) >> 32), static_cast<int>(counter >> 32));
+    __m128i x2 = _mm_setzero_si128();
+    __m128i x3 = _mm_setzero_si128();
+
+    for (int round = 0; round < 10; ++round) {
+        __m128i even0 = _mm_mul_epu32(x0, multiplier0);
+        __m128i odd0 = _mm_mul_epu32(_mm_srli_epi64(x0, 32), multiplier0);
+        __m128i even1 = _mm_mul_epu32(x2, multiplier1);
+        __m128i odd1 = _mm_mul_epu32(_mm_srli_epi64(x2, 32), multiplier1);
+        __m128i low0 = _mm_or_si128(_mm_and_si128(even0, lowMask), _mm_slli_epi64(odd0, 32));
+        __m128i high0 = _mm_or_si128(_mm_srli_epi64(even0, 32), _mm_andnot_si128(lowMask, odd0));
+        __m128i low1 = _mm_or_si128(_mm_and_si128(even1, lowMask), _mm_slli_epi64(odd1, 32));
+        __m128i high1 = _mm_or_si128(_mm_srli_epi64(even1, 32), _mm_andnot_si128(lowMask, odd1));
+        x0 = _mm_xor_si128(_mm_xor_si128(high1, x1), _mm_set1_epi32(static_cast<int>(key0)));
+        x2 = _mm_xor_si128(_mm_xor_si128(high0, x3), _mm_set1_epi32(static_cast<int>(key1)));
+        x1 = low1;
+        x3 = low0;
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+
+    __m128i words01Low = _mm_unpacklo_epi32(x0, x1);
+    __m128i words23Low = _mm_unpacklo_epi32(x2, x3);
+    __m128i words01High = _mm_unpackhi_epi32(x0, x1);
+    __m128i words23High = _mm_unpackhi_epi32(x2, x3);
+    __m128i* address = reinterpret_cast<__m128i*>(output);
+    _mm_storeu_si128(address, _mm_unpacklo_epi64(words01Low, words23Low));
+    _mm_storeu_si128(address + 1, _mm_unpackhi_epi64(words01Low, words23Low));
+    _mm_storeu_si128(address + 2, _mm_unpacklo_epi64(words01High, words23High));
+    _mm_storeu_si128(address + 3, _mm_unpackhi_epi64(words01High, words23High));
+}
+#else
+inline void PhiloxEngine::generateBlocks4(std::uint32_t, std::uint32_t, std::uint64_t, std::uint32_t*) {
+}
+#endif
+
+#ifdef PTRX_X86_DISPATCH
+/**
+ * @brief Computes eight consecutive Philox4x32-10 blocks with AVX2.
+ *
+ * @details This is the SSE2 kernel widened to eight lanes, with the product halves recombined by blends
+ * instead of masks. The unpack steps of the transpose work within each 128-bit half, so the halves of the
+ * results are regrouped with lane permutes before being stored.
+ *
+ * @param key0 The low key word.
+ * @param key1 The high key word.
+ * @param counter The index of the first block.
+ * @param output A pointer to 32 words receiving the blocks.
+ */
+PTRX_TARGET("avx2")
+inline void PhiloxEngine::generateBlocks8(std::uint32_t key0, std::uint32_t key1, std::uint64_t counter, std::uint32_t* output) {
+    const __m256i multiplier0 = _mm256_set1_epi32(static_cast<int>(0xD2511F53u));
+    const __m256i multiplier1 = _mm256_set1_epi32(static_cast<int>(0xCD9E8D57u));
+    int counterLow[8];
+    int counterHigh[8];
+    for (int lane = 0; lane < 8; ++lane) {
+        counterLow[lane] = static_cast<int>(counter + lane);
+        counterHigh[lane] = static_cast<int>((counter + lane) >> 32);
+    }
+    __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterLow));
+    __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterHigh));
+    __m256i x2 = _mm256_setzero_si256();
+    __m256i x3 = _mm256_setzero_si256();
+
+    for (int round = 0; round < 10; ++round) {
+        __m256i even0 = _mm256_mul_epu32(x0, multiplier0);
+        __m256i odd0 = _mm256_mul_epu32(_mm256_srli_epi64(x0, 32), multiplier0);
+        __m256i even1 = _mm256_mul_epu32(x2, multiplier1);
+        __m256i odd1 = _mm256_mul_epu32(_mm256_srli_epi64(x2, 32), multiplier1);
+        __m256i low0 = _mm256_blend_epi32(even0, _mm256_slli_epi64(odd0, 32), 0xAA);
+        __m256i high0 = _mm256_blend_epi32(_mm256_srli_epi64(even0, 32), odd0, 0xAA);
+        __m256i low1 = _mm256_blend_epi32(even1, _mm256_slli_epi64(odd1, 32), 0xAA);
+        __m256i high1 = _mm256_blend_epi32(_mm256_srli_epi64(even1, 32), odd1, 0xAA);
+        x0 = _mm256_xor_si256(_mm256_xor_si256(high1, x1), _mm256_set1_epi32(static_cast<int>(key0)));
+        x2 = _mm256_xor_si256(_mm256_xor_si256(high0, x3), _mm256_set1_epi32(static_cast<int>(key1)));
+        x1 = low1;
+        x3 = low0;
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+
+    __m256i words01Low = _mm256_unpacklo_epi32(x0, x1);
+    __m256i words23Low = _mm256_unpacklo_epi32(x2, x3);
+    __m256i words01High = _mm256_unpackhi_epi32(x0, x1);
+    __m256i words23High = _mm256_unpackhi_epi32(x2, x3);
+    __m256i blocks04 = _mm256_unpacklo_epi64(words01Low, words23Low);
+    __m256i blocks15 = _mm256_unpackhi_epi64(words01Low, words23Low);
+    __m256i blocks26 = _mm256_unpacklo_epi64(words01High, words23High);
+    __m256i blocks37 = _mm256_unpackhi_epi64(words01High, words23High);
+    __m256i* address = reinterpret_cast<__m256i*>(output);
+    _mm256_storeu_si256(address, _mm256_permute2x128_si256(blocks04, blocks15, 0x20));
+    _mm256_storeu_si256(address + 1, _mm256_permute2x128_si256(blocks26, blocks37, 0x20));
+    _mm256_storeu_si256(address + 2, _mm256_permute2x128_si256(blocks04, blocks15, 0x31));
+    _mm256_storeu_si256(address + 3, _mm256_permute2x128_si256(blocks26, blocks37, 0x31));
+}
+#else
+inline void PhiloxEngine::generateBlocks8(std::uint32_t, std::uint32_t, std::uint64_t, std::uint32_t*) {
+}
+#endif
+
 #endif // PTRX_IMPL_H
\ No newline at end of file
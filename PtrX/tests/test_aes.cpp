@@ -0,0 +1,171 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Known answers from FIPS-197 appendix C.1 (AES-128) and C.3 (AES-256).
+static void checkFips197Vectors() {
+    std::vector<unsigned char> plaintext = fromHex("00112233445566778899aabbccddeeff");
+    unsigned char output[16];
+
+    std::vector<unsigned char> key128 = fromHex("000102030405060708090a0b0c0d0e0f");
+    AesKey aes128(key128.data(), 16);
+    PTRX_CHECK(aes128.isValid() && aes128.getKeySize() == 16);
+    aes128.encryptBlock(plaintext.data(), output);
+    PTRX_CHECK(std::vector<unsigned char>(output, output + 16) == fromHex("69c4e0d86a7b0430d8cdb78070b4c55a"));
+
+    std::vector<unsigned char> key256 = fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    AesKey aes256(key256.data(), 32);
+    PTRX_CHECK(aes256.isValid() && aes256.getKeySize() == 32);
+    aes256.encryptBlock(plaintext.data(), output);
+    PTRX_CHECK(std::vector<unsigned char>(output, output + 16) == fromHex("8ea2b7ca516745bfeafc49904b496089"));
+
+    AesKey invalid(key128.data(), 24);
+    PTRX_CHECK(!invalid.isValid());
+}
+
+struct GcmVector {
+    const char* key;
+    const char* nonce;
+    const char* plaintext;
+    const char* aad;
+    const char* ciphertext;
+    const char* tag;
+};
+
+// Test cases 1-4 and 13-15 of the GCM specification by McGrew and Viega.
+static void checkGcmVectors() {
+    const std::string plaintext64 =
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255";
+    const std::string plaintext60 = plaintext64.substr(0, 120);
+    const GcmVector vectors[] = {
+        { "00000000000000000000000000000000", "000000000000000000000000", "", "", "", "58e2fccefa7e3061367f1d57a4e7455a" },
+        { "00000000000000000000000000000000", "000000000000000000000000", "00000000000000000000000000000000", "",
+            "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf" },
+        { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", plaintext64.c_str(), "",
+            "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+            "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+            "4d5c2af327cd64a62cf35abd2ba6fab4" },
+        { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", plaintext60.c_str(),
+            "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+            "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+            "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+            "5bc94fbc3221a5db94fae95ae7121a47" },
+        { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "", "", "",
+            "530f8afbc74536b9a963b4f1c4cb738b" },
+        { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000",
+            "00000000000000000000000000000000", "", "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919" },
+        { "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+            plaintext64.c_str(), "",
+            "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+            "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+            "b094dac5d93471bdec1a502270e3cc6c" },
+    };
+
+    for (std::size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); ++v) {
+        std::vector<unsigned char> key = fromHex(vectors[v].key);
+        std::vector<unsigned char> nonce = fromHex(vectors[v].nonce);
+        std::vector<unsigned char> plaintext = fromHex(vectors[v].plaintext);
+        std::vector<unsigned char> aad = fromHex(vectors[v].aad);
+        AesKey aes(key.data(), static_cast<int>(key.size()));
+
+        std::vector<unsigned char> data = plaintext;
+        unsigned char tag[16];
+        PTRX_CHECK(aes.gcmEncrypt(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), tag));
+        PTRX_CHECK(data == fromHex(vectors[v].ciphertext));
+        PTRX_CHECK(std::vector<unsigned char>(tag, tag + 16) == fromHex(vectors[v].tag));
+        PTRX_CHECK(aes.gcmDecrypt(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), tag));
+        PTRX_CHECK(data == plaintext);
+    }
+}
+
+// CTR mode must match encrypting the incrementing counter block by block, including the carry across bytes.
+static void checkCtrAgainstBlocks() {
+    unsigned char key[32];
+    for (int i = 0; i < 32; ++i) {
+        key[i] = static_cast<unsigned char>(i * 7 + 1);
+    }
+    AesKey aes(key, 32);
+    unsigned char counterBlock[16];
+    std::memset(counterBlock, 0xff, 16);
+    counterBlock[0] = 3;
+
+    std::vector<unsigned char> data(1013);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 31);
+    }
+    std::vector<unsigned char> expected = data;
+    PTRX_CHECK(aes.ctrXor(counterBlock, 0, data.data(), data.size()));
+
+    unsigned char counter[16], keystream[16];
+    std::memcpy(counter, counterBlock, 16);
+    for (std::size_t offset = 0; offset < expected.size(); offset += 16) {
+        aes.encryptBlock(counter, keystream);
+        for (std::size_t i = 0; i < 16 && offset + i < expected.size(); ++i) {
+            expected[offset + i] ^= keystream[i];
+        }
+        for (int j = 15; j >= 0; --j) {
+            if (++counter[j] != 0) {
+                break;
+            }
+        }
+    }
+    PTRX_CHECK(data == expected);
+}
+
+template <typename T>
+static void checkMemoryRoundTrip() {
+    MemoryManager<T> manager(false);
+    const int size = 300001;
+    std::vector<T> original(size);
+    for (int i = 0; i < size; ++i) {
+        original[i] = static_cast<T>(i * 3);
+    }
+
+    const unsigned char keyBytes[16] = { 1, 2, 3 };
+    AesKey key(keyBytes, 16);
+    const unsigned char counterBlock[16] = { 9 };
+
+    std::vector<T> sequential = original;
+    std::vector<T> parallel = original;
+    PTRX_CHECK(manager.encryptMemory(sequential.data(), size, key, counterBlock));
+    PTRX_CHECK(manager.encryptMemory(parallel.data(), size, key, counterBlock, ExecutionPolicy::parallel(4)));
+    PTRX_CHECK(sequential == parallel && sequential != original);
+    PTRX_CHECK(manager.decryptMemory(sequential.data(), size, key, counterBlock));
+    PTRX_CHECK(sequential == original);
+
+    const unsigned char nonce[12] = { 5 };
+    const unsigned char aad[] = "hdr";
+    unsigned char tag[16];
+    std::vector<T> data = original;
+    PTRX_CHECK(manager.encryptMemoryAuthenticated(data.data(), size, key, nonce, aad, 3, tag));
+
+    // Tampering with the data, the tag or the associated data is detected and leaves the buffer untouched.
+    reinterpret_cast<unsigned char*>(data.data())[77] ^= 1;
+    std::vector<T> tampered = data;
+    PTRX_CHECK(!manager.decryptMemoryAuthenticated(data.data(), size, key, nonce, aad, 3, tag));
+    PTRX_CHECK(data == tampered);
+    reinterpret_cast<unsigned char*>(data.data())[77] ^= 1;
+    tag[0] ^= 1;
+    PTRX_CHECK(!manager.decryptMemoryAuthenticated(data.data(), size, key, nonce, aad, 3, tag));
+    tag[0] ^= 1;
+    PTRX_CHECK(!manager.decryptMemoryAuthenticated(data.data(), size, key, nonce, aad, 2, tag));
+    PTRX_CHECK(manager.decryptMemoryAuthenticated(data.data(), size, key, nonce, aad, 3, tag));
+    PTRX_CHECK(data == original);
+
+    AesKey unset;
+    PTRX_CHECK(!manager.encryptMemory(data.data(), size, unset, counterBlock));
+}
+
+int main() {
+    checkFips197Vectors();
+    checkGcmVectors();
+    checkCtrAgainstBlocks();
+    checkMemoryRoundTrip<int>();
+    checkMemoryRoundTrip<long long>();
+
+    return PTRX_TEST_RESULT();
+}
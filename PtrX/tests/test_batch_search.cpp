@@ -0,0 +1,85 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+template <typename T>
+static std::vector<T> makeSorted(std::mt19937& generator, int size, int spread) {
+    std::vector<T> values(size);
+    for (int i = 0; i < size; ++i) {
+        values[i] = static_cast<T>(static_cast<int>(generator() % static_cast<unsigned int>(spread)) - spread / 4);
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// Batched lookups answer exactly like one call per key, for sorted and unsorted key orders.
+template <typename T>
+static void checkBatchSearch() {
+    MemoryManager<T> manager(false);
+    std::mt19937 generator(4);
+    int sizes[] = { 1, 2, 17, 1000, 5000 };
+    int keyCounts[] = { 0, 1, 15, 16, 17, 100, 3000 };
+    for (int size : sizes) {
+        for (int keyCount : keyCounts) {
+            std::vector<T> block = makeSorted<T>(generator, size, size * 2 + 1);
+            std::vector<int> keys(keyCount), results(keyCount);
+            for (int i = 0; i < keyCount; ++i) {
+                keys[i] = static_cast<int>(generator() % static_cast<unsigned int>(size * 3 + 3)) - size;
+            }
+
+            for (int pass = 0; pass < 2; ++pass) {
+                if (pass == 1) {
+                    std::sort(keys.begin(), keys.end());
+                }
+                PTRX_CHECK(manager.batchBinarySearch(block.data(), size, keys.data(), keyCount, results.data()));
+                bool agrees = true;
+                for (int i = 0; i < keyCount; ++i) {
+                    agrees = agrees && results[i] == manager.binarySearch(block.data(), size, keys[i]);
+                }
+                PTRX_CHECK(agrees);
+            }
+
+            std::vector<T> unsorted = block;
+            std::shuffle(unsorted.begin(), unsorted.end(), generator);
+            int found = manager.batchFindValue(unsorted.data(), size, keys.data(), keyCount, results.data());
+            int expectedFound = 0;
+            bool agrees = true;
+            for (int i = 0; i < keyCount; ++i) {
+                typename std::vector<T>::iterator match = std::find(unsorted.begin(), unsorted.end(), static_cast<T>(keys[i]));
+                int expected = match == unsorted.end() ? -1 : static_cast<int>(match - unsorted.begin());
+                agrees = agrees && results[i] == expected;
+                expectedFound += expected >= 0;
+            }
+            PTRX_CHECK(agrees && found == expectedFound);
+        }
+    }
+}
+
+// Keys ascending as ints are not ascending once converted to an unsigned T, so they must not take the
+// galloping scan.
+static void checkUnsignedNegativeKeys() {
+    MemoryManager<unsigned int> manager(false);
+    std::vector<unsigned int> block;
+    for (unsigned int i = 0; i < 100; ++i) {
+        block.push_back(i);
+    }
+    block.push_back(0xFFFFFFFEu);
+    block.push_back(0xFFFFFFFFu);
+
+    const int keys[] = { -2, -1, 0, 1, 50, 99, 100 };
+    const int expected[] = { 100, 101, 0, 1, 50, 99, -1 };
+    int results[7];
+    PTRX_CHECK(manager.batchBinarySearch(block.data(), static_cast<int>(block.size()), keys, 7, results));
+    PTRX_CHECK(std::equal(results, results + 7, expected));
+}
+
+int main() {
+    checkBatchSearch<int>();
+    checkBatchSearch<long long>();
+    checkBatchSearch<unsigned int>();
+    checkUnsignedNegativeKeys();
+    return PTRX_TEST_RESULT();
+}
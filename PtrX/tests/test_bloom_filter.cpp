@@ -0,0 +1,67 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <vector>
+
+template <typename T>
+static void checkFilter() {
+    const int size = 20000;
+    std::vector<T> values(size);
+    for (int i = 0; i < size; ++i) {
+        values[i] = static_cast<T>(i * 3);
+    }
+
+    BloomFilter<T> filter(values.data(), size, 0.01);
+    PTRX_CHECK(filter.sizeInBytes() > 0 && filter.getHashCount() > 1);
+
+    bool noFalseNegatives = true;
+    for (int i = 0; i < size; ++i) {
+        noFalseNegatives = noFalseNegatives && filter.mayContain(values[i]);
+    }
+    PTRX_CHECK(noFalseNegatives);
+
+    int falsePositives = 0;
+    for (int i = 0; i < size; ++i) {
+        falsePositives += filter.mayContain(static_cast<T>(i * 3 + 1)) ? 1 : 0;
+    }
+    PTRX_CHECK(falsePositives < size / 40);
+
+    filter.clear();
+    PTRX_CHECK(!filter.mayContain(values[0]));
+    PTRX_CHECK(!filter.reset(0));
+    PTRX_CHECK(filter.mayContain(values[0]));
+}
+
+template <typename T>
+static void checkFilteredOperations() {
+    MemoryManager<T> manager(false);
+    std::vector<T> block(1000);
+    for (int i = 0; i < 1000; ++i) {
+        block[i] = static_cast<T>(i);
+    }
+
+    BloomFilter<T> filter(block.data(), 1000);
+    PTRX_CHECK(manager.findValue(block.data(), 500, 1000, filter) == &block[500]);
+    PTRX_CHECK(manager.findValue(block.data(), 5000, 1000, filter) == nullptr);
+
+    PTRX_CHECK(manager.writeValue(&block[10], 5000, 1, filter));
+    PTRX_CHECK(manager.findValue(block.data(), 5000, 1000, filter) == &block[10]);
+
+    manager.replaceValue(block.data(), 1000, 20, 6000, filter);
+    PTRX_CHECK(manager.findValue(block.data(), 6000, 1000, filter) == &block[20]);
+
+    // A filter that was never sized has no bits to rule anything out, so every lookup scans the block.
+    BloomFilter<T> unsized;
+    PTRX_CHECK(manager.findValue(block.data(), 500, 1000, unsized) == &block[500]);
+    PTRX_CHECK(manager.writeValue(&block[30], 7000, 1, unsized));
+    PTRX_CHECK(manager.findValue(block.data(), 7000, 1000, unsized) == &block[30]);
+    PTRX_CHECK(manager.findValue(block.data(), 8000, 1000, unsized) == nullptr);
+}
+
+int main() {
+    checkFilter<int>();
+    checkFilter<long long>();
+    checkFilteredOperations<int>();
+    checkFilteredOperations<long long>();
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Known answers from RFC 8439, sections 2.3.2 and 2.4.2, plus the all-zero key block of appendix A.1.
+static void checkRfc8439Vectors() {
+    unsigned char key[32];
+    for (int i = 0; i < 32; ++i) {
+        key[i] = static_cast<unsigned char>(i);
+    }
+
+    const unsigned char blockNonce[12] = { 0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0 };
+    unsigned char block[64];
+    ChaCha20::keystreamBlock(key, blockNonce, 1, block);
+    std::vector<unsigned char> expected = fromHex(
+        "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+        "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+    PTRX_CHECK(std::memcmp(block, expected.data(), 64) == 0);
+
+    const unsigned char zeroKey[32] = {};
+    const unsigned char zeroNonce[12] = {};
+    ChaCha20::keystreamBlock(zeroKey, zeroNonce, 0, block);
+    expected = fromHex(
+        "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+        "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586");
+    PTRX_CHECK(std::memcmp(block, expected.data(), 64) == 0);
+
+    const char* plaintext = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, "
+        "sunscreen would be it.";
+    const unsigned char nonce[12] = { 0, 0, 0, 0, 0, 0, 0, 0x4a, 0, 0, 0, 0 };
+    std::vector<unsigned char> data(plaintext, plaintext + std::strlen(plaintext));
+    PTRX_CHECK(ChaCha20::xorKeystream(key, nonce, 1, data.data(), data.size()));
+    expected = fromHex(
+        "6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b"
+        "f91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f530c359f0861d8"
+        "07ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+        "5af90bbf74a35be6b40b8eedf2785e42874d");
+    PTRX_CHECK(data == expected);
+
+    // The counter must not wrap past 2^32 - 1.
+    unsigned char buffer[128] = {};
+    PTRX_CHECK(!ChaCha20::xorKeystream(key, nonce, 0xFFFFFFFFu, buffer, 128));
+    PTRX_CHECK(ChaCha20::xorKeystream(key, nonce, 0xFFFFFFFFu, buffer, 64));
+}
+
+// The SIMD multi-block kernels must produce the same keystream as the one-block reference at any length.
+static void checkKernelsAgainstReference() {
+    unsigned char key[32], nonce[12];
+    for (int i = 0; i < 32; ++i) {
+        key[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    for (int i = 0; i < 12; ++i) {
+        nonce[i] = static_cast<unsigned char>(i * 11 + 5);
+    }
+
+    for (std::size_t length = 0; length < 2200; length += 37) {
+        std::vector<unsigned char> data(length, 0);
+        PTRX_CHECK(ChaCha20::xorKeystream(key, nonce, 3, data.data(), length));
+        bool same = true;
+        unsigned char block[64];
+        for (std::size_t offset = 0; offset < length; offset += 64) {
+            ChaCha20::keystreamBlock(key, nonce, 3 + static_cast<std::uint32_t>(offset / 64), block);
+            for (std::size_t i = 0; i < 64 && offset + i < length; ++i) {
+                same = same && data[offset + i] == block[i];
+            }
+        }
+        PTRX_CHECK(same);
+    }
+}
+
+template <typename T>
+static void checkMemoryManagerRoundTrip() {
+    MemoryManager<T> manager(false);
+    const int size = 100000;
+    std::vector<T> original(size);
+    for (int i = 0; i < size; ++i) {
+        original[i] = static_cast<T>(i * 2654435761u);
+    }
+    std::vector<T> data = original, parallelData = original;
+
+    unsigned char key[32] = { 1, 2, 3 };
+    unsigned char nonce[12] = { 9 };
+    PTRX_CHECK(manager.encryptMemory(data.data(), size, key, nonce, 7));
+    PTRX_CHECK(data != original);
+    PTRX_CHECK(manager.encryptMemory(parallelData.data(), size, key, nonce, 7, ExecutionPolicy::parallel(4)));
+    PTRX_CHECK(parallelData == data);
+    PTRX_CHECK(manager.decryptMemory(data.data(), size, key, nonce, 7));
+    PTRX_CHECK(data == original);
+
+    std::string stringKey(32, 'k');
+    std::string firstNonce(12, 'a'), secondNonce(12, 'b');
+    std::vector<T> other = original;
+    PTRX_CHECK(manager.encryptMemory(data.data(), size, stringKey, firstNonce));
+    PTRX_CHECK(manager.encryptMemory(other.data(), size, stringKey, secondNonce));
+    PTRX_CHECK(data != original && other != data);
+    PTRX_CHECK(manager.decryptMemory(data.data(), size, stringKey, firstNonce));
+    PTRX_CHECK(data == original);
+
+    // A key or nonce of the wrong length is rejected and leaves the block untouched.
+    PTRX_CHECK(!manager.encryptMemory(data.data(), size, std::string("short"), firstNonce));
+    PTRX_CHECK(!manager.encryptMemory(data.data(), size, stringKey, std::string(8, 'n')));
+    PTRX_CHECK(!manager.decryptMemory(data.data(), size, std::string(31, 'k'), firstNonce));
+    PTRX_CHECK(data == original);
+}
+
+int main() {
+    checkRfc8439Vectors();
+    checkKernelsAgainstReference();
+    checkMemoryManagerRoundTrip<int>();
+    checkMemoryManagerRoundTrip<long long>();
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,76 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static bool isMultipleOfThree(long long value) {
+    return value % 3 == 0;
+}
+
+// removeValue, removeAllOccurrences, removeIf and uniqueMemory keep the survivors in order, like
+// std::remove and std::unique, and report the new size through both the return value and size.
+template <typename T>
+static void checkCompaction() {
+    MemoryManager<T> manager(false);
+    std::mt19937 random(7);
+    const int sizes[] = { 1, 2, 7, 8, 9, 16, 17, 33, 100, 1000, 4097, 100003 };
+    const int ranges[] = { 1, 2, 3, 10, 1000000 };
+
+    for (int s = 0; s < 12; ++s) {
+        for (int r = 0; r < 5; ++r) {
+            int size = sizes[s];
+            std::vector<T> source(size);
+            for (int i = 0; i < size; ++i) {
+                source[i] = static_cast<T>(random() % ranges[r]);
+            }
+
+            std::vector<T> expected = source;
+            expected.erase(std::remove(expected.begin(), expected.end(), static_cast<T>(1)), expected.end());
+            std::vector<T> data = source;
+            int newSize = size;
+            int result = manager.removeValue(data.data(), newSize, 1);
+            PTRX_CHECK(result == static_cast<int>(expected.size()) && newSize == result);
+            PTRX_CHECK(std::equal(expected.begin(), expected.end(), data.begin()));
+
+            data = source;
+            newSize = size;
+            result = manager.removeAllOccurrences(data.data(), newSize, 1);
+            PTRX_CHECK(result == static_cast<int>(expected.size()) && newSize == result);
+            PTRX_CHECK(std::equal(expected.begin(), expected.end(), data.begin()));
+
+            expected = source;
+            expected.erase(std::remove_if(expected.begin(), expected.end(), isMultipleOfThree), expected.end());
+            data = source;
+            newSize = size;
+            result = manager.removeIf(data.data(), newSize, isMultipleOfThree);
+            PTRX_CHECK(result == static_cast<int>(expected.size()) && newSize == result);
+            PTRX_CHECK(std::equal(expected.begin(), expected.end(), data.begin()));
+
+            for (int sorted = 0; sorted < 2; ++sorted) {
+                std::vector<T> input = source;
+                if (sorted) {
+                    std::sort(input.begin(), input.end());
+                }
+                expected = input;
+                expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+                newSize = size;
+                result = manager.uniqueMemory(input.data(), newSize);
+                PTRX_CHECK(result == static_cast<int>(expected.size()) && newSize == result);
+                PTRX_CHECK(std::equal(expected.begin(), expected.end(), input.begin()));
+            }
+        }
+    }
+
+    int size = 0;
+    PTRX_CHECK(manager.uniqueMemory(nullptr, size) == 0);
+}
+
+int main() {
+    checkCompaction<int>();
+    checkCompaction<unsigned int>();
+    checkCompaction<long long>();
+
+    return PTRX_TEST_RESULT();
+}
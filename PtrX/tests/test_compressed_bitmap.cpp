@@ -0,0 +1,121 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+// Each shape drives a different container type: sparse values stay arrays, dense ranges become bitmaps and
+// long consecutive stretches become runs. The last shape adds the extremes of the int range.
+static std::vector<int> makeSet(std::mt19937& generator, int shape) {
+    std::set<int> values;
+    if (shape == 0) {
+        for (int i = 0; i < 3000; ++i) {
+            values.insert(static_cast<int>(generator()));
+        }
+    }
+    else if (shape == 1) {
+        for (int i = 0; i < 200000; ++i) {
+            values.insert(static_cast<int>(generator() % 300000) - 100000);
+        }
+    }
+    else if (shape == 2) {
+        for (int run = 0; run < 50; ++run) {
+            int start = static_cast<int>(generator() % 1000000) - 500000;
+            int length = static_cast<int>(generator() % 20000);
+            for (int i = 0; i < length; ++i) {
+                values.insert(start + i);
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < 5000; ++i) {
+            values.insert(static_cast<int>(generator() % 65536));
+        }
+        values.insert(INT_MIN);
+        values.insert(INT_MAX);
+        values.insert(-1);
+    }
+    return std::vector<int>(values.begin(), values.end());
+}
+
+static bool holds(const CompressedBitmap& bitmap, const std::vector<int>& expected) {
+    std::vector<int> values(bitmap.cardinality());
+    int count = bitmap.toSortedMemory(values.data());
+    return count == static_cast<int>(expected.size()) && values == expected;
+}
+
+static void checkOperations() {
+    std::mt19937 generator(5);
+    for (int leftShape = 0; leftShape < 4; ++leftShape) {
+        for (int rightShape = 0; rightShape < 4; ++rightShape) {
+            std::vector<int> left = makeSet(generator, leftShape);
+            std::vector<int> right = makeSet(generator, rightShape);
+            CompressedBitmap leftBitmap = CompressedBitmap::fromSortedMemory(left.data(), static_cast<int>(left.size()));
+            CompressedBitmap rightBitmap = CompressedBitmap::fromSortedMemory(right.data(), static_cast<int>(right.size()));
+            PTRX_CHECK(holds(leftBitmap, left));
+
+            std::vector<int> expected;
+            std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+            PTRX_CHECK(holds(leftBitmap.unionWith(rightBitmap), expected));
+
+            expected.clear();
+            std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+            PTRX_CHECK(holds(leftBitmap.intersectWith(rightBitmap), expected));
+            PTRX_CHECK(holds(rightBitmap.intersectWith(leftBitmap), expected));
+
+            expected.clear();
+            std::set_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+            PTRX_CHECK(holds(leftBitmap.differenceWith(rightBitmap), expected));
+
+            expected.clear();
+            std::set_symmetric_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+            PTRX_CHECK(holds(leftBitmap.xorWith(rightBitmap), expected));
+
+            bool lookups = true;
+            for (int query = 0; query < 1000; ++query) {
+                int value = left[generator() % left.size()] + static_cast<int>(generator() % 3) - 1;
+                lookups = lookups && leftBitmap.contains(value) == std::binary_search(left.begin(), left.end(), value);
+            }
+            PTRX_CHECK(lookups);
+        }
+    }
+}
+
+static void checkIncrementalAdd() {
+    std::mt19937 generator(7);
+    CompressedBitmap bitmap;
+    std::set<int> expected;
+    for (int i = 0; i < 30000; ++i) {
+        int value = i % 3 ? 1000 + i % 5000 : static_cast<int>(generator() % 100000);
+        bitmap.add(value);
+        expected.insert(value);
+    }
+    PTRX_CHECK(holds(bitmap, std::vector<int>(expected.begin(), expected.end())));
+    PTRX_CHECK(!bitmap.contains(-5));
+}
+
+// A long run compresses to a few bytes, far below the four bytes per value of a plain block.
+static void checkCompression() {
+    std::vector<int> run(100000);
+    for (int i = 0; i < 100000; ++i) {
+        run[i] = i + 12345;
+    }
+    CompressedBitmap bitmap = CompressedBitmap::fromSortedMemory(run.data(), 100000);
+    PTRX_CHECK(bitmap.cardinality() == 100000);
+    PTRX_CHECK(bitmap.sizeInBytes() < 1000);
+
+    CompressedBitmap empty;
+    PTRX_CHECK(empty.cardinality() == 0 && !empty.contains(0));
+    PTRX_CHECK(holds(empty.unionWith(bitmap), run));
+}
+
+int main() {
+    checkOperations();
+    checkIncrementalAdd();
+    checkCompression();
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,214 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template <typename T>
+static void checkRoundTrip(MemoryManager<T>& manager, const std::vector<T>& source, CompressionFormat format) {
+    int size = static_cast<int>(source.size());
+    int compressedSize = 0;
+    T* compressed = manager.compressMemory(source.data(), size, compressedSize, format);
+    PTRX_CHECK(compressed != nullptr && compressedSize > 0);
+    if (compressed == nullptr) {
+        return;
+    }
+
+    // Every block starts with the "PXC" header recording the format and the element size.
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(compressed);
+    PTRX_CHECK(header[0] == 'P' && header[1] == 'X' && header[2] == 'C');
+    PTRX_CHECK(header[4] == static_cast<unsigned char>(format) && header[5] == sizeof(T));
+
+    T* decompressed = manager.decompressMemory(compressed, compressedSize, size);
+    PTRX_CHECK(decompressed != nullptr && std::equal(source.begin(), source.end(), decompressed));
+    manager.deallocateMemory(decompressed);
+
+    PTRX_CHECK(manager.decompressMemory(compressed, compressedSize, size + 1) == nullptr);
+    manager.deallocateMemory(compressed);
+}
+
+template <typename T>
+static void checkFormats(MemoryManager<T>& manager, const std::vector<T>& source) {
+    checkRoundTrip(manager, source, CompressionFormat::RunLength);
+    checkRoundTrip(manager, source, CompressionFormat::DeltaBitPacked);
+    checkRoundTrip(manager, source, CompressionFormat::Lz);
+}
+
+template <typename T>
+static void checkCompression() {
+    MemoryManager<T> manager(false);
+
+    std::vector<T> runs;
+    for (int i = 0; i < 5000; ++i) {
+        runs.push_back(static_cast<T>(i / 100));
+    }
+    checkFormats(manager, runs);
+
+    std::vector<T> noisy;
+    for (int i = 0; i < 5000; ++i) {
+        noisy.push_back(static_cast<T>((i * 2654435761u) % 100003));
+    }
+    checkFormats(manager, noisy);
+
+    std::vector<T> single(1, static_cast<T>(-7));
+    checkFormats(manager, single);
+}
+
+// The compressed-domain queries must answer exactly what a scan of the decompressed values would.
+template <typename T>
+static void checkCompressedQueries() {
+    MemoryManager<T> manager(false);
+    std::mt19937 random(11);
+    const CompressionFormat formats[] = { CompressionFormat::RunLength, CompressionFormat::DeltaBitPacked, CompressionFormat::Lz };
+
+    for (int trial = 0; trial < 30; ++trial) {
+        int size = 1 + static_cast<int>(random() % 5000);
+        int kind = trial % 3;
+        std::vector<T> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = static_cast<T>(kind == 0 ? static_cast<int>(random() % 5) : kind == 1 ? i / 7 * 3 - 1000 : static_cast<int>(random()));
+        }
+        if (trial % 2) {
+            std::reverse(values.begin(), values.end());
+        }
+
+        for (int f = 0; f < 3; ++f) {
+            int compressedSize = 0;
+            T* compressed = manager.compressMemory(values.data(), size, compressedSize, formats[f]);
+            PTRX_CHECK(compressed != nullptr);
+            if (compressed == nullptr) {
+                continue;
+            }
+
+            for (int q = 0; q < 10; ++q) {
+                int value = q < 5 ? static_cast<int>(values[random() % size]) : static_cast<int>(random() % 7) - 3;
+                int first = static_cast<int>(std::find(values.begin(), values.end(), static_cast<T>(value)) - values.begin());
+                PTRX_CHECK(manager.findValueCompressed(compressed, compressedSize, value) == (first == size ? -1 : first));
+                PTRX_CHECK(manager.countValueCompressed(compressed, compressedSize, value)
+                    == static_cast<int>(std::count(values.begin(), values.end(), static_cast<T>(value))));
+
+                int low = static_cast<int>(values[random() % size]);
+                int high = static_cast<int>(values[random() % size]);
+                if (low > high) {
+                    std::swap(low, high);
+                }
+                std::vector<int> expected;
+                for (int i = 0; i < size; ++i) {
+                    if (values[i] >= low && values[i] <= high) {
+                        expected.push_back(i);
+                    }
+                }
+                std::vector<int> positions(size);
+                int matches = manager.filterRangeCompressed(compressed, compressedSize, low, high, positions.data());
+                PTRX_CHECK(matches == static_cast<int>(expected.size()));
+                PTRX_CHECK(std::equal(expected.begin(), expected.end(), positions.begin()));
+                PTRX_CHECK(manager.filterRangeCompressed(compressed, compressedSize, low, high, nullptr) == matches);
+            }
+
+            long long sum = 0, expectedSum = 0;
+            for (int i = 0; i < size; ++i) {
+                expectedSum += static_cast<long long>(values[i]);
+            }
+            PTRX_CHECK(manager.sumCompressed(compressed, compressedSize, sum) && sum == expectedSum);
+            T minimum = 0, maximum = 0;
+            PTRX_CHECK(manager.minMaxCompressed(compressed, compressedSize, minimum, maximum));
+            PTRX_CHECK(minimum == *std::min_element(values.begin(), values.end()));
+            PTRX_CHECK(maximum == *std::max_element(values.begin(), values.end()));
+            manager.deallocateMemory(compressed);
+        }
+    }
+
+    PTRX_CHECK(manager.findValueCompressed(nullptr, 3, 1) == -1);
+    PTRX_CHECK(manager.countValueCompressed(nullptr, 0, 1) == -1);
+}
+
+// Sums that do not fit in a long long are reported as failures instead of wrapping.
+static void checkSumOverflow() {
+    MemoryManager<long long> manager(false);
+    const CompressionFormat formats[] = { CompressionFormat::RunLength, CompressionFormat::DeltaBitPacked, CompressionFormat::Lz };
+    const long long large = std::numeric_limits<long long>::max() / 4;
+    std::vector<long long> run(10, large), mixed(10, -large);
+    mixed[3] = large;
+
+    for (int f = 0; f < 3; ++f) {
+        for (int shape = 0; shape < 2; ++shape) {
+            const std::vector<long long>& values = shape == 0 ? run : mixed;
+            int compressedSize = 0;
+            long long* compressed = manager.compressMemory(values.data(), 10, compressedSize, formats[f]);
+            PTRX_CHECK(compressed != nullptr);
+            if (compressed == nullptr) {
+                continue;
+            }
+            long long sum = 0;
+            PTRX_CHECK(!manager.sumCompressed(compressed, compressedSize, sum));
+            manager.deallocateMemory(compressed);
+
+            compressed = manager.compressMemory(values.data(), 3, compressedSize, formats[f]);
+            PTRX_CHECK(compressed != nullptr && manager.sumCompressed(compressed, compressedSize, sum)
+                && sum == (shape == 0 ? 3 * large : -3 * large));
+            manager.deallocateMemory(compressed);
+        }
+    }
+
+    MemoryManager<unsigned long long> unsignedManager(false);
+    std::vector<unsigned long long> huge(4, 1ULL << 63);
+    int compressedSize = 0;
+    unsigned long long* compressed = unsignedManager.compressMemory(huge.data(), 4, compressedSize, CompressionFormat::RunLength);
+    long long sum = 0;
+    PTRX_CHECK(compressed != nullptr && !unsignedManager.sumCompressed(compressed, compressedSize, sum));
+    unsignedManager.deallocateMemory(compressed);
+}
+
+// An Lz header claiming more elements than its payload can decode to is rejected before anything is allocated.
+static void checkCorruptLzHeader() {
+    MemoryManager<int> manager(false);
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) {
+        values[i] = i % 10;
+    }
+    int compressedSize = 0;
+    int* compressed = manager.compressMemory(values.data(), 1000, compressedSize, CompressionFormat::Lz);
+    PTRX_CHECK(compressed != nullptr);
+    if (compressed == nullptr) {
+        return;
+    }
+
+    unsigned char* header = reinterpret_cast<unsigned char*>(compressed);
+    const std::uint32_t counts[] = { 0xFFFFFFF0u, 0x40000000u, 1001 };
+    for (std::uint32_t count : counts) {
+        for (int i = 0; i < 4; ++i) {
+            header[6 + i] = static_cast<unsigned char>(count >> (8 * i));
+        }
+        long long sum = 0;
+        PTRX_CHECK(!manager.sumCompressed(compressed, compressedSize, sum));
+        PTRX_CHECK(manager.findValueCompressed(compressed, compressedSize, 3) == -1);
+        PTRX_CHECK(manager.countValueCompressed(compressed, compressedSize, 3) == -1);
+    }
+    manager.deallocateMemory(compressed);
+}
+
+int main() {
+    checkCompression<int>();
+    checkCompression<long long>();
+    checkCompressedQueries<int>();
+    checkCompressedQueries<long long>();
+    checkSumOverflow();
+    checkCorruptLzHeader();
+
+    // 64-bit timestamps whose steps span the full width exercise the 64-bit DeltaBitPacked lanes.
+    MemoryManager<long long> manager(false);
+    std::vector<long long> timestamps;
+    long long value = 1700000000000000000LL;
+    for (int i = 0; i < 1000; ++i) {
+        value += (i % 3 == 0) ? 1LL << 40 : -(static_cast<long long>(i) << 20);
+        timestamps.push_back(value);
+    }
+    timestamps.push_back(std::numeric_limits<long long>::min());
+    timestamps.push_back(std::numeric_limits<long long>::max());
+    checkFormats(manager, timestamps);
+
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,95 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Builds ascending, random and zig-zagging sequences so that every delta width is exercised.
+template <typename Integer>
+static std::vector<Integer> makeSequence(std::mt19937_64& random, int count, int kind) {
+    std::vector<Integer> values(count);
+    Integer value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (kind == 0) {
+            values[i] = static_cast<Integer>(random());
+        }
+        else if (kind == 1) {
+            value = static_cast<Integer>(value + static_cast<Integer>(random() % 100));
+            values[i] = value;
+        }
+        else {
+            value = static_cast<Integer>(value + static_cast<Integer>(random() % 7) - 3);
+            values[i] = value;
+        }
+    }
+    return values;
+}
+
+template <typename Integer>
+static void checkDeltaCodec(std::mt19937_64& random) {
+    const int counts[] = { 0, 1, 5, 127, 128, 129, 1000, 100000 };
+    for (int c = 0; c < 8; ++c) {
+        for (int kind = 0; kind < 3; ++kind) {
+            int count = counts[c];
+            std::vector<Integer> values = makeSequence<Integer>(random, count, kind);
+            std::vector<unsigned char> encoded(DeltaCodec::maxEncodedSize(count, sizeof(Integer)));
+            int length = DeltaCodec::encode(values.data(), count, encoded.data());
+            PTRX_CHECK(length > 0);
+
+            // The header is "PXD", version 2, the element size, the signedness and the little-endian count.
+            PTRX_CHECK(encoded[0] == 'P' && encoded[1] == 'X' && encoded[2] == 'D' && encoded[3] == 2);
+            PTRX_CHECK(encoded[4] == sizeof(Integer) && encoded[5] == (std::is_signed<Integer>::value ? 1 : 0));
+            PTRX_CHECK(encoded[6] == (count & 0xff) && encoded[7] == ((count >> 8) & 0xff) && encoded[8] == ((count >> 16) & 0xff));
+            PTRX_CHECK(DeltaCodec::encodedCount(encoded.data(), length) == count);
+
+            std::vector<Integer> decoded(count + 1);
+            PTRX_CHECK(DeltaCodec::decode(encoded.data(), length, decoded.data()));
+            PTRX_CHECK(std::equal(values.begin(), values.end(), decoded.begin()));
+
+            int blocks = DeltaCodec::blockCount(encoded.data(), length);
+            PTRX_CHECK(blocks == (count + DeltaCodec::BlockSize - 1) / DeltaCodec::BlockSize);
+            Integer block[DeltaCodec::BlockSize];
+            for (int b = 0; b < blocks; ++b) {
+                int begin = b * DeltaCodec::BlockSize;
+                int blockSize = DeltaCodec::decodeBlock(encoded.data(), length, b, block);
+                PTRX_CHECK(blockSize == std::min(DeltaCodec::BlockSize, count - begin));
+                PTRX_CHECK(std::equal(block, block + blockSize, values.begin() + begin));
+
+                Integer minimum = 0, maximum = 0;
+                PTRX_CHECK(DeltaCodec::blockRange(encoded.data(), length, b, minimum, maximum));
+                PTRX_CHECK(minimum == *std::min_element(values.begin() + begin, values.begin() + begin + blockSize));
+                PTRX_CHECK(maximum == *std::max_element(values.begin() + begin, values.begin() + begin + blockSize));
+            }
+            PTRX_CHECK(DeltaCodec::decodeBlock(encoded.data(), length, blocks, block) == 0);
+        }
+    }
+}
+
+static void checkDeltaCodecRejectsMismatches() {
+    std::vector<int> values(300, 5);
+    std::vector<unsigned char> encoded(DeltaCodec::maxEncodedSize(300, 4));
+    int length = DeltaCodec::encode(values.data(), 300, encoded.data());
+
+    // A stream must be decoded with the element size and signedness it was written with.
+    std::vector<long long> wide(300);
+    std::vector<unsigned int> unsignedValues(300);
+    unsigned int minimum = 0, maximum = 0;
+    PTRX_CHECK(!DeltaCodec::decode(encoded.data(), length, wide.data()));
+    PTRX_CHECK(!DeltaCodec::blockRange(encoded.data(), length, 0, minimum, maximum));
+    PTRX_CHECK(DeltaCodec::decode(encoded.data(), length, unsignedValues.data()));
+    PTRX_CHECK(!DeltaCodec::decode(encoded.data(), 5, values.data()));
+    PTRX_CHECK(DeltaCodec::maxEncodedSize(10, 2) == 0);
+}
+
+int main() {
+    std::mt19937_64 random(3);
+    checkDeltaCodec<int>(random);
+    checkDeltaCodec<unsigned int>(random);
+    checkDeltaCodec<long long>(random);
+    checkDeltaCodec<std::uint64_t>(random);
+    checkDeltaCodecRejectsMismatches();
+
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,86 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Streams pushed in arbitrary chunks must decode whole, frame by frame and by walking the frame headers,
+// for every format and frame size.
+template <typename T>
+static void checkFrameStreams() {
+    MemoryManager<T> manager(false);
+    std::mt19937 random(5);
+    const CompressionFormat formats[] = { CompressionFormat::Lz, CompressionFormat::RunLength, CompressionFormat::DeltaBitPacked };
+    const int frameSizes[] = { 1, 7, 1000, 65536 };
+
+    for (int f = 0; f < 3; ++f) {
+        for (int s = 0; s < 4; ++s) {
+            int frameSize = frameSizes[s];
+            int size = 100000 + static_cast<int>(random() % 1000);
+            std::vector<T> values(size);
+            for (int i = 0; i < size; ++i) {
+                values[i] = static_cast<T>(i / 5 + static_cast<int>(random() % 3));
+            }
+
+            FrameCompressor<T> compressor(manager, formats[f], frameSize, ExecutionPolicy::parallel(4));
+            std::vector<unsigned char> stream, frame;
+            int position = 0;
+            while (position < size) {
+                int chunk = std::min(size - position, static_cast<int>(random() % 40000));
+                PTRX_CHECK(compressor.push(values.data() + position, chunk));
+                position += chunk;
+                while (compressor.nextFrame(frame)) {
+                    stream.insert(stream.end(), frame.begin(), frame.end());
+                }
+            }
+            PTRX_CHECK(compressor.finish() && compressor.finish());
+            PTRX_CHECK(!compressor.push(values.data(), 1));
+            while (compressor.nextFrame(frame)) {
+                stream.insert(stream.end(), frame.begin(), frame.end());
+            }
+
+            FrameDecompressor<T> decompressor(manager);
+            PTRX_CHECK(decompressor.open(stream.data(), stream.size()));
+            PTRX_CHECK(static_cast<int>(decompressor.totalSize()) == size);
+            PTRX_CHECK(decompressor.frameCount() == (size + frameSize - 1) / frameSize);
+
+            std::vector<T> decoded(size);
+            PTRX_CHECK(decompressor.decodeAll(decoded.data(), ExecutionPolicy::parallel()) && decoded == values);
+
+            int lastFrame = decompressor.frameCount() - 1;
+            std::vector<T> single(decompressor.frameSize(lastFrame));
+            PTRX_CHECK(decompressor.decodeFrame(lastFrame, single.data()));
+            PTRX_CHECK(std::equal(single.begin(), single.end(), values.begin() + static_cast<std::size_t>(lastFrame) * frameSize));
+
+            // Frames are self-delimiting from their fixed-size header alone.
+            std::size_t offset = 0;
+            int frames = 0;
+            while (offset < stream.size()) {
+                std::size_t frameLength = FrameDecompressor<T>::frameLength(stream.data() + offset, stream.size() - offset);
+                PTRX_CHECK(frameLength > 0);
+                if (frameLength == 0) {
+                    break;
+                }
+                offset += frameLength;
+                ++frames;
+            }
+            PTRX_CHECK(offset == stream.size() && frames == decompressor.frameCount());
+
+            PTRX_CHECK(!decompressor.open(stream.data(), stream.size() - 1));
+            PTRX_CHECK(decompressor.frameCount() == 0);
+        }
+    }
+
+    FrameCompressor<T> empty(manager);
+    PTRX_CHECK(empty.finish() && empty.readyFrameCount() == 0);
+    FrameDecompressor<T> emptyReader(manager);
+    PTRX_CHECK(emptyReader.open(nullptr, 0) && emptyReader.frameCount() == 0);
+}
+
+int main() {
+    checkFrameStreams<int>();
+    checkFrameStreams<long long>();
+
+    return PTRX_TEST_RESULT();
+}
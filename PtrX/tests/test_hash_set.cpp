@@ -0,0 +1,96 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <vector>
+
+template <typename T>
+static void checkFlatHashSet(MemoryManager<T>& manager) {
+    FlatHashSet<T> set(manager);
+    PTRX_CHECK(set.insert(static_cast<T>(3)) == FlatHashSet<T>::Inserted);
+    PTRX_CHECK(set.insert(static_cast<T>(3)) == FlatHashSet<T>::AlreadyPresent);
+
+    // Growing well past the initial capacity goes through several rehashes.
+    for (int i = 0; i < 10000; ++i) {
+        set.insert(static_cast<T>(i * 7));
+    }
+    PTRX_CHECK(set.size() == 10001);
+    PTRX_CHECK(set.contains(static_cast<T>(3)));
+    PTRX_CHECK(set.contains(static_cast<T>(69993)));
+    PTRX_CHECK(!set.contains(static_cast<T>(4)));
+    PTRX_CHECK(set.erase(static_cast<T>(3)));
+    PTRX_CHECK(!set.contains(static_cast<T>(3)));
+
+    std::vector<T> block(100);
+    for (int i = 0; i < 100; ++i) {
+        block[i] = static_cast<T>(i % 10 + 100000);
+    }
+    PTRX_CHECK(set.insert(block.data(), 100) == 10);
+    PTRX_CHECK(set.insert(static_cast<const T*>(nullptr), 1) == 0);
+}
+
+template <typename T>
+static void checkDeduplicate(MemoryManager<T>& manager) {
+    T values[] = { 5, 1, 5, 2, 1, 9, 2, 5 };
+    T expected[] = { 5, 1, 2, 9 };
+    PTRX_CHECK(manager.deduplicateMemoryStable(values, 8) == 4);
+    PTRX_CHECK(std::equal(expected, expected + 4, values));
+
+    const int size = 50000;
+    std::vector<T> large(size);
+    for (int i = 0; i < size; ++i) {
+        large[i] = static_cast<T>((i * 7919) % 1000);
+    }
+    PTRX_CHECK(manager.deduplicateMemoryStable(large.data(), size) == 1000);
+    PTRX_CHECK(large[0] == static_cast<T>(0) && large[1] == static_cast<T>(919));
+
+    // The hash-partitioned parallel pass keeps the same first occurrences in the same order.
+    const int parallelSize = 400003;
+    std::vector<T> sequential(parallelSize);
+    for (int i = 0; i < parallelSize; ++i) {
+        sequential[i] = static_cast<T>((static_cast<long long>(i) * 2654435761LL) % 150001);
+    }
+    std::vector<T> parallel = sequential;
+    int sequentialCount = manager.deduplicateMemoryStable(sequential.data(), parallelSize, ExecutionPolicy::sequential());
+    int parallelCount = manager.deduplicateMemoryStable(parallel.data(), parallelSize, ExecutionPolicy::parallel(4));
+    PTRX_CHECK(sequentialCount == 150001 && parallelCount == sequentialCount);
+    PTRX_CHECK(std::equal(sequential.begin(), sequential.begin() + sequentialCount, parallel.begin()));
+}
+
+template <typename T>
+static void checkUnsortedSetOperations(MemoryManager<T>& manager) {
+    T first[] = { 4, 8, 4, 1, 6 };
+    T second[] = { 6, 3, 4, 3 };
+    int size = 0;
+
+    T* result = manager.unionUnsortedMemory(first, 5, second, 4, size);
+    T unionExpected[] = { 4, 8, 1, 6, 3 };
+    PTRX_CHECK(result != nullptr && size == 5 && std::equal(unionExpected, unionExpected + 5, result));
+    manager.deallocateMemory(result);
+
+    result = manager.intersectUnsortedMemory(first, 5, second, 4, size);
+    T intersectionExpected[] = { 4, 6 };
+    PTRX_CHECK(result != nullptr && size == 2 && std::equal(intersectionExpected, intersectionExpected + 2, result));
+    manager.deallocateMemory(result);
+
+    result = manager.differenceUnsortedMemory(first, 5, second, 4, size);
+    T differenceExpected[] = { 8, 1 };
+    PTRX_CHECK(result != nullptr && size == 2 && std::equal(differenceExpected, differenceExpected + 2, result));
+    manager.deallocateMemory(result);
+
+    PTRX_CHECK(manager.unionUnsortedMemory(nullptr, 5, second, 4, size) == nullptr && size == 0);
+}
+
+template <typename T>
+static void checkAll() {
+    MemoryManager<T> manager(false);
+    checkFlatHashSet(manager);
+    checkDeduplicate(manager);
+    checkUnsortedSetOperations(manager);
+}
+
+int main() {
+    checkAll<int>();
+    checkAll<long long>();
+    checkAll<double>();
+    return PTRX_TEST_RESULT();
+}
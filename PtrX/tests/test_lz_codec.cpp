@@ -0,0 +1,73 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// A block assembled by hand in the LZ4 sequence format: "abcd" as literals, then an 11-byte match at
+// offset 4 overlapping its own output, then the mandatory 5 trailing literals.
+static void checkLzKnownBlock() {
+    const unsigned char block[] = { 0x47, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x50, 'd', 'a', 'b', 'c', 'd' };
+    const char* expected = "abcdabcdabcdabcdabcd";
+    unsigned char decoded[20];
+    PTRX_CHECK(LzCodec::decode(block, sizeof(block), decoded, 20));
+    PTRX_CHECK(std::memcmp(decoded, expected, 20) == 0);
+    PTRX_CHECK(!LzCodec::decode(block, sizeof(block), decoded, 19));
+
+    // An offset reaching before the start of the output is rejected.
+    const unsigned char badOffset[] = { 0x47, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x50, 'd', 'a', 'b', 'c', 'd' };
+    PTRX_CHECK(!LzCodec::decode(badOffset, sizeof(badOffset), decoded, 20));
+}
+
+static void checkLzRoundTrips() {
+    std::mt19937 random(7);
+    const char* words[] = { "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog " };
+    std::vector<unsigned char> text;
+    while (text.size() < 200000) {
+        const char* word = words[random() % 8];
+        text.insert(text.end(), word, word + std::strlen(word));
+    }
+
+    const int sizes[] = { 1, 4, 12, 13, 17, 100, 4096, 200000 };
+    for (int s = 0; s < 8; ++s) {
+        int size = sizes[s];
+        std::vector<unsigned char> encoded(LzCodec::maxEncodedSize(size));
+        std::vector<unsigned char> decoded(size);
+        int length = LzCodec::encode(text.data(), size, encoded.data());
+        PTRX_CHECK(length > 0 && length <= LzCodec::maxEncodedSize(size));
+        PTRX_CHECK(LzCodec::decode(encoded.data(), length, decoded.data(), size));
+        PTRX_CHECK(std::equal(decoded.begin(), decoded.end(), text.begin()));
+        if (size == 200000) {
+            PTRX_CHECK(length < size / 2);
+        }
+    }
+
+    // Long runs decode through overlapping matches; the expected length must match exactly.
+    std::vector<unsigned char> run(1000, 'a');
+    run[500] = 'b';
+    std::vector<unsigned char> encoded(LzCodec::maxEncodedSize(1000));
+    std::vector<unsigned char> decoded(1000);
+    int length = LzCodec::encode(run.data(), 1000, encoded.data());
+    PTRX_CHECK(LzCodec::decode(encoded.data(), length, decoded.data(), 1000) && decoded == run);
+    PTRX_CHECK(!LzCodec::decode(encoded.data(), length, decoded.data(), 999));
+
+    // Random bit flips must never make the decoder write out of bounds.
+    for (int trial = 0; trial < 2000; ++trial) {
+        std::vector<unsigned char> corrupted(encoded.begin(), encoded.begin() + length);
+        corrupted[random() % length] ^= static_cast<unsigned char>(1u << (random() % 8));
+        LzCodec::decode(corrupted.data(), length, decoded.data(), 1000);
+    }
+
+    unsigned char empty = 0;
+    int emptyLength = LzCodec::encode(nullptr, 0, encoded.data());
+    PTRX_CHECK(emptyLength == 1 && LzCodec::decode(encoded.data(), emptyLength, &empty, 0));
+}
+
+int main() {
+    checkLzKnownBlock();
+    checkLzRoundTrips();
+
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,60 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <memory>
+#include <vector>
+
+template <typename T>
+static void checkBulkOperations(MemoryManager<T>& manager) {
+    const int size = 1 << 20;
+    std::vector<T> source(size), destination(size), other(size), result(size);
+    for (int i = 0; i < size; ++i) {
+        source[i] = static_cast<T>(i % 1000);
+        other[i] = static_cast<T>(i % 7);
+    }
+
+    PTRX_CHECK(manager.copyMemory(source.data(), destination.data(), size, ExecutionPolicy::parallel()));
+    PTRX_CHECK(destination == source);
+
+    int sequentialChecksum = manager.calculateChecksum(source.data(), size);
+    PTRX_CHECK(manager.calculateChecksum(source.data(), size, ExecutionPolicy::parallel()) == sequentialChecksum);
+    PTRX_CHECK(manager.calculateChecksum(source.data(), size, ExecutionPolicy::parallel(3)) == sequentialChecksum);
+
+    manager.replaceValue(destination.data(), size, 999, 5, ExecutionPolicy::parallel());
+    int replaced = 0;
+    for (int i = 0; i < size; ++i) {
+        replaced += destination[i] == static_cast<T>(5) && source[i] == static_cast<T>(999);
+    }
+    PTRX_CHECK(replaced == size / 1000);
+
+    PTRX_CHECK(manager.fillMemory(result.data(), 42, size, ExecutionPolicy::parallel()));
+    PTRX_CHECK(result.front() == static_cast<T>(42) && result.back() == static_cast<T>(42));
+
+    PTRX_CHECK(!manager.copyMemory(nullptr, destination.data(), size, ExecutionPolicy::parallel()));
+}
+
+int main() {
+    MemoryManager<int> pooled(false, std::make_shared<ThreadPool>(4));
+    checkBulkOperations(pooled);
+
+    MemoryManager<long long> wide(false, std::make_shared<ThreadPool>(2));
+    checkBulkOperations(wide);
+
+    MemoryManager<int> manager(false);
+    const int size = 1 << 19;
+    std::vector<int> a(size), b(size), x(size);
+    for (int i = 0; i < size; ++i) {
+        a[i] = i;
+        b[i] = i * 7;
+    }
+    manager.xorMemory(a.data(), b.data(), x.data(), size, ExecutionPolicy::parallel());
+    bool xorMatches = true;
+    for (int i = 0; i < size; ++i) {
+        xorMatches = xorMatches && x[i] == (a[i] ^ b[i]);
+    }
+    PTRX_CHECK(xorMatches);
+
+    PTRX_CHECK(ExecutionPolicy::sequential().mode == ExecutionMode::Sequential);
+    PTRX_CHECK(ExecutionPolicy::parallel(3).threadCount == 3);
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Every lookup through the spline index, and through a copy restored from its serialized form, must land on
+// the std::lower_bound position, whatever the key distribution and error bound.
+template <typename T>
+static void checkRadixSplineIndex() {
+    std::mt19937 generator(5);
+    int sizes[] = { 1, 2, 3, 10, 1000, 100000 };
+    int errors[] = { 0, 4, 32 };
+    for (int size : sizes) {
+        for (int shape = 0; shape < 3; ++shape) {
+            std::vector<T> block(size);
+            for (int i = 0; i < size; ++i) {
+                block[i] = shape == 0 ? static_cast<T>(generator())
+                    : shape == 1 ? static_cast<T>(generator() % static_cast<unsigned int>(size / 2 + 1))
+                    : static_cast<T>(static_cast<long long>(std::pow(static_cast<double>(i), 1.7)));
+            }
+            std::sort(block.begin(), block.end());
+
+            for (int maxError : errors) {
+                RadixSplineIndex<T> index(block.data(), size, maxError);
+                std::vector<unsigned char> serialized(index.serializedSize());
+                PTRX_CHECK(index.serialize(serialized.data()) == static_cast<int>(serialized.size()));
+                RadixSplineIndex<T> restored;
+                PTRX_CHECK(restored.deserialize(serialized.data(), static_cast<int>(serialized.size())));
+
+                bool agrees = true;
+                for (int query = 0; query < 2000; ++query) {
+                    T key = query % 2 ? static_cast<T>(block[generator() % size] + static_cast<T>(generator() % 3) - T(1))
+                        : static_cast<T>(generator());
+                    int lower = static_cast<int>(std::lower_bound(block.begin(), block.end(), key) - block.begin());
+                    int begin = 0, end = 0;
+                    index.searchBound(key, begin, end);
+                    bool present = lower < size && block[lower] == key;
+                    agrees = agrees && index.lowerBound(block.data(), key) == lower
+                        && restored.lowerBound(block.data(), key) == lower
+                        && index.find(block.data(), key) == (present ? lower : -1)
+                        && (!present || (begin <= lower && lower < end));
+                }
+                PTRX_CHECK(agrees);
+            }
+        }
+    }
+
+    const unsigned char garbage[] = { 'X', 'X', 'X', 'X' };
+    RadixSplineIndex<T> rejected;
+    PTRX_CHECK(!rejected.deserialize(garbage, 4));
+}
+
+// A serialized index whose spline or radix table has been tampered with is rejected rather than trusted.
+static void checkCorruptIndexIsRejected() {
+    std::vector<int> block(5000);
+    for (int i = 0; i < 5000; ++i) {
+        block[i] = i * i / 7;
+    }
+    RadixSplineIndex<int> index(block.data(), 5000, 8);
+    std::vector<unsigned char> serialized(index.serializedSize());
+    index.serialize(serialized.data());
+
+    const std::size_t headerSize = 41;
+    std::size_t pointCount = serialized[33] | serialized[34] << 8;
+    std::size_t tableStart = headerSize + pointCount * 12;
+    PTRX_CHECK(pointCount >= 3);
+
+    std::vector<unsigned char> corrupt = serialized;
+    std::swap_ranges(corrupt.begin() + headerSize + 12, corrupt.begin() + headerSize + 20, corrupt.begin() + headerSize + 24);
+    RadixSplineIndex<int> restored;
+    PTRX_CHECK(!restored.deserialize(corrupt.data(), static_cast<int>(corrupt.size())));
+    PTRX_CHECK(restored.size() == 0);
+
+    corrupt = serialized;
+    corrupt[headerSize + (pointCount - 1) * 12 + 7] ^= 0x40;
+    PTRX_CHECK(!restored.deserialize(corrupt.data(), static_cast<int>(corrupt.size())));
+
+    corrupt = serialized;
+    corrupt[tableStart + 4 * 3] = 0xFF;
+    corrupt[tableStart + 4 * 3 + 1] = 0xFF;
+    PTRX_CHECK(!restored.deserialize(corrupt.data(), static_cast<int>(corrupt.size())));
+
+    corrupt = serialized;
+    corrupt[tableStart + 4 * 5] = 0;
+    corrupt[tableStart + 4 * 5 + 1] = 0;
+    corrupt[tableStart + 4 * 4] = 3;
+    PTRX_CHECK(!restored.deserialize(corrupt.data(), static_cast<int>(corrupt.size())));
+
+    // A flipped byte in the spline or the table is either rejected or still gives correct lookups.
+    std::mt19937 generator(11);
+    bool correct = true;
+    for (int trial = 0; trial < 2000; ++trial) {
+        corrupt = serialized;
+        corrupt[headerSize + generator() % (corrupt.size() - headerSize)] ^= static_cast<unsigned char>(1 + generator() % 255);
+        if (restored.deserialize(corrupt.data(), static_cast<int>(corrupt.size()))) {
+            int key = static_cast<int>(generator() % 3600000);
+            int lower = static_cast<int>(std::lower_bound(block.begin(), block.end(), key) - block.begin());
+            correct = correct && restored.lowerBound(block.data(), key) == lower;
+        }
+    }
+    PTRX_CHECK(correct);
+    PTRX_CHECK(restored.deserialize(serialized.data(), static_cast<int>(serialized.size())));
+}
+
+int main() {
+    checkRadixSplineIndex<int>();
+    checkRadixSplineIndex<unsigned int>();
+    checkRadixSplineIndex<long long>();
+    checkCorruptIndexIsRejected();
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+static std::uint64_t referenceSplitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static std::uint64_t rotateLeft(std::uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static std::uint64_t referenceXoshiro(std::uint64_t* state) {
+    std::uint64_t result = rotateLeft(state[0] + state[3], 23) + state[0];
+    std::uint64_t shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+// RandomEngine is xoshiro256++ seeded from splitmix64, checked against the published reference code.
+static void checkRandomEngine() {
+    std::uint64_t seed = 0;
+    PTRX_CHECK(referenceSplitMix64(seed) == 0xe220a8397b1dcdafULL);
+    std::uint64_t unitState[4] = { 1, 2, 3, 4 };
+    PTRX_CHECK(referenceXoshiro(unitState) == 41943041ULL);
+
+    const std::uint64_t seeds[] = { 0, 1, 42, 0xdeadbeefcafef00dULL };
+    for (int s = 0; s < 4; ++s) {
+        std::uint64_t splitState = seeds[s];
+        std::uint64_t state[4];
+        for (int i = 0; i < 4; ++i) {
+            state[i] = referenceSplitMix64(splitState);
+        }
+        RandomEngine engine(seeds[s]);
+        for (int i = 0; i < 1000; ++i) {
+            PTRX_CHECK(engine() == referenceXoshiro(state));
+        }
+    }
+
+    RandomEngine first(9), second(9);
+    second.jump();
+    PTRX_CHECK(first() != second());
+
+    RandomEngine bounded(1);
+    int counts[7] = {};
+    for (int i = 0; i < 70000; ++i) {
+        std::uint32_t value = bounded.nextBounded(7);
+        PTRX_CHECK(value < 7);
+        if (value < 7) {
+            ++counts[value];
+        }
+    }
+    for (int k = 0; k < 7; ++k) {
+        PTRX_CHECK(counts[k] > 9000 && counts[k] < 11000);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        int value = bounded.nextInRange(-3, 3);
+        PTRX_CHECK(value >= -3 && value <= 3);
+    }
+    PTRX_CHECK(bounded.nextInRange(5, 5) == 5);
+    bounded.nextInRange(INT_MIN, INT_MAX);
+
+    std::vector<int> permutation(10);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), bounded);
+    std::sort(permutation.begin(), permutation.end());
+    for (int i = 0; i < 10; ++i) {
+        PTRX_CHECK(permutation[i] == i);
+    }
+}
+
+// Philox4x32-10 with a zero key and counter, from the Random123 known-answer vectors.
+static void checkPhiloxEngine() {
+    PhiloxEngine zero(0);
+    std::uint32_t block[4];
+    zero.generateBlock(0, block);
+    PTRX_CHECK(block[0] == 0x6627e8d5u && block[1] == 0xe169c58du && block[2] == 0xbc57ac4cu && block[3] == 0x9b00dbd8u);
+
+    // The vectorized fill must agree with the one-block kernel at any starting word, including a counter
+    // whose low half wraps.
+    PhiloxEngine engine(0x1234567890abcdefULL);
+    const std::uint64_t starts[] = { 0, 5, (0xFFFFFFFFULL - 9) * 4 + 1, 123456789 };
+    for (int s = 0; s < 4; ++s) {
+        std::vector<std::uint32_t> filled(1000), expected(1000);
+        engine.fill(starts[s], filled.data(), filled.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            engine.generateBlock((starts[s] + i) / 4, block);
+            expected[i] = block[(starts[s] + i) % 4];
+        }
+        PTRX_CHECK(filled == expected);
+
+        std::vector<std::uint32_t> boundedWords(1000);
+        engine.fillBounded(starts[s], 10, boundedWords.data(), boundedWords.size());
+        for (std::size_t i = 0; i < boundedWords.size(); ++i) {
+            PTRX_CHECK(boundedWords[i] < 10);
+        }
+    }
+}
+
+template <typename T>
+static void checkSeededFill() {
+    MemoryManager<T> manager(false);
+    const int size = 3000001;
+    std::vector<T> sequential(size), parallel(size);
+
+    // Element i is word i of the Philox stream shifted into the non-negative int range.
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(sequential.data(), size, 0, ExecutionPolicy::sequential()));
+    PTRX_CHECK(sequential[0] == static_cast<T>(0x6627e8d5u >> 1) && sequential[3] == static_cast<T>(0x9b00dbd8u >> 1));
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(parallel.data(), size, 0, ExecutionPolicy::parallel(4)));
+    PTRX_CHECK(sequential == parallel);
+
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(sequential.data(), size, -10, 1000, 77, ExecutionPolicy::sequential()));
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(parallel.data(), size, -10, 1000, 77, ExecutionPolicy::parallel(3)));
+    PTRX_CHECK(sequential == parallel);
+    PTRX_CHECK(*std::min_element(sequential.begin(), sequential.end()) == -10);
+    PTRX_CHECK(*std::max_element(sequential.begin(), sequential.end()) == 1000);
+    PTRX_CHECK(!manager.initializeMemoryWithRandomValues(sequential.data(), size, 5, -5, 77, ExecutionPolicy::sequential()));
+
+    RandomEngine first(8), second(8);
+    std::vector<T> a(100), b(100);
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(a.data(), 100, -5, 5, first));
+    PTRX_CHECK(manager.initializeMemoryWithRandomValues(b.data(), 100, -5, 5, second));
+    PTRX_CHECK(a == b);
+    for (int i = 0; i < 100; ++i) {
+        PTRX_CHECK(a[i] >= -5 && a[i] <= 5);
+    }
+}
+
+int main() {
+    checkRandomEngine();
+    checkPhiloxEngine();
+    checkSeededFill<int>();
+    checkSeededFill<long long>();
+
+    return PTRX_TEST_RESULT();
+}
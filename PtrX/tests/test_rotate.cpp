@@ -0,0 +1,100 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+static long long wrap(long long shift, long long size) {
+    shift %= size;
+    return shift < 0 ? shift + size : shift;
+}
+
+template <typename T>
+static T makeValue(int i, T*) {
+    return static_cast<T>(i);
+}
+
+static std::string makeValue(int i, std::string*) {
+    return std::to_string(i) + std::string(i % 3 * 10, 'x');
+}
+
+// Every rotation entry point is compared with std::rotate over sizes that straddle the block-swap
+// thresholds and shifts that are negative, larger than the size or at the int limits.
+template <typename T>
+static void checkRotations() {
+    MemoryManager<T> manager(false);
+    const int sizes[] = { 1, 2, 3, 5, 17, 64, 255, 256, 257, 1000, 4099, 70000 };
+
+    for (int s = 0; s < 12; ++s) {
+        int size = sizes[s];
+        const int shifts[] = { 0, 1, 2, 3, size / 3, size / 2, size - 1, size, size + 1, -1, -size / 3, 3 * size + 7, INT_MAX, INT_MIN, 257 };
+        std::vector<T> source(size);
+        for (int i = 0; i < size; ++i) {
+            source[i] = makeValue(i, static_cast<T*>(nullptr));
+        }
+
+        for (int k = 0; k < 15; ++k) {
+            int shift = shifts[k];
+            std::vector<T> left = source;
+            std::rotate(left.begin(), left.begin() + wrap(shift, size), left.end());
+            std::vector<T> right = source;
+            std::rotate(right.begin(), right.begin() + (size - wrap(shift, size)) % size, right.end());
+
+            std::vector<T> data = source;
+            manager.rotateMemoryLeft(data.data(), size, shift);
+            PTRX_CHECK(data == left);
+            data = source;
+            manager.shiftMemoryCircular(data.data(), size, shift);
+            PTRX_CHECK(data == left);
+            data = source;
+            manager.rotateMemoryRight(data.data(), size, shift);
+            PTRX_CHECK(data == right);
+
+            if (size < 4) {
+                continue;
+            }
+            int start = 1, end = size - 2, length = end - start + 1;
+            std::vector<T> expected = source;
+            std::rotate(expected.begin() + start, expected.begin() + start + wrap(shift, length), expected.begin() + end + 1);
+            data = source;
+            manager.rotateMemoryRangeLeft(data.data(), start, end, shift);
+            PTRX_CHECK(data == expected);
+
+            expected = source;
+            std::rotate(expected.begin() + start, expected.begin() + start + (length - wrap(shift, length)) % length, expected.begin() + end + 1);
+            data = source;
+            manager.rotateMemoryRangeRight(data.data(), start, end, shift);
+            PTRX_CHECK(data == expected);
+
+            int middle = start + static_cast<int>(wrap(shift, length - 1));
+            expected = source;
+            std::rotate(expected.begin() + start, expected.begin() + middle + 1, expected.begin() + end + 1);
+            data = source;
+            manager.swapAdjacentMemoryRanges(data.data(), start, middle, middle + 1, end);
+            PTRX_CHECK(data == expected);
+        }
+    }
+}
+
+int main() {
+    checkRotations<int>();
+    checkRotations<long long>();
+    checkRotations<double>();
+    checkRotations<std::string>();
+
+    // Ranges that are not adjacent are left alone.
+    MemoryManager<int> manager(false);
+    std::vector<int> values(10);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<int> original = values;
+    manager.swapAdjacentMemoryRanges(values.data(), 0, 2, 4, 6);
+    PTRX_CHECK(values == original);
+    manager.swapAdjacentMemoryRanges(values.data(), 0, 2, 3, 9);
+    const int swapped[] = { 3, 4, 5, 6, 7, 8, 9, 0, 1, 2 };
+    PTRX_CHECK(std::equal(values.begin(), values.end(), swapped));
+
+    return PTRX_TEST_RESULT();
+}
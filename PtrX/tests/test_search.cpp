@@ -0,0 +1,55 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+template <typename T>
+static std::vector<T> makeSorted(std::mt19937& generator, int size, int spread) {
+    std::vector<T> values(size);
+    for (int i = 0; i < size; ++i) {
+        values[i] = static_cast<T>(static_cast<int>(generator() % static_cast<unsigned int>(spread)) - spread / 4);
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// The branchless searches and the Eytzinger layout must agree with std::lower_bound and std::upper_bound
+// for every key around the block, including duplicates and keys past either end.
+template <typename T>
+static void checkSortedSearch() {
+    MemoryManager<T> manager(false);
+    std::mt19937 generator(3);
+    int sizes[] = { 1, 2, 3, 5, 7, 8, 15, 16, 17, 100, 1000, 4097 };
+    for (int size : sizes) {
+        std::vector<T> block = makeSorted<T>(generator, size, size * 2);
+        EytzingerIndex<T> index(block.data(), size);
+        PTRX_CHECK(index.size() == size);
+
+        bool agrees = true;
+        for (int key = -size - 2; key <= 2 * size + 2; ++key) {
+            T value = static_cast<T>(key);
+            int lower = static_cast<int>(std::lower_bound(block.begin(), block.end(), value) - block.begin());
+            int upper = static_cast<int>(std::upper_bound(block.begin(), block.end(), value) - block.begin());
+            int first = 0, last = 0;
+            bool found = manager.equalRange(block.data(), size, key, first, last);
+            agrees = agrees && manager.lowerBound(block.data(), size, key) == lower
+                && manager.upperBound(block.data(), size, key) == upper
+                && found == (lower < upper) && first == lower && last == upper
+                && manager.binarySearch(block.data(), size, key) == (lower < upper ? lower : -1)
+                && index.lowerBound(value) == lower && index.upperBound(value) == upper
+                && index.find(value) == (lower < upper ? lower : -1);
+        }
+        PTRX_CHECK(agrees);
+    }
+
+    EytzingerIndex<T> empty;
+    PTRX_CHECK(empty.size() == 0 && empty.lowerBound(T(1)) == 0 && empty.find(T(1)) == -1);
+}
+
+int main() {
+    checkSortedSearch<int>();
+    checkSortedSearch<long long>();
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+template <typename T>
+static std::vector<T> makeValues(int size, int range) {
+    std::vector<T> values(size);
+    unsigned int state = 12345;
+    for (int i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        values[i] = static_cast<T>(static_cast<int>(state >> 8) % range - range / 2);
+    }
+    return values;
+}
+
+template <typename T>
+static void checkNthElement(MemoryManager<T>& manager, const ExecutionPolicy& policy) {
+    int sizes[] = { 1, 31, 1000, 200000 };
+    for (int size : sizes) {
+        // A narrow range forces many duplicates of the pivot.
+        int ranges[] = { 10, 1 << 20 };
+        for (int range : ranges) {
+            std::vector<T> values = makeValues<T>(size, range);
+            std::vector<T> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+
+            int positions[] = { 0, size / 3, size - 1 };
+            for (int n : positions) {
+                std::vector<T> data = values;
+                PTRX_CHECK(manager.nthElement(data.data(), size, n, policy));
+                PTRX_CHECK(data[n] == sorted[n]);
+                bool ordered = true;
+                for (int i = 0; i < size; ++i) {
+                    ordered = ordered && (i < n ? !(data[n] < data[i]) : !(data[i] < data[n]));
+                }
+                PTRX_CHECK(ordered);
+            }
+        }
+    }
+
+    T single = static_cast<T>(4);
+    PTRX_CHECK(!manager.nthElement(&single, 1, 1, policy));
+}
+
+template <typename T>
+static void checkTopK(MemoryManager<T>& manager, const ExecutionPolicy& policy) {
+    const int size = 100000;
+    std::vector<T> values = makeValues<T>(size, 1 << 16);
+    std::vector<T> sorted = values;
+    std::sort(sorted.begin(), sorted.end(), std::greater<T>());
+
+    // Small k take the heap, large k the selection.
+    int counts[] = { 1, 10, 5000, size };
+    for (int k : counts) {
+        std::vector<T> destination(k);
+        PTRX_CHECK(manager.topK(values.data(), size, k, destination.data(), policy));
+        PTRX_CHECK(std::equal(destination.begin(), destination.end(), sorted.begin()));
+    }
+    PTRX_CHECK(!manager.topK(values.data(), size, 0, sorted.data(), policy));
+}
+
+template <typename T>
+static void checkPartitions(MemoryManager<T>& manager, const ExecutionPolicy& policy) {
+    const int size = 300000;
+    std::vector<T> values = makeValues<T>(size, 100);
+    int expectedBelow = static_cast<int>(std::count_if(values.begin(), values.end(), [](const T& value) { return value < static_cast<T>(7); }));
+    int expectedEqual = static_cast<int>(std::count(values.begin(), values.end(), static_cast<T>(7)));
+
+    std::vector<T> data = values;
+    int below = manager.partitionMemory(data.data(), size, 7, policy);
+    PTRX_CHECK(below == expectedBelow);
+    PTRX_CHECK(std::all_of(data.begin(), data.begin() + below, [](const T& value) { return value < static_cast<T>(7); }));
+    PTRX_CHECK(std::none_of(data.begin() + below, data.end(), [](const T& value) { return value < static_cast<T>(7); }));
+
+    data = values;
+    int lowerBound = 0, upperBound = 0;
+    PTRX_CHECK(manager.threeWayPartition(data.data(), size, 7, lowerBound, upperBound, policy));
+    PTRX_CHECK(lowerBound == expectedBelow && upperBound == expectedBelow + expectedEqual - 1);
+    PTRX_CHECK(std::all_of(data.begin() + lowerBound, data.begin() + upperBound + 1, [](const T& value) { return value == static_cast<T>(7); }));
+    PTRX_CHECK(std::all_of(data.begin() + upperBound + 1, data.end(), [](const T& value) { return static_cast<T>(7) < value; }));
+
+    std::sort(data.begin(), data.end());
+    std::vector<T> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    PTRX_CHECK(data == sorted);
+}
+
+// The sequential partition of 32-bit integers keeps the order within the low side.
+static void checkStablePartition(MemoryManager<int>& manager) {
+    int values[] = { 9, 3, 8, 1, 7, 2, 6, 0 };
+    PTRX_CHECK(manager.partitionMemory(values, 8, 5) == 4);
+    int expected[] = { 3, 1, 2, 0 };
+    PTRX_CHECK(std::equal(expected, expected + 4, values));
+}
+
+template <typename T>
+static void checkAll() {
+    MemoryManager<T> manager(false, std::make_shared<ThreadPool>(3));
+    ExecutionPolicy policies[] = { ExecutionPolicy::sequential(), ExecutionPolicy::parallel(4) };
+    for (const ExecutionPolicy& policy : policies) {
+        checkNthElement(manager, policy);
+        checkTopK(manager, policy);
+        checkPartitions(manager, policy);
+    }
+}
+
+int main() {
+    checkAll<int>();
+    checkAll<unsigned int>();
+    checkAll<long long>();
+    checkAll<double>();
+
+    MemoryManager<int> manager(false);
+    checkStablePartition(manager);
+    return PTRX_TEST_RESULT();
+}
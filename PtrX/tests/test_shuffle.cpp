@@ -0,0 +1,75 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// The result is a permutation that depends only on the seed, not on the policy or thread count. Sizes span
+// the in-place Fisher-Yates path for buffers below one bucket and the bucket shuffle above it.
+template <typename T>
+static void checkShuffle(MemoryManager<T>& manager) {
+    int sizes[] = { 1, 2, 1000, 65537, 1000003 };
+    for (int size : sizes) {
+        std::vector<T> sequential(size);
+        std::iota(sequential.begin(), sequential.end(), T(0));
+        std::vector<T> parallel = sequential, reseeded = sequential;
+
+        PTRX_CHECK(manager.shuffleMemory(sequential.data(), size, 99, ExecutionPolicy::sequential()));
+        PTRX_CHECK(manager.shuffleMemory(parallel.data(), size, 99, ExecutionPolicy::parallel(3)));
+        PTRX_CHECK(manager.shuffleMemory(reseeded.data(), size, 100, ExecutionPolicy::sequential()));
+        PTRX_CHECK(sequential == parallel);
+
+        std::vector<T> sorted = sequential;
+        std::sort(sorted.begin(), sorted.end());
+        bool permutation = true;
+        for (int i = 0; i < size; ++i) {
+            permutation = permutation && sorted[i] == static_cast<T>(i);
+        }
+        PTRX_CHECK(permutation);
+
+        if (size >= 1000) {
+            int fixedPoints = 0;
+            for (int i = 0; i < size; ++i) {
+                fixedPoints += sequential[i] == static_cast<T>(i);
+            }
+            PTRX_CHECK(fixedPoints < 20);
+            PTRX_CHECK(sequential != reseeded);
+        }
+    }
+
+    PTRX_CHECK(!manager.shuffleMemory(static_cast<T*>(nullptr), 5, 1, ExecutionPolicy::sequential()));
+}
+
+// Across seeds, the first and last element land in every tenth of a two-bucket buffer about equally often.
+static void checkUniformity(MemoryManager<int>& manager) {
+    const int size = 70000;
+    std::vector<int> data(size);
+    int first[10] = {}, last[10] = {};
+    for (int seed = 0; seed < 2000; ++seed) {
+        std::iota(data.begin(), data.end(), 0);
+        manager.shuffleMemory(data.data(), size, static_cast<std::uint64_t>(seed), ExecutionPolicy::sequential());
+        for (int i = 0; i < size; ++i) {
+            if (data[i] == 0) {
+                ++first[static_cast<long long>(i) * 10 / size];
+            }
+            if (data[i] == size - 1) {
+                ++last[static_cast<long long>(i) * 10 / size];
+            }
+        }
+    }
+    for (int tenth = 0; tenth < 10; ++tenth) {
+        PTRX_CHECK(first[tenth] > 130 && first[tenth] < 270);
+        PTRX_CHECK(last[tenth] > 130 && last[tenth] < 270);
+    }
+}
+
+int main() {
+    MemoryManager<int> manager(false, std::make_shared<ThreadPool>(3));
+    checkShuffle(manager);
+    checkUniformity(manager);
+
+    MemoryManager<long long> wideManager(false, std::make_shared<ThreadPool>(3));
+    checkShuffle(wideManager);
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,51 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Sizes straddle the radix sort threshold; odd seeds use a narrow range, so most digits repeat.
+template <typename T>
+static void checkSort(MemoryManager<T>& manager, const ExecutionPolicy& policy) {
+    int sizes[] = { 1, 5, 255, 256, 1000, 100000, 1 << 20 };
+    for (int size : sizes) {
+        for (unsigned int seed = 0; seed < 4; ++seed) {
+            std::mt19937_64 generator(seed);
+            std::vector<T> values(size);
+            for (int i = 0; i < size; ++i) {
+                std::uint64_t bits = generator();
+                values[i] = seed % 2 ? static_cast<T>(static_cast<long long>(bits % 100) - 50) : static_cast<T>(bits);
+            }
+            std::vector<T> expected = values;
+            std::sort(expected.begin(), expected.end());
+            PTRX_CHECK(manager.sortMemory(values.data(), size, policy));
+            PTRX_CHECK(values == expected);
+        }
+    }
+
+    PTRX_CHECK(!manager.sortMemory(static_cast<T*>(nullptr), 5, policy));
+}
+
+template <typename T>
+static void checkSortAllPolicies() {
+    MemoryManager<T> manager(false, std::make_shared<ThreadPool>(3));
+    checkSort(manager, ExecutionPolicy::sequential());
+    checkSort(manager, ExecutionPolicy::parallel(4));
+}
+
+int main() {
+    checkSortAllPolicies<int>();
+    checkSortAllPolicies<unsigned int>();
+    checkSortAllPolicies<long long>();
+    checkSortAllPolicies<unsigned short>();
+    checkSortAllPolicies<double>();
+
+    // deduplicateMemory sorts, keeps one copy of every value and zeroes the tail.
+    MemoryManager<int> manager(false);
+    int values[] = { 5, 3, 5, 1, 3 };
+    manager.deduplicateMemory(values, 5);
+    int expected[] = { 1, 3, 5, 0, 0 };
+    PTRX_CHECK(std::equal(expected, expected + 5, values));
+    return PTRX_TEST_RESULT();
+}
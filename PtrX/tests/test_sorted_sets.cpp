@@ -0,0 +1,169 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <vector>
+
+template <typename T>
+static bool sameBlock(const T* block, int size, const std::vector<T>& expected) {
+    return block != nullptr && size == static_cast<int>(expected.size()) && std::equal(expected.begin(), expected.end(), block);
+}
+
+template <typename T>
+static void checkMergeAndSetOperations(MemoryManager<T>& manager) {
+    T first[] = { 1, 3, 3, 5, 7, 9 };
+    T second[] = { 2, 3, 4, 9, 10 };
+    int size = 0;
+
+    T* merged = manager.mergeSortedMemory(first, 6, second, 5);
+    T mergedExpected[] = { 1, 2, 3, 3, 3, 4, 5, 7, 9, 9, 10 };
+    PTRX_CHECK(merged != nullptr && std::equal(mergedExpected, mergedExpected + 11, merged));
+    manager.deallocateMemory(merged);
+
+    // The union drops every repeated value; the differences follow std::set_difference and
+    // std::set_symmetric_difference, so an unmatched repeat is kept.
+    T* result = manager.unionSortedMemory(first, 6, second, 5, size);
+    PTRX_CHECK(sameBlock(result, size, std::vector<T>({ 1, 2, 3, 4, 5, 7, 9, 10 })));
+    manager.deallocateMemory(result);
+
+    result = manager.differenceSortedMemory(first, 6, second, 5, size);
+    PTRX_CHECK(sameBlock(result, size, std::vector<T>({ 1, 3, 5, 7 })));
+    manager.deallocateMemory(result);
+
+    result = manager.symmetricDifferenceSortedMemory(first, 6, second, 5, size);
+    PTRX_CHECK(sameBlock(result, size, std::vector<T>({ 1, 2, 3, 4, 5, 7, 10 })));
+    manager.deallocateMemory(result);
+
+    PTRX_CHECK(manager.mergeSortedMemory(static_cast<const T*>(nullptr), 6, second, 5) == nullptr);
+}
+
+// The parallel overloads must agree with std::merge and friends on inputs large enough to split. Neither
+// input repeats a value, so the deduplicating union matches std::set_union here.
+template <typename T>
+static void checkParallelSetOperations(MemoryManager<T>& manager) {
+    const int size = 1 << 19;
+    std::vector<T> first(size), second(size);
+    for (int i = 0; i < size; ++i) {
+        first[i] = static_cast<T>(i * 3);
+        second[i] = static_cast<T>(i * 5);
+    }
+
+    std::vector<T> destination(2 * size), expected(2 * size);
+    ExecutionPolicy policy = ExecutionPolicy::parallel(4);
+
+    int count = manager.mergeSortedMemory(first.data(), size, second.data(), size, destination.data(), policy);
+    std::merge(first.begin(), first.end(), second.begin(), second.end(), expected.begin());
+    PTRX_CHECK(count == 2 * size && destination == expected);
+
+    count = manager.unionSortedMemory(first.data(), size, second.data(), size, destination.data(), policy);
+    int expectedCount = static_cast<int>(std::set_union(first.begin(), first.end(), second.begin(), second.end(), expected.begin()) - expected.begin());
+    PTRX_CHECK(count == expectedCount && std::equal(expected.begin(), expected.begin() + count, destination.begin()));
+
+    count = manager.differenceSortedMemory(first.data(), size, second.data(), size, destination.data(), policy);
+    expectedCount = static_cast<int>(std::set_difference(first.begin(), first.end(), second.begin(), second.end(), expected.begin()) - expected.begin());
+    PTRX_CHECK(count == expectedCount && std::equal(expected.begin(), expected.begin() + count, destination.begin()));
+
+    count = manager.symmetricDifferenceSortedMemory(first.data(), size, second.data(), size, destination.data(), policy);
+    expectedCount = static_cast<int>(std::set_symmetric_difference(first.begin(), first.end(), second.begin(), second.end(), expected.begin()) - expected.begin());
+    PTRX_CHECK(count == expectedCount && std::equal(expected.begin(), expected.begin() + count, destination.begin()));
+}
+
+template <typename T>
+static void checkMergeMany(MemoryManager<T>& manager) {
+    std::vector<std::vector<T> > runs(7);
+    std::vector<T> expected;
+    for (int run = 0; run < 7; ++run) {
+        // Run 3 stays empty; the others interleave and share values.
+        for (int i = 0; run != 3 && i < 1000 * (run + 1); ++i) {
+            runs[run].push_back(static_cast<T>(i * (run + 2)));
+            expected.push_back(runs[run].back());
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<const T*> pointers;
+    std::vector<int> sizes;
+    for (std::size_t run = 0; run < runs.size(); ++run) {
+        pointers.push_back(runs[run].data());
+        sizes.push_back(static_cast<int>(runs[run].size()));
+    }
+
+    int size = 0;
+    T* merged = manager.mergeManySortedMemory(pointers.data(), sizes.data(), 7, size);
+    PTRX_CHECK(sameBlock(merged, size, expected));
+    manager.deallocateMemory(merged);
+
+    std::vector<T> destination(expected.size());
+    PTRX_CHECK(manager.mergeManySortedMemory(pointers.data(), sizes.data(), 7, destination.data(), ExecutionPolicy::parallel(4))
+        == static_cast<int>(expected.size()));
+    PTRX_CHECK(destination == expected);
+
+    PTRX_CHECK(manager.mergeManySortedMemory(pointers.data(), sizes.data(), 0, size) == nullptr && size == 0);
+}
+
+// Every value present in all inputs is reported once, whichever kernel runs: the block kernel on inputs
+// of similar size, or galloping through a much larger input.
+template <typename T>
+static void checkIntersections(MemoryManager<T>& manager) {
+    T first[] = { 1, 2, 2, 4, 6, 8, 8, 10 };
+    T second[] = { 2, 2, 3, 6, 8, 11 };
+    int size = 0;
+    T* result = manager.intersectSortedMemory(first, 8, second, 6, size);
+    PTRX_CHECK(sameBlock(result, size, std::vector<T>({ 2, 6, 8 })));
+    manager.deallocateMemory(result);
+
+    std::vector<T> small, large, third;
+    for (int i = 0; i < 50; ++i) {
+        small.push_back(static_cast<T>(i * 997));
+    }
+    for (int i = 0; i < 100000; ++i) {
+        large.push_back(static_cast<T>(i * 2));
+        third.push_back(static_cast<T>(i * 3));
+    }
+    std::vector<T> expected;
+    for (int i = 0; i < 50; ++i) {
+        if ((i * 997) % 2 == 0) {
+            expected.push_back(small[i]);
+        }
+    }
+    result = manager.intersectSortedMemory(small.data(), 50, large.data(), 100000, size);
+    PTRX_CHECK(sameBlock(result, size, expected));
+    manager.deallocateMemory(result);
+
+    std::vector<T> destination(50);
+    PTRX_CHECK(manager.intersectSortedMemory(large.data(), 100000, small.data(), 50, destination.data()) == static_cast<int>(expected.size()));
+    PTRX_CHECK(std::equal(expected.begin(), expected.end(), destination.begin()));
+
+    expected.clear();
+    for (int i = 0; i < 50; ++i) {
+        if ((i * 997) % 6 == 0) {
+            expected.push_back(small[i]);
+        }
+    }
+    const T* blocks[] = { large.data(), small.data(), third.data() };
+    int sizes[] = { 100000, 50, 100000 };
+    result = manager.intersectManySortedMemory(blocks, sizes, 3, size);
+    PTRX_CHECK(sameBlock(result, size, expected));
+    manager.deallocateMemory(result);
+
+    sizes[1] = 0;
+    PTRX_CHECK(manager.intersectManySortedMemory(blocks, sizes, 3, size) == nullptr && size == 0);
+}
+
+template <typename T>
+static void checkAll() {
+    MemoryManager<T> manager(false, std::make_shared<ThreadPool>(3));
+    checkMergeAndSetOperations(manager);
+    checkParallelSetOperations(manager);
+    checkMergeMany(manager);
+    checkIntersections(manager);
+}
+
+int main() {
+    checkAll<int>();
+    checkAll<long long>();
+
+    MemoryManager<double> doubleManager(false);
+    checkIntersections(doubleManager);
+    return PTRX_TEST_RESULT();
+}
@@ -0,0 +1,44 @@
+#ifndef PTRX_TEST_SUPPORT_H
+#define PTRX_TEST_SUPPORT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimal check macros shared by the test executables. Each test is a plain program that
+// counts failed checks and returns non-zero if any failed, so ctest needs no framework.
+
+static int testFailures = 0;
+
+#define PTRX_CHECK(condition)                                                                   \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            ++testFailures;                                                                     \
+        }                                                                                       \
+    } while (0)
+
+#define PTRX_TEST_RESULT() (testFailures == 0 ? 0 : 1)
+
+// Decodes a hex string such as a published test vector; spaces are skipped.
+static inline std::vector<unsigned char> fromHex(const std::string& text) {
+    std::vector<unsigned char> bytes;
+    int high = -1;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digit < 0) {
+            continue;
+        }
+        if (high < 0) {
+            high = digit;
+        }
+        else {
+            bytes.push_back(static_cast<unsigned char>(high * 16 + digit));
+            high = -1;
+        }
+    }
+    return bytes;
+}
+
+#endif // PTRX_TEST_SUPPORT_H
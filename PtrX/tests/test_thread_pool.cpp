@@ -0,0 +1,125 @@
+#include "ptrX.h"
+#include "test_support.h"
+
+#include <atomic>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+static void checkGroupJoinsEveryTask(ThreadPool& pool) {
+    std::atomic<int> counter(0);
+    TaskGroup group(pool);
+    for (int i = 0; i < 1000; ++i) {
+        group.run([&counter]() { counter.fetch_add(1); });
+    }
+    group.wait();
+    PTRX_CHECK(counter.load() == 1000);
+}
+
+static void checkThrowingTaskIsRethrown(ThreadPool& pool) {
+    std::atomic<int> counter(0);
+    bool caught = false;
+    TaskGroup group(pool);
+    for (int i = 0; i < 64; ++i) {
+        group.run([&counter, i]() {
+            if (i == 17) {
+                throw std::runtime_error("task failed");
+            }
+            counter.fetch_add(1);
+        });
+    }
+    try {
+        group.wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    PTRX_CHECK(caught);
+    PTRX_CHECK(counter.load() == 63);
+
+    // The error is reported once; the group is reusable afterwards.
+    group.run([&counter]() { counter.fetch_add(1); });
+    group.wait();
+    PTRX_CHECK(counter.load() == 64);
+}
+
+static void checkUncollectedErrorDoesNotEscapeDestructor(ThreadPool& pool) {
+    {
+        TaskGroup group(pool);
+        group.run([]() { throw std::runtime_error("ignored"); });
+    }
+    PTRX_CHECK(true);
+}
+
+static void checkNestedGroups(ThreadPool& pool) {
+    std::atomic<int> counter(0);
+    TaskGroup outer(pool);
+    for (int i = 0; i < 16; ++i) {
+        outer.run([&pool, &counter]() {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 16; ++j) {
+                inner.run([&counter]() { counter.fetch_add(1); });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    PTRX_CHECK(counter.load() == 256);
+}
+
+// A task whose copy throws never reaches the pool; the group must not wait for it.
+struct ThrowingCopyTask {
+    bool* armed;
+    explicit ThrowingCopyTask(bool* armed) : armed(armed) {}
+    ThrowingCopyTask(const ThrowingCopyTask& other) : armed(other.armed) {
+        if (*armed) {
+            throw std::bad_alloc();
+        }
+    }
+    void operator()() const {}
+};
+
+static void checkFailedSubmitDoesNotBlockWait(ThreadPool& pool) {
+    bool armed = false;
+    std::function<void()> task = ThrowingCopyTask(&armed);
+    armed = true;
+    bool caught = false;
+    TaskGroup group(pool);
+    try {
+        group.run(std::move(task));
+    } catch (const std::bad_alloc&) {
+        caught = true;
+    }
+    PTRX_CHECK(caught);
+    group.wait();
+    PTRX_CHECK(true);
+}
+
+static void checkParallelFor(ThreadPool& pool) {
+    std::vector<int> visits(100000, 0);
+    pool.parallelFor(visits.size(), 1000, 4, [&visits](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+    bool allOnce = true;
+    for (std::size_t i = 0; i < visits.size(); ++i) {
+        allOnce = allOnce && visits[i] == 1;
+    }
+    PTRX_CHECK(allOnce);
+}
+
+int main() {
+    unsigned int threadCounts[] = { 0, 1, 3 };
+    for (unsigned int threads : threadCounts) {
+        ThreadPool pool(threads);
+        checkGroupJoinsEveryTask(pool);
+        checkThrowingTaskIsRethrown(pool);
+        checkUncollectedErrorDoesNotEscapeDestructor(pool);
+        checkNestedGroups(pool);
+        checkFailedSubmitDoesNotBlockWait(pool);
+        checkParallelFor(pool);
+    }
+    return PTRX_TEST_RESULT();
+}